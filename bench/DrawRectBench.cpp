@@ -0,0 +1,107 @@
+//
+//  DrawRectBench.cpp
+//  blitzENGINE
+//
+//  Times DrawRectBatch's vectorized pass against its scalar loop over a batch of
+//  image draw requests, and checks both produce the same rects. Build with
+//  `make bench-draw-rects`.
+//
+
+#include "DrawRectBatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+static const int kRuns = 200;
+
+
+static void FillBatch(DrawRectBatch &batch, int request_count)
+{
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> scale(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> pivot(0.0f, 1.0f);
+    std::uniform_int_distribution<int> size(8, 256);
+
+    batch.Clear();
+    batch.Reserve(request_count);
+
+    for (int i = 0; i < request_count; ++i)
+    {
+        // Every fourth request is UI, like a typical mix of sprites and HUD
+        float screen_space_mod = i % 4 == 0 ? 0.0f : 1.0f;
+
+        batch.Add(position(random), position(random), size(random), size(random), scale(random), scale(random), pivot(random), pivot(random), screen_space_mod);
+    }
+}
+
+
+static double TimeComputes(DrawRectBatch &batch, const DrawRectCamera &camera, bool scalar)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < kRuns; ++run)
+    {
+        if (scalar)
+            batch.ComputeScalar(camera);
+        else
+            batch.Compute(camera);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kRuns;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> request_counts = { 1000, 10000, 100000 };
+
+    if (argc > 1)
+    {
+        request_counts.clear();
+        for (int i = 1; i < argc; ++i)
+            request_counts.push_back(std::atoi(argv[i]));
+    }
+
+    DrawRectCamera camera;
+    camera.x = 3.5f;
+    camera.y = -1.25f;
+    camera.width = 1280;
+    camera.height = 720;
+    camera.zoom_factor = 1.5f;
+    camera.pixels_per_meter_addend = 99.0f;
+
+    std::printf("backend: %s, runs: %d\n", DrawRectBatch::GetBackendName(), kRuns);
+    std::printf("%10s %14s %14s %10s %12s\n", "requests", "scalar ms", "batched ms", "speedup", "mismatches");
+
+    for (int request_count : request_counts)
+    {
+        DrawRectBatch batch;
+        FillBatch(batch, request_count);
+
+        double scalar_ms = TimeComputes(batch, camera, true);
+        std::vector<int32_t> scalar_rect_x = batch.rect_x;
+        std::vector<int32_t> scalar_rect_y = batch.rect_y;
+        std::vector<int32_t> scalar_center_x = batch.center_x;
+
+        double batched_ms = TimeComputes(batch, camera, false);
+
+        int mismatches = 0;
+        for (int i = 0; i < request_count; ++i)
+        {
+            if (batch.rect_x[i] != scalar_rect_x[i] || batch.rect_y[i] != scalar_rect_y[i] || batch.center_x[i] != scalar_center_x[i])
+                mismatches++;
+        }
+
+        std::printf("%10d %14.4f %14.4f %9.2fx %12d\n", request_count, scalar_ms, batched_ms, scalar_ms / std::max(batched_ms, 1e-9), mismatches);
+    }
+
+    return 0;
+}
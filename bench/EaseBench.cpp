@@ -0,0 +1,151 @@
+//
+//  EaseBench.cpp
+//  blitzENGINE
+//
+//  Times each ease through EaseManager::EvaluateEase, through the function picked once by
+//  GetEaseFunction, through the lookup tables and through EvaluateEases, and reports how far
+//  the lookup tables stray from the exact curves. Build with `make bench-ease`.
+//
+
+#include "EaseManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+static const int kRepeats = 20;
+
+static const char* kEaseNames[] = { "Linear", "InQuad", "OutQuad", "InOutQuad", "InCubic", "OutCubic", "InOutCubic", "InQuart", "OutQuart", "InOutQuart",
+                                    "InQuint", "OutQuint", "InOutQuint", "InSine", "OutSine", "InOutSine", "InExpo", "OutExpo", "InOutExpo",
+                                    "InCirc", "OutCirc", "InOutCirc", "InElastic", "OutElastic", "InOutElastic", "InBack", "OutBack", "InOutBack",
+                                    "InBounce", "OutBounce", "InOutBounce" };
+
+static const int kEaseCount = sizeof(kEaseNames) / sizeof(kEaseNames[0]);
+
+static volatile float sink;
+
+
+template <typename Function>
+static double TimeNanoseconds(size_t evaluations, Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int repeat = 0; repeat < kRepeats; ++repeat)
+        function();
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(evaluations) * kRepeats);
+}
+
+
+int main(int argc, char* argv[])
+{
+    size_t sample_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    std::vector<float> progress(sample_count);
+    std::vector<float> eased(sample_count);
+
+    for (size_t i = 0; i < sample_count; ++i)
+        progress[i] = static_cast<float>(std::rand()) / RAND_MAX;
+
+    std::printf("samples: %zu, table size: %zu\n", sample_count, EaseManager::ease_table_size);
+    std::printf("%-14s %10s %10s %10s %10s %12s\n", "ease", "call ns", "picked ns", "table ns", "batch ns", "table error");
+
+    for (int ease_index = 0; ease_index < kEaseCount; ++ease_index)
+    {
+        EaseType ease_type = static_cast<EaseType>(ease_index);
+
+        EaseManager::SetUseLookupTables(false);
+        EaseFunction exact_function = EaseManager::GetEaseFunction(ease_type);
+
+        EaseManager::SetUseLookupTables(true);
+        EaseFunction table_function = EaseManager::GetEaseFunction(ease_type);
+        bool has_table = table_function != exact_function;
+
+        double call_ns = TimeNanoseconds(sample_count, [&]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i < sample_count; ++i)
+                sum += EaseManager::EvaluateEase(ease_type, progress[i], 1.0f, 1.70158f);
+            sink = sum;
+        });
+
+        double picked_ns = TimeNanoseconds(sample_count, [&]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i < sample_count; ++i)
+                sum += exact_function(progress[i], 1.0f, 1.70158f);
+            sink = sum;
+        });
+
+        double table_ns = !has_table ? 0.0 : TimeNanoseconds(sample_count, [&]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i < sample_count; ++i)
+                sum += table_function(progress[i], 1.0f, 1.70158f);
+            sink = sum;
+        });
+
+        double batch_ns = TimeNanoseconds(sample_count, [&]() {
+            EaseManager::EvaluateEases(ease_type, progress.data(), eased.data(), sample_count, 1.70158f);
+            sink = eased[sample_count / 2];
+        });
+
+        // The picked and batched functions should match EvaluateEase exactly, the tables within their error
+        int mismatches = 0;
+        float table_error = 0.0f;
+
+        for (size_t i = 0; i < sample_count; ++i)
+        {
+            float exact = EaseManager::EvaluateEase(ease_type, progress[i], 1.0f, 1.70158f);
+            float picked = exact_function(progress[i], 1.0f, 1.70158f);
+
+            if (std::memcmp(&exact, &picked, sizeof(float)) != 0 || std::memcmp(&exact, &eased[i], sizeof(float)) != 0)
+                mismatches++;
+
+            if (has_table)
+                table_error = std::max(table_error, std::abs(table_function(progress[i], 1.0f, 1.70158f) - exact));
+        }
+
+        if (mismatches > 0)
+            std::printf("%s: %d evaluations differ from EvaluateEase\n", kEaseNames[ease_index], mismatches);
+
+        if (has_table)
+            std::printf("%-14s %10.2f %10.2f %10.2f %10.2f %12.3g\n", kEaseNames[ease_index], call_ns, picked_ns, table_ns, batch_ns, table_error);
+        else
+            std::printf("%-14s %10.2f %10.2f %10s %10.2f %12s\n", kEaseNames[ease_index], call_ns, picked_ns, "-", batch_ns, "-");
+    }
+
+    // Tweens with mixed eases, the way TweenBatch sees them
+    std::vector<EaseType> ease_types(sample_count);
+    std::vector<EaseFunction> ease_functions(sample_count);
+
+    EaseManager::SetUseLookupTables(false);
+
+    for (size_t i = 0; i < sample_count; ++i)
+    {
+        ease_types[i] = static_cast<EaseType>(std::rand() % kEaseCount);
+        ease_functions[i] = EaseManager::GetEaseFunction(ease_types[i]);
+    }
+
+    double mixed_call_ns = TimeNanoseconds(sample_count, [&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sample_count; ++i)
+            sum += EaseManager::EvaluateEase(ease_types[i], progress[i], 1.0f, 1.70158f);
+        sink = sum;
+    });
+
+    double mixed_picked_ns = TimeNanoseconds(sample_count, [&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sample_count; ++i)
+            sum += ease_functions[i](progress[i], 1.0f, 1.70158f);
+        sink = sum;
+    });
+
+    std::printf("\nmixed eases: EvaluateEase %.2f ns, picked %.2f ns\n", mixed_call_ns, mixed_picked_ns);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+//  EventChannelBench.cpp
+//  blitzENGINE
+//
+//  Times worker threads handing events to a consumer thread through EventChannel's SPSC and
+//  MPSC rings against a mutex-guarded vector, and checks every event arrives exactly once.
+//  Producers retry when a ring is full rather than dropping. Build with `make bench-event-channel`.
+//
+
+#include "EventChannel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+struct BenchEvent
+{
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+    float payload[4] = {};
+};
+
+
+using SingleProducerChannel = EventChannel<BenchEvent, SPSCRing<BenchEvent, 1024>>;
+
+
+using MultipleProducerChannel = EventChannel<BenchEvent, MPSCRing<BenchEvent, 1024>>;
+
+
+static std::mutex locked_mutex;
+
+static std::vector<BenchEvent> locked_pending;
+
+static std::vector<BenchEvent> locked_events;
+
+
+static void LockedPost(const BenchEvent &event)
+{
+    std::lock_guard<std::mutex> lock(locked_mutex);
+    locked_pending.push_back(event);
+}
+
+
+static size_t LockedFlush()
+{
+    std::lock_guard<std::mutex> lock(locked_mutex);
+
+    locked_events.swap(locked_pending);
+    locked_pending.clear();
+
+    return locked_events.size();
+}
+
+
+template <typename PostFunction, typename FlushFunction, typename EventsFunction>
+static void Run(const char* name, uint32_t producer_count, uint32_t events_per_producer, PostFunction post, FlushFunction flush, EventsFunction get_events)
+{
+    std::vector<uint32_t> next_sequence(producer_count, 0);
+    uint64_t expected = static_cast<uint64_t>(producer_count) * events_per_producer;
+    uint64_t received = 0;
+    uint64_t out_of_order = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+
+    for (uint32_t producer = 0; producer < producer_count; ++producer)
+    {
+        producers.emplace_back([=]() {
+            BenchEvent event;
+            event.producer = producer;
+
+            for (uint32_t i = 0; i < events_per_producer; ++i)
+            {
+                event.sequence = i;
+
+                while (!post(event))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    while (received < expected)
+    {
+        if (flush() == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (const BenchEvent &event : get_events())
+        {
+            if (event.sequence != next_sequence[event.producer])
+                out_of_order++;
+
+            next_sequence[event.producer] = event.sequence + 1;
+            received++;
+        }
+    }
+
+    for (std::thread &producer : producers)
+        producer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf("%-8s %u producers  %8.2f M events/s  %s\n", name, producer_count, expected / seconds / 1e6,
+                out_of_order == 0 && received == expected ? "ok" : "LOST OR REORDERED");
+}
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t events_per_producer = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000000;
+    uint32_t max_producers = std::max(2u, std::thread::hardware_concurrency() - 1);
+
+    std::printf("events per producer: %u\n", events_per_producer);
+
+    Run("spsc", 1, events_per_producer, [](const BenchEvent &event) { return SingleProducerChannel::Post(event); },
+        SingleProducerChannel::Flush, SingleProducerChannel::GetEvents);
+
+    Run("mutex", 1, events_per_producer, [](const BenchEvent &event) { LockedPost(event); return true; },
+        LockedFlush, []() -> const std::vector<BenchEvent>& { return locked_events; });
+
+    for (uint32_t producer_count = 2; producer_count <= max_producers; producer_count *= 2)
+    {
+        Run("mpsc", producer_count, events_per_producer, [](const BenchEvent &event) { return MultipleProducerChannel::Post(event); },
+            MultipleProducerChannel::Flush, MultipleProducerChannel::GetEvents);
+
+        Run("mutex", producer_count, events_per_producer, [](const BenchEvent &event) { LockedPost(event); return true; },
+            LockedFlush, []() -> const std::vector<BenchEvent>& { return locked_events; });
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+//
+//  PhysicsBench.cpp
+//  blitzENGINE
+//
+//  Drops separate piles of boxes onto a shared ground and times b2World::Step
+//  with and without the PhysicsTaskExecutor. Build with `make bench-physics`.
+//
+
+#include "box2d.h"
+#include "PhysicsTaskExecutor.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+static const int kBodiesPerPile = 100;
+static const int kSteps = 300;
+static const float kTimestep = 1.0f / 60.0f;
+
+
+static void BuildPiles(b2World &world, int body_count)
+{
+    int pile_count = (body_count + kBodiesPerPile - 1) / kBodiesPerPile;
+    float pile_spacing = 12.0f;
+
+    b2BodyDef ground_def;
+    b2Body* ground = world.CreateBody(&ground_def);
+
+    b2PolygonShape ground_shape;
+    ground_shape.SetAsBox(0.5f * pile_spacing * pile_count + 10.0f, 0.5f, b2Vec2(0.5f * pile_spacing * pile_count, 0.0f), 0.0f);
+    ground->CreateFixture(&ground_shape, 0.0f);
+
+    b2PolygonShape box_shape;
+    box_shape.SetAsBox(0.5f, 0.5f);
+
+    b2FixtureDef box_fixture_def;
+    box_fixture_def.shape = &box_shape;
+    box_fixture_def.density = 1.0f;
+    box_fixture_def.friction = 0.3f;
+
+    for (int i = 0; i < body_count; ++i)
+    {
+        int pile = i / kBodiesPerPile;
+        int slot = i % kBodiesPerPile;
+
+        b2BodyDef body_def;
+        body_def.type = b2_dynamicBody;
+        body_def.position.Set(pile * pile_spacing + (slot % 5) * 1.1f, 1.0f + (slot / 5) * 1.1f);
+
+        world.CreateBody(&body_def)->CreateFixture(&box_fixture_def);
+    }
+}
+
+
+static double RunPiles(int body_count, b2TaskExecutor *executor, float &checksum)
+{
+    b2World world(b2Vec2(0.0f, -9.8f));
+    world.SetTaskExecutor(executor);
+
+    BuildPiles(world, body_count);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < kSteps; ++step)
+        world.Step(kTimestep, 8, 3);
+
+    auto end = std::chrono::steady_clock::now();
+
+    checksum = 0.0f;
+    for (b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+        checksum += body->GetPosition().y;
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kSteps;
+}
+
+
+int main(int argc, char* argv[])
+{
+    ThreadPool::Init();
+
+    PhysicsTaskExecutor executor;
+
+    std::vector<int> body_counts = { 1000, 10000, 50000 };
+
+    if (argc > 1)
+    {
+        body_counts.clear();
+        for (int i = 1; i < argc; ++i)
+            body_counts.push_back(std::atoi(argv[i]));
+    }
+
+    std::printf("workers: %u, steps: %d\n", ThreadPool::GetWorkerCount(), kSteps);
+    std::printf("%10s %14s %14s %10s\n", "bodies", "serial ms", "parallel ms", "speedup");
+
+    for (int body_count : body_counts)
+    {
+        float serial_checksum = 0.0f;
+        float parallel_checksum = 0.0f;
+
+        double serial_ms = RunPiles(body_count, nullptr, serial_checksum);
+        double parallel_ms = RunPiles(body_count, &executor, parallel_checksum);
+
+        std::printf("%10d %14.3f %14.3f %9.2fx   (mean y %.4f / %.4f)\n", body_count, serial_ms, parallel_ms, serial_ms / parallel_ms,
+                    serial_checksum / body_count, parallel_checksum / body_count);
+    }
+
+    return 0;
+}
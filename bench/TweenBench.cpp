@@ -0,0 +1,299 @@
+//
+//  TweenBench.cpp
+//  blitzENGINE
+//
+//  Runs the same float tweens through the std::function based ITween path and through
+//  NativeTweenManager, timing a frame of updates for each and checking both end on the
+//  same values. Then does the same for fields of Lua tables, comparing GOTween.To's
+//  getter/setter path with GOTween.Field's raw sets, and checks that Field reports a
+//  script error for fields that are not numbers. Build with `make bench-tweens`.
+//
+
+#include "NativeTween.hpp"
+#include "Tween.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+
+static const int kFrames = 300;
+static const float kDeltaTime = 1.0f / 60.0f;
+
+static const EaseType kEases[] = { EaseType::Linear, EaseType::OutQuad, EaseType::InOutCubic, EaseType::OutSine, EaseType::OutBack, EaseType::OutBounce };
+
+
+static float GetDuration(int i)     { return 0.5f + static_cast<float>(i % 17) * 0.1f; }
+
+
+static EaseType GetEase(int i)      { return kEases[i % (sizeof(kEases) / sizeof(kEases[0]))]; }
+
+
+static double TimeITweens(std::vector<float> &values)
+{
+    std::set<std::shared_ptr<ITween>, ITween::less> tweens;
+
+    for (int i = 0; i < static_cast<int>(values.size()); ++i)
+    {
+        float* value = &values[i];
+
+        std::shared_ptr<Tween<float>> tween = Tween<float>::CreateTween([value]() { return *value; }, [value](float new_value) { *value = new_value; },
+                                                                        0.0f, 100.0f, GetDuration(i));
+        tween->SetEase(GetEase(i))->SetLoops(-1, LoopType::Yoyo);
+
+        tweens.insert(tween);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // The same loop as TweenManager::Update
+    for (int frame = 0; frame < kFrames; ++frame)
+    {
+        for (auto it = tweens.begin(); it != tweens.end();)
+        {
+            if ((*it)->TweenCompleted())
+            {
+                it = tweens.erase(it);
+                continue;
+            }
+
+            if ((*it)->IsPlaying())
+                (*it)->EvaluateAndApply(kDeltaTime);
+
+            ++it;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+
+static double TimeNativeTweens(std::vector<float> &values)
+{
+    std::vector<NativeTween> tweens;
+    tweens.reserve(values.size());
+
+    for (int i = 0; i < static_cast<int>(values.size()); ++i)
+        tweens.push_back(NativeTweenManager::CreateFloat(&values[i], 0.0f, 100.0f, GetDuration(i)).SetEase(GetEase(i)).SetLoops(-1, LoopType::Yoyo));
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < kFrames; ++frame)
+    {
+        NativeTweenManager::Update(UpdateType::Normal, kDeltaTime);
+        NativeTweenManager::FinishUpdate();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    for (NativeTween &tween : tweens)
+        tween.Kill();
+
+    NativeTweenManager::Update(UpdateType::Normal, 0.0f);
+    NativeTweenManager::FinishUpdate();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+
+static std::vector<sol::table> CreateLuaTables(sol::state &lua, int table_count)
+{
+    std::vector<sol::table> tables;
+    tables.reserve(table_count);
+
+    for (int i = 0; i < table_count; ++i)
+        tables.push_back(lua.create_table_with("value", 0.0));
+
+    return tables;
+}
+
+
+static double TimeLuaITweens(sol::state &lua, std::vector<sol::table> &tables)
+{
+    std::set<std::shared_ptr<ITween>, ITween::less> tweens;
+
+    sol::protected_function getter = lua.script("return function(self) return self.value end");
+    sol::protected_function setter = lua.script("return function(self, value) self.value = value end");
+
+    for (int i = 0; i < static_cast<int>(tables.size()); ++i)
+    {
+        // The same functions as ComponentManager::cppGOTweenTo
+        sol::table tween_table = tables[i];
+        std::function<float()> getfunc = [tween_table, getter]() { return getter(tween_table); };
+        std::function<void(float)> setfunc = [tween_table, setter](float x) { setter(tween_table, x); };
+
+        std::shared_ptr<Tween<float>> tween = Tween<float>::CreateTween(getfunc, setfunc, getfunc(), 100.0f, GetDuration(i));
+        tween->SetEase(GetEase(i))->SetLoops(-1, LoopType::Yoyo);
+
+        tweens.insert(tween);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < kFrames; ++frame)
+    {
+        for (auto it = tweens.begin(); it != tweens.end();)
+        {
+            if ((*it)->TweenCompleted())
+            {
+                it = tweens.erase(it);
+                continue;
+            }
+
+            if ((*it)->IsPlaying())
+                (*it)->EvaluateAndApply(kDeltaTime);
+
+            ++it;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+
+static double TimeLuaFieldTweens(std::vector<sol::table> &tables)
+{
+    std::vector<NativeTween> tweens;
+    tweens.reserve(tables.size());
+
+    sol::object key = sol::make_object(tables.front().lua_state(), "value");
+
+    for (int i = 0; i < static_cast<int>(tables.size()); ++i)
+        tweens.push_back(NativeTweenManager::CreateLuaField(tables[i], key, 100.0f, GetDuration(i)).SetEase(GetEase(i)).SetLoops(-1, LoopType::Yoyo));
+
+    auto start = std::chrono::steady_clock::now();
+
+    // The same steps as TweenManager::Update
+    for (int frame = 0; frame < kFrames; ++frame)
+    {
+        NativeTweenManager::Update(UpdateType::Normal, kDeltaTime);
+
+        std::vector<DeferredTweenWrite> &deferred_writes = NativeTweenManager::GetDeferredWrites();
+
+        for (const DeferredTweenWrite &deferred_write : deferred_writes)
+            NativeTweenManager::WriteLuaField(*static_cast<LuaFieldTarget*>(deferred_write.target), deferred_write.x);
+
+        deferred_writes.clear();
+
+        NativeTweenManager::FinishUpdate();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    for (NativeTween &tween : tweens)
+        tween.Kill();
+
+    NativeTweenManager::Update(UpdateType::Normal, 0.0f);
+    NativeTweenManager::GetDeferredWrites().clear();
+    NativeTweenManager::FinishUpdate();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+
+/**
+ *  Calls GOTween.Field from a script on a string field and a missing key. Both should give
+ *  dead handles and report a script error naming the chunk and line they were called from.
+ */
+static bool CheckFieldErrors()
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    std::vector<NativeTween> handles;
+    lua.set_function("Field", [&handles](sol::table tween_table, sol::object key, float end, float duration) {
+        handles.push_back(NativeTweenManager::cppGOTweenField(tween_table, key, end, duration));
+    });
+
+    std::ostringstream report;
+    std::streambuf* cout_buffer = std::cout.rdbuf(report.rdbuf());
+
+    lua.safe_script("local t = { name = \"box\" }\nField(t, \"name\", 1, 1)\nField(t, \"missing\", 1, 1)", "=field_check");
+
+    std::cout.rdbuf(cout_buffer);
+
+    const std::string output = report.str();
+    bool handles_dead = handles.size() == 2 && !handles[0].IsAlive() && !handles[1].IsAlive();
+    bool reported = output.find("GOTween : field_check:2: GOTween.Field target name is not a number") != std::string::npos
+                    && output.find("GOTween : field_check:3: GOTween.Field target missing is not a number") != std::string::npos;
+
+    std::printf("\nGOTween.Field on a non-number: %s\n", handles_dead && reported ? "ok" : "FAILED");
+
+    if (!reported)
+        std::printf("%s", output.c_str());
+
+    return handles_dead && reported;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> tween_counts = { 1000, 10000, 100000 };
+
+    if (argc > 1)
+    {
+        tween_counts.clear();
+        for (int i = 1; i < argc; ++i)
+            tween_counts.push_back(std::atoi(argv[i]));
+    }
+
+    std::printf("frames: %d\n", kFrames);
+    std::printf("%10s %14s %14s %10s %12s\n", "tweens", "ITween ms", "native ms", "speedup", "max error");
+
+    for (int tween_count : tween_counts)
+    {
+        std::vector<float> itween_values(tween_count, 0.0f);
+        std::vector<float> native_values(tween_count, 0.0f);
+
+        double itween_ms = TimeITweens(itween_values);
+        double native_ms = TimeNativeTweens(native_values);
+
+        float max_error = 0.0f;
+        for (int i = 0; i < tween_count; ++i)
+            max_error = std::max(max_error, std::abs(itween_values[i] - native_values[i]));
+
+        std::printf("%10d %14.4f %14.4f %9.2fx %12g\n", tween_count, itween_ms, native_ms, itween_ms / std::max(native_ms, 1e-9), max_error);
+    }
+
+    std::printf("\nLua table fields\n");
+    std::printf("%10s %14s %14s %10s %12s\n", "tweens", "GOTween.To ms", "Field ms", "speedup", "mismatches");
+
+    for (int tween_count : tween_counts)
+    {
+        sol::state lua;
+
+        std::vector<sol::table> itween_tables = CreateLuaTables(lua, tween_count);
+        std::vector<sol::table> field_tables = CreateLuaTables(lua, tween_count);
+
+        double itween_ms = TimeLuaITweens(lua, itween_tables);
+        double field_ms = TimeLuaFieldTweens(field_tables);
+
+        // Both paths should store the same doubles, bit for bit
+        int mismatches = 0;
+        for (int i = 0; i < tween_count; ++i)
+        {
+            double itween_value = itween_tables[i]["value"];
+            double field_value = field_tables[i]["value"];
+
+            if (std::memcmp(&itween_value, &field_value, sizeof(double)) != 0)
+                mismatches++;
+        }
+
+        std::printf("%10d %14.4f %14.4f %9.2fx %12d\n", tween_count, itween_ms, field_ms, itween_ms / std::max(field_ms, 1e-9), mismatches);
+    }
+
+    return CheckFieldErrors() ? 0 : 1;
+}
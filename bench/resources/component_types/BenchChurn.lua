@@ -0,0 +1,31 @@
+BenchChurn = {
+
+	template = "",
+	live_count = 0,
+	churn_per_frame = 0,
+
+	OnStart = function(self)
+		self.live = {}
+		self.first = 1
+		self.last = 0
+
+		for i = 1, self.live_count do
+			self:Spawn()
+		end
+	end,
+
+	OnUpdate = function(self)
+		for i = 1, self.churn_per_frame do
+			Actor.Destroy(self.live[self.first])
+			self.live[self.first] = nil
+			self.first = self.first + 1
+
+			self:Spawn()
+		end
+	end,
+
+	Spawn = function(self)
+		self.last = self.last + 1
+		self.live[self.last] = Actor.Instantiate(self.template)
+	end
+}
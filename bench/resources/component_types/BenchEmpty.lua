@@ -0,0 +1,5 @@
+BenchEmpty = {
+
+	OnUpdate = function(self)
+	end
+}
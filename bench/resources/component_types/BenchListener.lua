@@ -0,0 +1,12 @@
+BenchListener = {
+
+	received = 0,
+
+	OnStart = function(self)
+		Event.Subscribe("bench_event", self, self.OnBenchEvent)
+	end,
+
+	OnBenchEvent = function(self, event)
+		self.received = self.received + 1
+	end
+}
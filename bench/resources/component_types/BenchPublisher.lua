@@ -0,0 +1,10 @@
+BenchPublisher = {
+
+	events_per_frame = 1,
+
+	OnUpdate = function(self)
+		for i = 1, self.events_per_frame do
+			Event.Publish("bench_event", { index = i })
+		end
+	end
+}
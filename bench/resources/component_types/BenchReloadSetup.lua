@@ -0,0 +1,14 @@
+BenchReloadSetup = {
+
+	template = "",
+
+	OnStart = function(self)
+		-- The reloader is kept across loads, so only the first load makes one
+		if BenchReloaderSpawned then
+			return
+		end
+
+		BenchReloaderSpawned = true
+		Scene.DontDestroy(Actor.Instantiate(self.template))
+	end
+}
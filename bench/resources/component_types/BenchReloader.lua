@@ -0,0 +1,26 @@
+BenchReloader = {
+
+	scene = "",
+	interval = 180,
+	exits = 0,
+
+	OnStart = function(self)
+		self.frames = 0
+	end,
+
+	OnUpdate = function(self)
+		self.frames = self.frames + 1
+
+		-- Reloads while this body rests on the ground and the pile is still touching
+		if self.frames % self.interval == 0 then
+			Scene.Load(self.scene)
+		end
+	end,
+
+	OnCollisionExit = function(self, collision)
+		-- Reads the other actor, which must not be one the last load freed
+		if collision.other:GetName() ~= "" then
+			self.exits = self.exits + 1
+		end
+	end
+}
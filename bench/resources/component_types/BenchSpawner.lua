@@ -0,0 +1,27 @@
+BenchSpawner = {
+
+	template = "",
+	count = 0,
+	columns = 100,
+	spacing = 0.5,
+
+	OnStart = function(self)
+		for i = 0, self.count - 1 do
+			local actor = Actor.Instantiate(self.template)
+			local x = (i % self.columns) * self.spacing
+			local y = math.floor(i / self.columns) * self.spacing
+
+			local rb = actor:GetComponent("Rigidbody")
+			if rb ~= nil then
+				rb.x = x
+				rb.y = y
+			end
+
+			local sprite = actor:GetComponent("BenchSprite")
+			if sprite ~= nil then
+				sprite.x = x
+				sprite.y = y
+			end
+		end
+	end
+}
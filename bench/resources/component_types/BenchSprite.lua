@@ -0,0 +1,9 @@
+BenchSprite = {
+
+	x = 0,
+	y = 0,
+
+	OnUpdate = function(self)
+		Image.Draw("bench", self.x, self.y)
+	end
+}
@@ -0,0 +1,13 @@
+BenchText = {
+
+	count = 0,
+	distinct_strings = 50,
+	font = "NotoSans-Regular",
+
+	-- Strings repeat every distinct_strings draws, so this measures drawing rather than texture creation
+	OnUpdate = function(self)
+		for i = 0, self.count - 1 do
+			Text.Draw("bench " .. (i % self.distinct_strings), (i % 40) * 16, math.floor(i / 40) * 14, self.font, 12, 255, 255, 255, 255)
+		end
+	end
+}
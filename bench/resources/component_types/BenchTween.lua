@@ -0,0 +1,8 @@
+BenchTween = {
+
+	value = 0,
+
+	OnStart = function(self)
+		GOTween.To(self, function(self) return self.value end, function(self, new_value) self.value = new_value end, 100, 2.0):SetLoops(-1, LoopType.Yoyo)
+	end
+}
@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+#  run_benchmarks.sh
+#  blitzENGINE
+#
+#  Runs every stress scene in bench/resources headless for a fixed number of frames and
+#  collects the per-scene reports into one JSON file. Used by `make bench`. Headless runs
+#  still draw every frame through SDL's software renderer, so the sprite, particle and text
+#  scenes include CPU rasterization but not GPU or vsync time.
+#
+#  usage: bench/run_benchmarks.sh <engine binary> [frames] [output json]
+#
+
+set -e
+
+ENGINE=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+FRAMES=${2:-600}
+OUTPUT=${3:-bench_results.json}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+STAGE="$ROOT/bench/out/stage"
+REPORTS="$ROOT/bench/out/reports"
+
+rm -rf "$ROOT/bench/out"
+mkdir -p "$STAGE" "$REPORTS"
+
+cp -R "$ROOT/bench/resources" "$STAGE/resources"
+
+# The text scene borrows the sample game's font rather than shipping another copy
+mkdir -p "$STAGE/resources/fonts"
+cp "$ROOT/old_resources/fonts/NotoSans-Regular.ttf" "$STAGE/resources/fonts/" 2>/dev/null || true
+
+SCENES="lua_update sprites rigidbodies tweens text event_fanout churn particles scene_reload"
+
+COMMIT=$(git -C "$ROOT" rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+printf '{\n  "commit": "%s",\n  "frames": %s,\n  "results": {\n' "$COMMIT" "$FRAMES" > "$OUTPUT"
+
+FIRST=1
+
+for SCENE in $SCENES; do
+    if [ "$SCENE" = "text" ] && [ ! -f "$STAGE/resources/fonts/NotoSans-Regular.ttf" ]; then
+        echo "skipping text: no font"
+        continue
+    fi
+
+    echo "running $SCENE"
+    (cd "$STAGE" && "$ENGINE" --headless --frames "$FRAMES" --scene "$SCENE" --bench "$REPORTS/$SCENE.json" > "$REPORTS/$SCENE.log")
+
+    [ $FIRST -eq 1 ] || printf ',\n' >> "$OUTPUT"
+    FIRST=0
+
+    printf '    "%s": ' "$SCENE" >> "$OUTPUT"
+    # Indent the scene's report to sit inside "results" and drop its trailing newline
+    sed -e '1!s/^/    /' "$REPORTS/$SCENE.json" | awk 'NR > 1 { print prev } { prev = $0 } END { printf "%s", prev }' >> "$OUTPUT"
+done
+
+printf '\n  }\n}\n' >> "$OUTPUT"
+
+echo "wrote $OUTPUT"
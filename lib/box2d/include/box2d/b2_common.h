@@ -82,6 +82,12 @@
 /// Maximum number of contacts to be handled to solve a TOI impact.
 #define b2_maxTOIContacts			32
 
+/// The fewest contacts handed to one narrow phase task when a b2TaskExecutor is set.
+#define b2_narrowPhaseMinRange		64
+
+/// The fewest islands handed to one solver task when a b2TaskExecutor is set.
+#define b2_islandMinRange			4
+
 /// The maximum linear position correction used when solving constraints. This helps to
 /// prevent overshoot. Meters.
 #define b2_maxLinearCorrection		(0.2f * b2_lengthUnitsPerMeter)
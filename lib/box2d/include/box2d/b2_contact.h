@@ -167,6 +167,7 @@ public:
 
 protected:
 	friend class b2ContactManager;
+	friend class b2NarrowPhaseTask;
 	friend class b2World;
 	friend class b2ContactSolver;
 	friend class b2Body;
@@ -210,6 +211,12 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	// The two halves of Update. UpdateManifold only writes to this contact, so
+	// disjoint contacts may be updated on several threads at once. ReportUpdate
+	// wakes bodies and calls the listener, and must run on the stepping thread.
+	void UpdateManifold(const b2Manifold& oldManifold);
+	void ReportUpdate(b2ContactListener* listener, const b2Manifold& oldManifold, bool wasTouching);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
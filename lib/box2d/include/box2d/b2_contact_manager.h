@@ -25,17 +25,30 @@
 
 #include "b2_api.h"
 #include "b2_broad_phase.h"
+#include "b2_collision.h"
 
 class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2TaskExecutor;
+
+/// Contact state saved before a parallel narrow phase, so callbacks can be
+/// reported afterwards in contact list order.
+struct B2_API b2ContactUpdate
+{
+	b2Contact* contact;
+	b2Manifold oldManifold;
+	bool wasTouching;
+	bool sensor;
+};
 
 // Delegate of b2World.
 class B2_API b2ContactManager
 {
 public:
 	b2ContactManager();
+	~b2ContactManager();
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -52,6 +65,13 @@ public:
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+	b2TaskExecutor* m_taskExecutor;
+
+	b2ContactUpdate* m_updates;
+	int32 m_updateCapacity;
+
+private:
+	void CollideParallel();
 };
 
 #endif
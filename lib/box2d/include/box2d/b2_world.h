@@ -66,6 +66,13 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	/// Register a task executor to run the narrow phase and island solver on several
+	/// threads. Pass nullptr to step serially again. Contact listener callbacks are
+	/// still made on the thread calling Step, in the same order every run, but
+	/// PostSolve is not reported while an executor is set. The executor is owned
+	/// by you and must remain in scope.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DebugDraw method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -222,7 +229,9 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
+	void SynchronizeFixtures();
 
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
@@ -158,4 +158,27 @@ public:
 									const b2Vec2& normal, float fraction) = 0;
 };
 
+/// A range of independent work handed to a b2TaskExecutor.
+class B2_API b2RangeTask
+{
+public:
+	virtual ~b2RangeTask() {}
+
+	/// Process items [begin, end). Ranges never overlap, so this may run on several
+	/// threads at once.
+	virtual void Execute(int32 begin, int32 end) = 0;
+};
+
+/// Implement this class to let b2World::Step run its narrow phase and island
+/// solver on your own threads. See b2World::SetTaskExecutor
+class B2_API b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// Split [0, count) into ranges of at least minRange items and call
+	/// task->Execute on each. Must not return until every range has finished.
+	virtual void ParallelFor(int32 count, int32 minRange, b2RangeTask* task) = 0;
+};
+
 #endif
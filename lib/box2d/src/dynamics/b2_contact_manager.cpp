@@ -36,6 +36,15 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = nullptr;
+	m_taskExecutor = nullptr;
+
+	m_updates = nullptr;
+	m_updateCapacity = 0;
+}
+
+b2ContactManager::~b2ContactManager()
+{
+	b2Free(m_updates);
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -108,6 +117,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_taskExecutor)
+	{
+		CollideParallel();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
@@ -173,6 +188,129 @@ void b2ContactManager::Collide()
 	}
 }
 
+class b2NarrowPhaseTask : public b2RangeTask
+{
+public:
+	void Execute(int32 begin, int32 end) override
+	{
+		for (int32 i = begin; i < end; ++i)
+		{
+			b2ContactUpdate* update = m_updates + i;
+
+			// Sensors were already updated on the stepping thread.
+			if (update->sensor == false)
+			{
+				update->contact->UpdateManifold(update->oldManifold);
+			}
+		}
+	}
+
+	b2ContactUpdate* m_updates;
+};
+
+// Same as the serial path, split into three passes. The first pass filters and
+// destroys contacts exactly as before. The second evaluates manifolds on the
+// task executor. The third wakes bodies and reports to the listener in contact
+// list order, so callbacks do not depend on thread scheduling.
+//
+// Unlike the serial path, a body woken by a new touch this step only gets its
+// other contacts updated on the next step.
+void b2ContactManager::CollideParallel()
+{
+	if (m_updateCapacity < m_contactCount)
+	{
+		b2Free(m_updates);
+		m_updateCapacity = b2Max(m_contactCount, 2 * m_updateCapacity);
+		m_updates = (b2ContactUpdate*)b2Alloc(m_updateCapacity * sizeof(b2ContactUpdate));
+	}
+
+	int32 updateCount = 0;
+
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		int32 indexA = c->GetChildIndexA();
+		int32 indexB = c->GetChildIndexB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+
+		// Is this contact flagged for filtering?
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			// Should these bodies collide?
+			if (bodyB->ShouldCollide(bodyA) == false)
+			{
+				b2Contact* cNuke = c;
+				c = cNuke->GetNext();
+				Destroy(cNuke);
+				continue;
+			}
+
+			// Check user filtering.
+			if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+			{
+				b2Contact* cNuke = c;
+				c = cNuke->GetNext();
+				Destroy(cNuke);
+				continue;
+			}
+
+			// Clear the filtering flag.
+			c->m_flags &= ~b2Contact::e_filterFlag;
+		}
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+		// At least one body must be awake and it must be dynamic or kinematic.
+		if (activeA == false && activeB == false)
+		{
+			c = c->GetNext();
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+
+		// Here we destroy contacts that cease to overlap in the broad-phase.
+		if (overlap == false)
+		{
+			b2Contact* cNuke = c;
+			c = cNuke->GetNext();
+			Destroy(cNuke);
+			continue;
+		}
+
+		b2ContactUpdate* update = m_updates + updateCount++;
+		update->contact = c;
+		update->oldManifold = c->m_manifold;
+		update->wasTouching = (c->m_flags & b2Contact::e_touchingFlag) == b2Contact::e_touchingFlag;
+		update->sensor = fixtureA->IsSensor() || fixtureB->IsSensor();
+
+		// Sensor overlap tests go through b2Distance, which updates global
+		// counters, so they stay on this thread.
+		if (update->sensor)
+		{
+			c->UpdateManifold(update->oldManifold);
+		}
+
+		c = c->GetNext();
+	}
+
+	b2NarrowPhaseTask task;
+	task.m_updates = m_updates;
+	m_taskExecutor->ParallelFor(updateCount, b2_narrowPhaseMinRange, &task);
+
+	for (int32 i = 0; i < updateCount; ++i)
+	{
+		b2ContactUpdate* update = m_updates + i;
+		update->contact->ReportUpdate(m_contactListener, update->oldManifold, update->wasTouching);
+	}
+}
+
 void b2ContactManager::FindNewContacts()
 {
 	m_broadPhase.UpdatePairs(this);
@@ -48,6 +48,26 @@ struct b2ContactPositionConstraint
 	int32 pointCount;
 };
 
+// Shared static bodies are only ever at the end of the island, and there are
+// usually very few of them, so a linear search is fine.
+int32 b2ContactSolver::GetIslandIndex(const b2ContactSolverDef* def, const b2Body* body)
+{
+	if (def->sharedCount > 0 && body->GetType() == b2_staticBody)
+	{
+		for (int32 i = 0; i < def->sharedCount; ++i)
+		{
+			if (def->sharedBodies[i] == body)
+			{
+				return def->sharedStart + i;
+			}
+		}
+
+		b2Assert(false);
+	}
+
+	return body->m_islandIndex;
+}
+
 b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
 	m_step = def->step;
@@ -82,8 +102,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->restitution = contact->m_restitution;
 		vc->threshold = contact->m_restitutionThreshold;
 		vc->tangentSpeed = contact->m_tangentSpeed;
-		vc->indexA = bodyA->m_islandIndex;
-		vc->indexB = bodyB->m_islandIndex;
+		vc->indexA = GetIslandIndex(def, bodyA);
+		vc->indexB = GetIslandIndex(def, bodyB);
 		vc->invMassA = bodyA->m_invMass;
 		vc->invMassB = bodyB->m_invMass;
 		vc->invIA = bodyA->m_invI;
@@ -94,8 +114,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->normalMass.SetZero();
 
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
-		pc->indexA = bodyA->m_islandIndex;
-		pc->indexB = bodyB->m_islandIndex;
+		pc->indexA = vc->indexA;
+		pc->indexB = vc->indexB;
 		pc->invMassA = bodyA->m_invMass;
 		pc->invMassB = bodyB->m_invMass;
 		pc->localCenterA = bodyA->m_sweep.localCenter;
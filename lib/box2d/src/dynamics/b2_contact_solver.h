@@ -69,6 +69,12 @@ struct b2ContactSolverDef
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+
+	// Static bodies added with b2Island::AddShared. Their island index is not
+	// stored on the body, so it is looked up here instead.
+	b2Body** sharedBodies = nullptr;
+	int32 sharedStart = 0;
+	int32 sharedCount = 0;
 };
 
 class b2ContactSolver
@@ -94,6 +100,9 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+
+private:
+	static int32 GetIslandIndex(const b2ContactSolverDef* def, const b2Body* body);
 };
 
 #endif
@@ -47,6 +47,7 @@ public:
 		m_bodyCount = 0;
 		m_contactCount = 0;
 		m_jointCount = 0;
+		m_sharedCount = 0;
 	}
 
 	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
@@ -61,6 +62,17 @@ public:
 		++m_bodyCount;
 	}
 
+	// Add a static body without claiming its island index, so islands that are
+	// solved at the same time can share it. Must follow every other body.
+	void AddShared(b2Body* body)
+	{
+		b2Assert(m_bodyCount < m_bodyCapacity);
+		b2Assert(body->GetType() == b2_staticBody);
+		m_bodies[m_bodyCount] = body;
+		++m_bodyCount;
+		++m_sharedCount;
+	}
+
 	void Add(b2Contact* contact)
 	{
 		b2Assert(m_contactCount < m_contactCapacity);
@@ -88,6 +100,7 @@ public:
 	int32 m_bodyCount;
 	int32 m_jointCount;
 	int32 m_contactCount;
+	int32 m_sharedCount;
 
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
@@ -107,6 +107,11 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_contactManager.m_taskExecutor = executor;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -397,6 +402,13 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	if (m_contactManager.m_taskExecutor)
+	{
+		SolveParallel(step);
+		SynchronizeFixtures();
+		return;
+	}
+
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -555,30 +567,314 @@ void b2World::Solve(const b2TimeStep& step)
 
 	m_stackAllocator.Free(stack);
 
+	SynchronizeFixtures();
+}
+
+// A contiguous slice of the island arrays built by SolveParallel.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 sharedCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+};
+
+class b2IslandSolveTask : public b2RangeTask
+{
+public:
+	void Execute(int32 begin, int32 end) override
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		// b2StackAllocator is not thread safe, so each thread gets its own.
+		static thread_local b2StackAllocator allocator;
+
+		for (int32 i = begin; i < end; ++i)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			const b2IslandRange& range = m_ranges[i];
+
+			b2Island island(range.bodyCount, range.contactCount, 0, &allocator, nullptr);
+
+			int32 ownedCount = range.bodyCount - range.sharedCount;
+			for (int32 j = 0; j < ownedCount; ++j)
 			{
-				continue;
+				island.Add(m_bodies[range.bodyStart + j]);
+			}
+
+			for (int32 j = ownedCount; j < range.bodyCount; ++j)
+			{
+				island.AddShared(m_bodies[range.bodyStart + j]);
+			}
+
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				island.Add(m_contacts[range.contactStart + j]);
 			}
 
+			b2Profile profile;
+			island.Solve(&profile, m_step, m_gravity, m_allowSleep);
+		}
+	}
+
+	const b2IslandRange* m_ranges;
+	b2Body** m_bodies;
+	b2Contact** m_contacts;
+	b2TimeStep m_step;
+	b2Vec2 m_gravity;
+	bool m_allowSleep;
+};
+
+// Builds every awake island up front with the same search as Solve, then solves
+// them on the task executor. Static bodies can touch several islands, so they
+// are stored at the end of each island and never given an island index.
+// Islands with joints are solved afterwards on this thread, since joints read
+// the island index of static bodies directly.
+void b2World::SolveParallel(const b2TimeStep& step)
+{
+	// A static body is repeated once per island it touches, which takes at
+	// least one contact or joint each time.
+	int32 bodyCapacity = m_bodyCount + m_contactManager.m_contactCount + m_jointCount;
+	int32 contactCapacity = m_contactManager.m_contactCount;
+
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(bodyCapacity * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCapacity * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2IslandRange* ranges = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	b2Body** shared = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+
+	// Clear all the island flags.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	int32 bodyCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+	int32 islandCount = 0;
+
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = ranges + islandCount++;
+		range->bodyStart = bodyCount;
+		range->contactStart = contactCount;
+		range->jointStart = jointCount;
+
+		int32 sharedCount = 0;
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsEnabled() == true);
+
+			// To keep islands as small as possible, we don't
+			// propagate islands across static bodies.
 			if (b->GetType() == b2_staticBody)
 			{
+				shared[sharedCount++] = b;
 				continue;
 			}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+			bodies[bodyCount++] = b;
+
+			// Make sure the body is awake (without resetting sleep timer).
+			b->m_flags |= b2Body::e_awakeFlag;
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < m_bodyCount);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to diabled bodies.
+				if (other->IsEnabled() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < m_bodyCount);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		// Shared static bodies go last, and may join the next island too.
+		for (int32 i = 0; i < sharedCount; ++i)
+		{
+			b2Assert(bodyCount < bodyCapacity);
+			bodies[bodyCount++] = shared[i];
+			shared[i]->m_flags &= ~b2Body::e_islandFlag;
+		}
+
+		range->bodyCount = bodyCount - range->bodyStart;
+		range->sharedCount = sharedCount;
+		range->contactCount = contactCount - range->contactStart;
+		range->jointCount = jointCount - range->jointStart;
+	}
+
+	// Move islands with joints to the back so the executor only sees joint free ones.
+	int32 parallelCount = 0;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		if (ranges[i].jointCount == 0)
+		{
+			b2Swap(ranges[i], ranges[parallelCount++]);
+		}
+	}
+
+	b2IslandSolveTask task;
+	task.m_ranges = ranges;
+	task.m_bodies = bodies;
+	task.m_contacts = contacts;
+	task.m_step = step;
+	task.m_gravity = m_gravity;
+	task.m_allowSleep = m_allowSleep;
+	m_contactManager.m_taskExecutor->ParallelFor(parallelCount, b2_islandMinRange, &task);
+
+	for (int32 i = parallelCount; i < islandCount; ++i)
+	{
+		const b2IslandRange& range = ranges[i];
+
+		b2Island island(range.bodyCount, range.contactCount, range.jointCount, &m_stackAllocator, nullptr);
+
+		for (int32 j = 0; j < range.bodyCount; ++j)
+		{
+			island.Add(bodies[range.bodyStart + j]);
+		}
+
+		for (int32 j = 0; j < range.contactCount; ++j)
+		{
+			island.Add(contacts[range.contactStart + j]);
+		}
+
+		for (int32 j = 0; j < range.jointCount; ++j)
+		{
+			island.Add(joints[range.jointStart + j]);
+		}
+
+		b2Profile profile;
+		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		m_profile.solveInit += profile.solveInit;
+		m_profile.solveVelocity += profile.solveVelocity;
+		m_profile.solvePosition += profile.solvePosition;
+	}
+
+	m_stackAllocator.Free(shared);
+	m_stackAllocator.Free(stack);
+	m_stackAllocator.Free(ranges);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
+}
+
+void b2World::SynchronizeFixtures()
+{
+	b2Timer timer;
+	// Synchronize fixtures, check for out of range bodies.
+	for (b2Body* b = m_bodyList; b; b = b->GetNext())
+	{
+		// If a body was not in an island then it did not move.
+		if ((b->m_flags & b2Body::e_islandFlag) == 0)
+		{
+			continue;
+		}
+
+		if (b->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		// Update fixtures (for broad-phase).
+		b->SynchronizeFixtures();
 	}
+
+	// Look for new contacts.
+	m_contactManager.FindNewContacts();
+	m_profile.broadphase = timer.GetMilliseconds();
 }
 
 // Find TOI contacts and solve them.
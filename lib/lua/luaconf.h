@@ -785,6 +785,13 @@
 ** without modifying the main part of the file.
 */
 
+/*
+@@ luai_makeseed is pinned so string hashes, and with them the order that
+** 'pairs' visits string keys, are the same on every run. Lockstep replays
+** depend on it.
+*/
+#define luai_makeseed(L)	((unsigned int)0x9E3779B9u)
+
 
 
 
@@ -10,6 +10,8 @@
 #include "AudioManager.hpp"
 #include "EventBus.hpp"
 #include "ImageManager.hpp"
+#include "NativeComponent.hpp"
+#include "Profiler.hpp"
 #include "SceneManager.hpp"
 
 #include <algorithm>
@@ -69,7 +71,10 @@ void Actor::OnStart()
     for (auto &actor_component_pair : starting_components)
     {
         if (std::shared_ptr<Component> actor_component = actor_component_pair.second.lock())
+        {
+            ProfileScope component_scope(actor_component->GetProfileName());
             actor_component->OnStart();
+        }
         else
         {
             updating_components.erase(actor_component_pair.first);
@@ -87,7 +92,10 @@ void Actor::OnUpdate()
     for (auto &actor_component_pair : updating_components)
     {
         if (std::shared_ptr<Component> actor_component = actor_component_pair.second.lock())
+        {
+            ProfileScope component_scope(actor_component->GetProfileName());
             actor_component->OnUpdate();
+        }
         else
             ++dead_components;
     }
@@ -103,7 +111,10 @@ void Actor::OnLateUpdate()
     for (auto &actor_component_pair : late_updating_components)
     {
         if (std::shared_ptr<Component> actor_component = actor_component_pair.second.lock())
+        {
+            ProfileScope component_scope(actor_component->GetProfileName());
             actor_component->OnLateUpdate();
+        }
         else
             ++dead_components;
     }
@@ -119,7 +130,10 @@ void Actor::OnFixedUpdate()
     for (auto &actor_component_pair : fixed_updating_components)
     {
         if (std::shared_ptr<Component> actor_component = actor_component_pair.second.lock())
+        {
+            ProfileScope component_scope(actor_component->GetProfileName());
             actor_component->OnFixedUpdate();
+        }
         else
             ++dead_components;
     }
@@ -332,6 +346,22 @@ void Actor::RemoveAllComponents()
 }
 
 
+void Actor::DestroyNativeComponents()
+{
+    for (auto &actor_component_pair : actor_components)
+    {
+        if (actor_component_pair.second->HasOnDestroy() && std::dynamic_pointer_cast<NativeComponent>(actor_component_pair.second))
+            actor_component_pair.second->OnDestroy();
+    }
+    
+    for (std::shared_ptr<Component> &component_to_add : components_to_add)
+    {
+        if (component_to_add->HasOnDestroy() && std::dynamic_pointer_cast<NativeComponent>(component_to_add))
+            component_to_add->OnDestroy();
+    }
+}
+
+
 void Actor::AddComponents()
 {
     for (auto &component_to_add : components_to_add)
@@ -381,7 +411,6 @@ void Actor::AddActorToSceneStartingMap() const { SceneManager::current_scene.sta
 // TODO: Feature parity with LazyFoo
 // TODO: Add full dualsense support
 // TODO: Extensive Tweening support
-// TODO: Data-orient dstrect calculations
 // TODO: Replace RapidJSON
 // TODO: Fix your timestep!
 // TODO: OpenGL shaders *maybe*
@@ -97,6 +97,12 @@ public:
     
     void RemoveAllComponents();
     
+    /**
+     *  Runs OnDestroy on the native components only, for when a scene load frees the actor.
+     *  They own bodies, textures and tween targets that would otherwise outlive it.
+     */
+    void DestroyNativeComponents();
+    
     
     struct less {
         bool operator() (const Actor* lhs, const Actor* rhs) const { return lhs->uuid < rhs->uuid; }
@@ -10,6 +10,7 @@
 
 #include "AnimationManager.hpp"
 #include "NativeComponent.hpp"
+#include "NativeTween.hpp"
 
 class Animator : public NativeComponent {
 public:
@@ -101,9 +102,6 @@ public:
     
     void OnDestroy() override;
     
-    
-    void TweenCurrentFrameIndex(float new_frame_index);
-    
 private:
     
     
@@ -113,7 +111,7 @@ private:
     std::shared_ptr<Animation> current_animation;
     
     
-    std::shared_ptr<Tween<float>> frame_tween;
+    NativeTween frame_tween;
     
     
     uint32_t current_frame_index;
@@ -129,31 +127,31 @@ inline std::shared_ptr<Component> Animator::GetSharedPointer() { return shared_f
 
 inline Animator* Animator::cppAnimatorPlay()
 {
-    frame_tween->Play();
+    frame_tween.Play();
     return this;
 }
 
 
 inline Animator* Animator::cppAnimatorPause()
 {
-    frame_tween->Pause();
+    frame_tween.Pause();
     return this;
 }
 
 
 inline Animator* Animator::cppAnimatorRewind()
 {
-    frame_tween->Rewind();
+    frame_tween.Rewind();
     return this;
 }
 
 
-inline void Animator::cppAnimatorKill() { frame_tween->Kill(); }
+inline void Animator::cppAnimatorKill() { frame_tween.Kill(); }
 
 
 inline void Animator::cppAnimatorIsPlaying() const
 {
-    frame_tween->IsPlaying();
+    frame_tween.IsPlaying();
 }
 
 
@@ -165,7 +163,7 @@ inline std::string Animator::cppAnimatorGetAnimation() const
 
 inline Animator* Animator::cppAnimatorSetLoops(int32_t loops, LoopType loop_type)
 {
-    frame_tween->SetLoops(loops, loop_type);
+    frame_tween.SetLoops(loops, loop_type);
     return this;
 }
 
@@ -176,7 +174,7 @@ inline Animator* Animator::cppAnimatorSetFrameIndex(float frame_number)
     
     float new_progress = frame_number / total_frames;
     
-    frame_tween->SetProgress(new_progress);
+    frame_tween.SetProgress(new_progress);
     
     current_frame_index = std::roundf(new_progress * total_frames);
     
@@ -199,7 +197,7 @@ inline std::string Animator::GetCurrentFrameName() const
 
 inline Animator* Animator::cppAnimatorSetTimescale(float timescale)
 {
-    frame_tween->SetTimescale(timescale);
+    frame_tween.SetTimescale(timescale);
     
     return this;
 }
@@ -207,13 +205,13 @@ inline Animator* Animator::cppAnimatorSetTimescale(float timescale)
 
 inline float Animator::cppAnimatorGetTimescale() const
 {
-    return frame_tween->GetTimescale();
+    return frame_tween.GetTimescale();
 }
 
 
 inline Animator* Animator::cppAnimatorOnKill(sol::protected_function kill_func, sol::optional<sol::table> kill_table)
 {
-    frame_tween->OnKill(kill_func, kill_table);
+    frame_tween.OnKill(kill_func, kill_table);
     
     return this;
 }
@@ -245,13 +243,7 @@ inline void Animator::OnTriggerExit(const CollisionData &collision) {}
 
 inline void Animator::OnDestroy()
 {
-    frame_tween->Kill();
-}
-
-
-inline void Animator::TweenCurrentFrameIndex(float new_frame_index)
-{
-    current_frame_index = static_cast<uint32>(new_frame_index);
+    frame_tween.Kill();
 }
 
 
@@ -0,0 +1,151 @@
+//
+//  BenchReport.cpp
+//  blitzENGINE
+//
+
+#include "BenchReport.hpp"
+
+#include "ComponentManager.hpp"
+#include "Renderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+
+
+#ifdef BLITZ_COUNT_ALLOCATIONS
+
+static std::atomic<uint64_t> allocation_count(0);
+
+static std::atomic<uint64_t> allocated_bytes(0);
+
+
+void* operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+
+void* operator new[](size_t size)                   { return operator new(size); }
+
+
+void operator delete(void *memory) noexcept         { std::free(memory); }
+
+
+void operator delete[](void *memory) noexcept       { std::free(memory); }
+
+
+void operator delete(void *memory, size_t) noexcept     { std::free(memory); }
+
+
+void operator delete[](void *memory, size_t) noexcept   { std::free(memory); }
+
+
+uint64_t BenchReport::GetAllocationCount()          { return allocation_count.load(std::memory_order_relaxed); }
+
+
+uint64_t BenchReport::GetAllocatedBytes()           { return allocated_bytes.load(std::memory_order_relaxed); }
+
+#else
+
+uint64_t BenchReport::GetAllocationCount()          { return 0; }
+
+
+uint64_t BenchReport::GetAllocatedBytes()           { return 0; }
+
+#endif /* BLITZ_COUNT_ALLOCATIONS */
+
+
+void BenchReport::Start(const std::string &path)
+{
+    report_path = path;
+    frame_times.clear();
+    frames_seen = 0;
+}
+
+
+void BenchReport::RecordFrame(double frame_seconds)
+{
+    if (++frames_seen <= warmup_frames)
+    {
+        start_allocation_count = GetAllocationCount();
+        start_allocated_bytes = GetAllocatedBytes();
+        return;
+    }
+
+    frame_times.emplace_back(frame_seconds);
+}
+
+
+bool BenchReport::Write(Scene &scene)
+{
+    FILE* file_pointer = std::fopen(report_path.c_str(), "w");
+
+    if (!file_pointer)
+        return false;
+
+    std::vector<double> sorted_frame_times = frame_times;
+    std::sort(sorted_frame_times.begin(), sorted_frame_times.end());
+
+    size_t frame_count = sorted_frame_times.size();
+    double total_time = std::accumulate(sorted_frame_times.begin(), sorted_frame_times.end(), 0.0);
+
+    size_t component_count = 0;
+
+    for (auto &[uuid, actor] : scene.actors_by_uuid)
+        component_count += actor->actor_components.size();
+
+    uint64_t allocations = GetAllocationCount() - start_allocation_count;
+    uint64_t bytes = GetAllocatedBytes() - start_allocated_bytes;
+
+    std::fprintf(file_pointer, "{\n");
+    std::fprintf(file_pointer, "  \"scene\": \"%s\",\n", scene.scene_name.c_str());
+    std::fprintf(file_pointer, "  \"frames\": %zu,\n", frame_count);
+    std::fprintf(file_pointer, "  \"warmup_frames\": %zu,\n", warmup_frames);
+    std::fprintf(file_pointer, "  \"renderer\": \"%s\",\n", Renderer::IsHeadless() ? "software" : "hardware");
+    std::fprintf(file_pointer, "  \"frame_ms\": { \"mean\": %.4f, \"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+                 frame_count ? 1000.0 * total_time / frame_count : 0.0,
+                 1000.0 * Percentile(sorted_frame_times, 0.50),
+                 1000.0 * Percentile(sorted_frame_times, 0.99),
+                 frame_count ? 1000.0 * sorted_frame_times.back() : 0.0);
+
+#ifdef BLITZ_COUNT_ALLOCATIONS
+    std::fprintf(file_pointer, "  \"allocations_per_frame\": %.2f,\n", frame_count ? static_cast<double>(allocations) / frame_count : 0.0);
+    std::fprintf(file_pointer, "  \"allocated_bytes_per_frame\": %.2f,\n", frame_count ? static_cast<double>(bytes) / frame_count : 0.0);
+#else
+    (void) allocations;
+    (void) bytes;
+    std::fprintf(file_pointer, "  \"allocations_per_frame\": null,\n");
+    std::fprintf(file_pointer, "  \"allocated_bytes_per_frame\": null,\n");
+#endif
+
+    std::fprintf(file_pointer, "  \"lua_heap_kb\": %d,\n", lua_gc(ComponentManager::GetLuaState()->lua_state(), LUA_GCCOUNT, 0));
+    std::fprintf(file_pointer, "  \"actors\": %zu,\n", scene.actors_by_uuid.size());
+    std::fprintf(file_pointer, "  \"components\": %zu\n", component_count);
+    std::fprintf(file_pointer, "}\n");
+
+    std::fclose(file_pointer);
+
+    return true;
+}
+
+
+double BenchReport::Percentile(const std::vector<double> &sorted_frame_times, double percentile)
+{
+    if (sorted_frame_times.empty())
+        return 0.0;
+
+    // Nearest-rank, so p99 of a short run is still a frame that actually happened
+    size_t rank = static_cast<size_t>(percentile * sorted_frame_times.size());
+
+    return sorted_frame_times[std::min(rank, sorted_frame_times.size() - 1)];
+}
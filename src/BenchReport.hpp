@@ -0,0 +1,73 @@
+//
+//  BenchReport.hpp
+//  blitzENGINE
+//
+
+#ifndef BenchReport_hpp
+#define BenchReport_hpp
+
+#include "Scene.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ *  Collects wall-clock frame times for a benchmark run and writes them out as JSON.
+ *
+ *  Allocation counts are only reported by builds made with BLITZ_COUNT_ALLOCATIONS
+ *  (see `make bench`), which replace the global operator new with a counting one.
+ */
+class BenchReport {
+public:
+
+
+    static void Start(const std::string &path);
+
+
+    static bool IsRunning();
+
+    /**
+     *  Records how long the frame that just finished took, in seconds.
+     */
+    static void RecordFrame(double frame_seconds);
+
+
+    static bool Write(Scene &scene);
+
+
+    static uint64_t GetAllocationCount();
+
+
+    static uint64_t GetAllocatedBytes();
+
+private:
+
+
+    static double Percentile(const std::vector<double> &sorted_frame_times, double percentile);
+
+
+    static inline std::vector<double> frame_times;
+
+
+    static inline std::string report_path;
+
+
+    static inline uint64_t frames_seen = 0;
+
+
+    static inline uint64_t start_allocation_count = 0;
+
+
+    static inline uint64_t start_allocated_bytes = 0;
+
+    /**
+     *  Frames skipped before timing starts, so scene loading and first-use caches don't skew the results.
+     */
+    static inline const size_t warmup_frames = 10;
+};
+
+
+inline bool BenchReport::IsRunning()     { return !report_path.empty(); }
+
+#endif /* BenchReport_hpp */
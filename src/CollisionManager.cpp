@@ -7,6 +7,15 @@
 
 #include "CollisionManager.hpp"
 
+
+bool CollisionManager::ShouldCollide(b2Fixture *fixture_a, b2Fixture *fixture_b)
+{
+    if (fixture_a->IsSensor() != fixture_b->IsSensor())
+        return false;
+    
+    return b2ContactFilter::ShouldCollide(fixture_a, fixture_b);
+}
+
 void CollisionManager::BeginContact(b2Contact *contact)
 {
     b2Fixture* fixture_a = contact->GetFixtureA();
@@ -27,9 +36,6 @@ void CollisionManager::BeginContact(b2Contact *contact)
         CollisionData collision_a;
         CollisionData collision_b;
         
-        collision_a.other = actor_b;
-        collision_b.other = actor_a;
-        
         collision_a.relative_velocity = fixture_a->GetBody()->GetLinearVelocity() - fixture_b->GetBody()->GetLinearVelocity();
         collision_b.relative_velocity = collision_a.relative_velocity;
         
@@ -41,13 +47,13 @@ void CollisionManager::BeginContact(b2Contact *contact)
             collision_a.normal = world_manifold.normal;
             collision_b.normal = world_manifold.normal;
             
-            callbacks_to_process.emplace_back([actor_a, collision_a] { actor_a->OnCollisionEnter(collision_a); });
-            callbacks_to_process.emplace_back([actor_b, collision_b] { actor_b->OnCollisionEnter(collision_b); });
+            EventChannel<ContactEvent>::Publish({ actor_a->uuid, actor_b->uuid, collision_a, ContactPhase::CollisionEnter });
+            EventChannel<ContactEvent>::Publish({ actor_b->uuid, actor_a->uuid, collision_b, ContactPhase::CollisionEnter });
         }
         else
         {
-            callbacks_to_process.emplace_back([actor_a, collision_a] { actor_a->OnTriggerEnter(collision_a); });
-            callbacks_to_process.emplace_back([actor_b, collision_b] { actor_b->OnTriggerEnter(collision_b); });
+            EventChannel<ContactEvent>::Publish({ actor_a->uuid, actor_b->uuid, collision_a, ContactPhase::TriggerEnter });
+            EventChannel<ContactEvent>::Publish({ actor_b->uuid, actor_a->uuid, collision_b, ContactPhase::TriggerEnter });
         }
     }
 }
@@ -73,22 +79,19 @@ void CollisionManager::EndContact(b2Contact *contact)
         CollisionData collision_b;
         
         
-        collision_a.other = actor_b;
-        collision_b.other = actor_a;
-        
         collision_a.relative_velocity = fixture_a->GetBody()->GetLinearVelocity() - fixture_b->GetBody()->GetLinearVelocity();
         collision_b.relative_velocity = collision_a.relative_velocity;
         
         
         if (!fixture_a->IsSensor())
         {
-            callbacks_to_process.emplace_back([actor_a, collision_a] { actor_a->OnCollisionExit(collision_a); });
-            callbacks_to_process.emplace_back([actor_b, collision_b] { actor_b->OnCollisionExit(collision_b); });
+            EventChannel<ContactEvent>::Publish({ actor_a->uuid, actor_b->uuid, collision_a, ContactPhase::CollisionExit });
+            EventChannel<ContactEvent>::Publish({ actor_b->uuid, actor_a->uuid, collision_b, ContactPhase::CollisionExit });
         }
         else
         {
-            callbacks_to_process.emplace_back([actor_a, collision_a] { actor_a->OnTriggerExit(collision_a); });
-            callbacks_to_process.emplace_back([actor_b, collision_b] { actor_b->OnTriggerExit(collision_b); });
+            EventChannel<ContactEvent>::Publish({ actor_a->uuid, actor_b->uuid, collision_a, ContactPhase::TriggerExit });
+            EventChannel<ContactEvent>::Publish({ actor_b->uuid, actor_a->uuid, collision_b, ContactPhase::TriggerExit });
         }
     }
 }
@@ -96,7 +99,45 @@ void CollisionManager::EndContact(b2Contact *contact)
 
 void CollisionManager::ProcessContactCallbacks()
 {
-    for (const std::function<void()> &callback_to_process : callbacks_to_process) { callback_to_process(); }
+    EventChannel<ContactEvent>::Flush();
+    
+    for (const ContactEvent &contact_event : EventChannel<ContactEvent>::GetEvents())
+    {
+        // Looked up per event, since an earlier callback may have destroyed either actor
+        Actor* actor = FindContactActor(contact_event.actor_uuid);
+        Actor* other = FindContactActor(contact_event.other_uuid);
+        
+        if (!actor || !other)
+            continue;
+        
+        CollisionData collision = contact_event.collision;
+        collision.other = other;
+        
+        switch (contact_event.phase)
+        {
+            case ContactPhase::CollisionEnter:
+                actor->OnCollisionEnter(collision);
+                break;
+                
+            case ContactPhase::CollisionExit:
+                actor->OnCollisionExit(collision);
+                break;
+                
+            case ContactPhase::TriggerEnter:
+                actor->OnTriggerEnter(collision);
+                break;
+                
+            case ContactPhase::TriggerExit:
+                actor->OnTriggerExit(collision);
+                break;
+        }
+    }
+}
+
+
+Actor* CollisionManager::FindContactActor(uint32_t uuid)
+{
+    auto actor_it = SceneManager::current_scene.actors_by_uuid.find(uuid);
     
-    callbacks_to_process.clear();
+    return actor_it != SceneManager::current_scene.actors_by_uuid.end() ? actor_it->second.get() : nullptr;
 }
@@ -10,6 +10,7 @@
 
 #include "Actor.hpp"
 #include "box2d.h"
+#include "EventChannel.hpp"
 #include "SceneManager.hpp"
 
 #include <stdio.h>
@@ -31,10 +32,49 @@ struct CollisionData {
 };
 
 
-class CollisionManager : public b2ContactListener   {
+enum class ContactPhase : uint8_t
+{
+    CollisionEnter,
+    CollisionExit,
+    TriggerEnter,
+    TriggerExit
+};
+
+/**
+ *  One side of a contact, sent through EventChannel<ContactEvent> while the world steps.
+ *
+ *  Events are dispatched after the step, by which point either actor may have been destroyed,
+ *  so both are stored by uuid and collision.other is only filled in once they are looked up.
+ */
+struct ContactEvent {
+    
+    
+    uint32_t actor_uuid = 0;
+    
+    
+    uint32_t other_uuid = 0;
+    
+    
+    CollisionData collision;
+    
+    
+    ContactPhase phase = ContactPhase::CollisionEnter;
+};
+
+
+class CollisionManager : public b2ContactListener, public b2ContactFilter   {
     
 public:
     
+    /**
+     *  Rejects fixture pairs before Box2D creates a contact for them.
+     *
+     *  Triggers only report against other triggers and colliders only against
+     *  other colliders, so mixed pairs are culled here along with any pair whose
+     *  collision layers and masks do not overlap.
+     */
+    bool ShouldCollide(b2Fixture *fixture_a, b2Fixture *fixture_b) override;
+    
     
     void BeginContact(b2Contact *contact) override;
     
@@ -42,12 +82,16 @@ public:
     void EndContact(b2Contact *contact) override;
     
     
+    /**
+     *  Flushes the contact channel and calls each actor's collision and trigger functions, in the order the contacts happened.
+     *  Events whose actor or other actor is no longer in the scene are dropped.
+     */
     static void ProcessContactCallbacks();
     
 private:
     
     
-    static inline std::vector<std::function<void()>> callbacks_to_process;
+    static Actor* FindContactActor(uint32_t uuid);
 };
 
 #endif /* CollisionManager_hpp */
@@ -10,6 +10,7 @@
 
 #include "document.h"
 #include "lua.hpp"
+#include "Profiler.hpp"
 #include "sol/sol.hpp"
 
 #include <memory>
@@ -74,7 +75,12 @@ public:
     virtual void OnDestroy() = 0;
     
     
-    std::string GetComponentType() const;
+    const std::string& GetComponentType() const;
+    
+    /**
+     *  The component type interned for ProfileScope, looked up once per component rather than every callback.
+     */
+    const char* GetProfileName() const;
     
     
     virtual void SetComponentKey(const std::string &key);
@@ -138,6 +144,9 @@ protected:
     std::string type;
     
     
+    mutable const char* profile_name = nullptr;
+    
+    
     std::string key;
     
     
@@ -181,6 +190,7 @@ inline Component::Component() {}
 
 inline Component::Component(const Component &other)
     :   type(other.type),
+        profile_name(other.profile_name),
         key(other.key),
         has_on_start(other.has_on_start),
         has_on_update(other.has_on_update),
@@ -198,7 +208,16 @@ inline Component::Component (const std::string &type) : type(type) {}
 inline void Component::SetActor(std::weak_ptr<Actor> &actor) { this->actor = actor; }
 
 
-inline std::string Component::GetComponentType() const          { return type; }
+inline const std::string& Component::GetComponentType() const   { return type; }
+
+
+inline const char* Component::GetProfileName() const
+{
+    if (!profile_name)
+        profile_name = Profiler::Intern(type);
+    
+    return profile_name;
+}
 
 
 inline void Component::SetComponentKey(const std::string &key)  { this->key = key; }
@@ -11,12 +11,20 @@
 
 #include "AudioManager.hpp"
 #include "Animator.hpp"
+#include "CoroutineManager.hpp"
 #include "Engine.h"
 #include "EventBus.hpp"
 #include "Input.hpp"
+#include "LayerManager.hpp"
 #include "LuaComponent.hpp"
+#include "LuaProfiler.hpp"
+#include "ParticleEmitter.hpp"
+#include "PhysicsManager.hpp"
+#include "PixelLayer.hpp"
+#include "Profiler.hpp"
 #include "Rigidbody.hpp"
 #include "TextManager.hpp"
+#include "Tilemap.hpp"
 #include "TweenManager.hpp"
 
 #include <any>
@@ -27,14 +35,16 @@ namespace fs =  std::filesystem;
 
 std::unordered_map<std::string, std::function<std::shared_ptr<Component>()>> __native_component_factory = {
     {"Rigidbody", []() -> std::shared_ptr<Component> { return std::make_shared<Rigidbody>(); }},
-    {"Animator", []() -> std::shared_ptr<Component> { return std::make_shared<Animator>(); }}
+    {"Animator", []() -> std::shared_ptr<Component> { return std::make_shared<Animator>(); }},
+    {"Tilemap", []() -> std::shared_ptr<Component> { return std::make_shared<Tilemap>(); }},
+    {"ParticleEmitter", []() -> std::shared_ptr<Component> { return std::make_shared<ParticleEmitter>(); }}
 };
 
 
 void ComponentManager::Init()
 {
     L = sol::state();
-    L.open_libraries(sol::lib::base, sol::lib::math, sol::lib::string);
+    L.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math, sol::lib::string);
     
     
     /* Usertype Bindings */
@@ -82,6 +92,7 @@ void ComponentManager::Init()
     "point", &HitResult::point,
     "normal", &HitResult::normal,
     "actor", &HitResult::actor,
+    "fraction", &HitResult::fraction,
     "is_trigger", &HitResult::is_trigger);
     
     
@@ -91,6 +102,20 @@ void ComponentManager::Init()
     "actor", sol::property(&NativeComponent::GetActor));
 
     
+    L.new_usertype<ParticleEmitter>("ParticleEmitter",
+    sol::base_classes, sol::bases<Component, NativeComponent>(),
+    "key", sol::c_call<decltype(&Component::GetComponentKey), &Component::GetComponentKey>,
+    "actor", sol::property(&NativeComponent::GetActor),
+    "x", sol::property(&ParticleEmitter::GetX, &ParticleEmitter::SetX),
+    "y", sol::property(&ParticleEmitter::GetY, &ParticleEmitter::SetY),
+    "rate", sol::property(&ParticleEmitter::GetRate, &ParticleEmitter::SetRate),
+    "Emit", sol::c_call<decltype(&ParticleEmitter::cppParticleEmitterEmit), &ParticleEmitter::cppParticleEmitterEmit>,
+    "Play", sol::c_call<decltype(&ParticleEmitter::cppParticleEmitterPlay), &ParticleEmitter::cppParticleEmitterPlay>,
+    "Stop", sol::c_call<decltype(&ParticleEmitter::cppParticleEmitterStop), &ParticleEmitter::cppParticleEmitterStop>,
+    "Clear", sol::c_call<decltype(&ParticleEmitter::cppParticleEmitterClear), &ParticleEmitter::cppParticleEmitterClear>,
+    "GetParticleCount", sol::c_call<decltype(&ParticleEmitter::cppParticleEmitterGetParticleCount), &ParticleEmitter::cppParticleEmitterGetParticleCount>);
+
+    
     L.new_usertype<Rigidbody>("Rigidbody",
     sol::base_classes, sol::bases<Component, NativeComponent>(),
     "key", sol::c_call<decltype(&Component::GetComponentKey), &Component::GetComponentKey>,
@@ -103,6 +128,8 @@ void ComponentManager::Init()
     "density", sol::property(&Rigidbody::GetDensity, &Rigidbody::SetDensity),
     "angular_friction", sol::property(&Rigidbody::GetAngularFriction, &Rigidbody::SetAngularFriction),
     "rotation", sol::property(&Rigidbody::GetRotation, &Rigidbody::SetRotation),
+    "collision_layer", sol::property(&Rigidbody::GetCollisionLayer, &Rigidbody::SetCollisionLayer),
+    "collides_with", sol::property(&Rigidbody::GetCollidesWith, &Rigidbody::SetCollidesWith),
     "AddForce", sol::c_call<decltype(&Rigidbody::AddForce), &Rigidbody::AddForce>,
     "GOMove", sol::c_call<decltype(&Rigidbody::GOMove), &Rigidbody::GOMove>,
     "MovePosition", sol::c_call<decltype(&Rigidbody::MovePosition), &Rigidbody::MovePosition>,
@@ -120,7 +147,21 @@ void ComponentManager::Init()
     "GetUpDirection", sol::c_call<decltype(&Rigidbody::GetUpDirection), &Rigidbody::GetUpDirection>,
     "SetRightDirection", sol::c_call<decltype(&Rigidbody::SetRightDirection), &Rigidbody::SetRightDirection>,
     "GetRightDirection",sol::c_call<decltype(&Rigidbody::GetRightDirection), &Rigidbody::GetRightDirection>,
-    "GetMass", sol::c_call<decltype(&Rigidbody::GetMass), &Rigidbody::GetMass>);
+    "GetMass", sol::c_call<decltype(&Rigidbody::GetMass), &Rigidbody::GetMass>,
+    "SetCollisionLayer", sol::c_call<decltype(&Rigidbody::SetCollisionLayer), &Rigidbody::SetCollisionLayer>,
+    "GetCollisionLayer", sol::c_call<decltype(&Rigidbody::GetCollisionLayer), &Rigidbody::GetCollisionLayer>,
+    "SetCollidesWith", sol::c_call<decltype(&Rigidbody::SetCollidesWith), &Rigidbody::SetCollidesWith>,
+    "GetCollidesWith", sol::c_call<decltype(&Rigidbody::GetCollidesWith), &Rigidbody::GetCollidesWith>);
+    
+    
+    L.new_usertype<Tilemap>("Tilemap",
+    sol::base_classes, sol::bases<Component, NativeComponent>(),
+    "key", sol::c_call<decltype(&Component::GetComponentKey), &Component::GetComponentKey>,
+    "actor", sol::property(&NativeComponent::GetActor),
+    "width", sol::property(&Tilemap::cppTilemapGetWidth),
+    "height", sol::property(&Tilemap::cppTilemapGetHeight),
+    "GetTile", sol::c_call<decltype(&Tilemap::cppTilemapGetTile), &Tilemap::cppTilemapGetTile>,
+    "SetTile", sol::c_call<decltype(&Tilemap::cppTilemapSetTile), &Tilemap::cppTilemapSetTile>);
     
     
     L.new_usertype<ITween>("Tween",
@@ -140,6 +181,50 @@ void ComponentManager::Init()
     "SetSnapping", sol::c_call<decltype(&ITween::SetSnapping), &ITween::SetSnapping>);
     
     
+    L.new_usertype<Sequence>("Sequence",
+    sol::base_classes, sol::bases<ITween>(),
+    "Append", sol::c_call<decltype(&Sequence::Append), &Sequence::Append>,
+    "Join", sol::c_call<decltype(&Sequence::Join), &Sequence::Join>,
+    "Insert", sol::c_call<decltype(&Sequence::Insert), &Sequence::Insert>,
+    "AppendInterval", sol::c_call<decltype(&Sequence::AppendInterval), &Sequence::AppendInterval>,
+    "AppendCallback", sol::c_call<decltype(&Sequence::AppendCallback), &Sequence::AppendCallback>,
+    "InsertCallback", sol::c_call<decltype(&Sequence::InsertCallback), &Sequence::InsertCallback>);
+    
+    
+    L.new_usertype<TimerHandle>("TimerHandle",
+    "Cancel", sol::c_call<decltype(&TimerHandle::Cancel), &TimerHandle::Cancel>,
+    "IsActive", sol::c_call<decltype(&TimerHandle::IsActive), &TimerHandle::IsActive>);
+    
+    
+    L.new_usertype<WaitInstruction>("WaitInstruction");
+    
+    
+    L.new_usertype<CoroutineHandle>("CoroutineHandle",
+    "Stop", sol::c_call<decltype(&CoroutineHandle::Stop), &CoroutineHandle::Stop>,
+    "IsRunning", sol::c_call<decltype(&CoroutineHandle::IsRunning), &CoroutineHandle::IsRunning>);
+    
+    
+    L.new_usertype<NativeTween>("NativeTween",
+    "Play", sol::c_call<decltype(&NativeTween::Play), &NativeTween::Play>,
+    "Pause", sol::c_call<decltype(&NativeTween::Pause), &NativeTween::Pause>,
+    "Rewind", sol::c_call<decltype(&NativeTween::Rewind), &NativeTween::Rewind>,
+    "Kill", sol::c_call<decltype(&NativeTween::Kill), &NativeTween::Kill>,
+    "OnKill", sol::c_call<decltype(&NativeTween::OnKill), &NativeTween::OnKill>,
+    "SetOvershoot", sol::c_call<decltype(&NativeTween::SetOvershootOrAmplitude), &NativeTween::SetOvershootOrAmplitude>,
+    "SetAmplitude", sol::c_call<decltype(&NativeTween::SetOvershootOrAmplitude), &NativeTween::SetOvershootOrAmplitude>,
+    "SetTimescale", sol::c_call<decltype(&NativeTween::SetTimescale), &NativeTween::SetTimescale>,
+    "GetTimescale", sol::c_call<decltype(&NativeTween::GetTimescale), &NativeTween::GetTimescale>,
+    "SetLoops", sol::c_call<decltype(&NativeTween::SetLoops), &NativeTween::SetLoops>,
+    "SetEase", sol::c_call<decltype(&NativeTween::SetEase), &NativeTween::SetEase>,
+    "SetUpdate", sol::c_call<decltype(&NativeTween::SetUpdate), &NativeTween::SetUpdate>,
+    "SetAxisConstraint", sol::c_call<decltype(&NativeTween::SetAxisConstraint), &NativeTween::SetAxisConstraint>,
+    "SetSnapping", sol::c_call<decltype(&NativeTween::SetSnapping), &NativeTween::SetSnapping>,
+    "SetProgress", sol::c_call<decltype(&NativeTween::SetProgress), &NativeTween::SetProgress>,
+    "GetProgress", sol::c_call<decltype(&NativeTween::GetProgress), &NativeTween::GetProgress>,
+    "IsPlaying", sol::c_call<decltype(&NativeTween::IsPlaying), &NativeTween::IsPlaying>,
+    "IsAlive", sol::c_call<decltype(&NativeTween::IsAlive), &NativeTween::IsAlive>);
+    
+    
     L.new_usertype<b2Vec2>("Vector2",
     sol::call_constructor, sol::factories(
     []() { return b2Vec2(); },
@@ -185,17 +270,36 @@ void ComponentManager::Init()
     "SetPosition", sol::c_call<decltype(Engine::cppCameraSetPosition), Engine::cppCameraSetPosition>,
     "GetPositionX", sol::c_call<decltype(Engine::cppCameraGetPositionX), Engine::cppCameraGetPositionX>,
     "GetPositionY", sol::c_call<decltype(Engine::cppCameraGetPositionY), Engine::cppCameraGetPositionY>,
+    "TweenPosition", sol::c_call<decltype(Engine::cppCameraTweenPosition), Engine::cppCameraTweenPosition>,
     "SetZoom", sol::c_call<decltype(Renderer::cppCameraSetZoom), Renderer::cppCameraSetZoom>,
-    "GetZoom", sol::c_call<decltype(Renderer::cppCameraGetZoom), Renderer::cppCameraGetZoom>);
+    "GetZoom", sol::c_call<decltype(Renderer::cppCameraGetZoom), Renderer::cppCameraGetZoom>,
+    "TweenZoom", sol::c_call<decltype(Renderer::cppCameraTweenZoom), Renderer::cppCameraTweenZoom>);
+    
+    
+    L["Coroutine"] = L.create_table_with(
+    "Start", sol::c_call<decltype(CoroutineManager::cppCoroutineStart), CoroutineManager::cppCoroutineStart>,
+    "Wait", sol::c_call<decltype(CoroutineManager::cppCoroutineWait), CoroutineManager::cppCoroutineWait>,
+    "WaitFrames", sol::c_call<decltype(CoroutineManager::cppCoroutineWaitFrames), CoroutineManager::cppCoroutineWaitFrames>,
+    "WaitForFixedUpdate", sol::c_call<decltype(CoroutineManager::cppCoroutineWaitForFixedUpdate), CoroutineManager::cppCoroutineWaitForFixedUpdate>,
+    "WaitForEvent", sol::c_call<decltype(CoroutineManager::cppCoroutineWaitForEvent), CoroutineManager::cppCoroutineWaitForEvent>,
+    "WaitForTween", sol::overload(CoroutineManager::cppCoroutineWaitForTween, CoroutineManager::cppCoroutineWaitForNativeTween));
     
     
     L["Debug"] = L.create_table_with(
     "Log", sol::c_call<decltype(cppDebugLog), cppDebugLog>,
-    "LogError", sol::c_call<decltype(cppDebugLogError), cppDebugLogError>);
+    "LogError", sol::c_call<decltype(cppDebugLogError), cppDebugLogError>,
+    "Profile", sol::c_call<decltype(Profiler::cppDebugProfile), Profiler::cppDebugProfile>,
+    "SaveProfile", sol::c_call<decltype(Profiler::cppDebugSaveProfile), Profiler::cppDebugSaveProfile>,
+    "LuaProfile", sol::c_call<decltype(LuaProfiler::cppDebugLuaProfile), LuaProfiler::cppDebugLuaProfile>,
+    "SaveLuaProfile", sol::c_call<decltype(LuaProfiler::cppDebugSaveLuaProfile), LuaProfiler::cppDebugSaveLuaProfile>,
+    "LuaProfileReport", sol::c_call<decltype(LuaProfiler::cppDebugLuaProfileReport), LuaProfiler::cppDebugLuaProfileReport>);
     
     
     L["GOTween"] = L.create_table_with(
-    "To", sol::overload(cppGOTweenTo<b2Vec2>, cppGOTweenTo<float>));
+    "To", sol::overload(cppGOTweenTo<b2Vec2>, cppGOTweenTo<float>),
+    "Field", sol::c_call<decltype(&NativeTweenManager::cppGOTweenField), &NativeTweenManager::cppGOTweenField>,
+    "Fields", sol::c_call<decltype(&NativeTweenManager::cppGOTweenFields), &NativeTweenManager::cppGOTweenFields>,
+    "Sequence", sol::c_call<decltype(&cppGOTweenSequence), &cppGOTweenSequence>);
     
     
     L["EaseType"] = L.create_table_with(
@@ -233,7 +337,9 @@ void ComponentManager::Init()
     
     
     L["Event"] = L.create_table_with(
-    "Publish", sol::c_call<decltype(EventBus::cppEventPublish), EventBus::cppEventPublish>,
+    "Publish", sol::overload(EventBus::cppEventPublishID, EventBus::cppEventPublish),
+    "PublishDeferred", sol::overload(EventBus::cppEventPublishDeferredID, EventBus::cppEventPublishDeferred),
+    "GetID", sol::c_call<decltype(EventBus::cppEventGetID), EventBus::cppEventGetID>,
     "Subscribe", sol::c_call<decltype(EventBus::cppEventSubscribe), EventBus::cppEventSubscribe>,
     "Unsubscribe", sol::c_call<decltype(EventBus::cppEventUnsubscribe), EventBus::cppEventUnsubscribe>);
     
@@ -241,15 +347,34 @@ void ComponentManager::Init()
     L["Image"] = L.create_table_with(
     "Draw", sol::c_call<decltype(ImageManager::cppImageDraw), ImageManager::cppImageDraw>,
     "DrawEx", sol::c_call<decltype(ImageManager::cppImageDrawEx), ImageManager::cppImageDrawEx>,
-    "DrawUI", sol::c_call<decltype(ImageManager::cppImageDrawUI), ImageManager::cppImageDrawUI>,
-    "DrawUIEx", sol::c_call<decltype(ImageManager::cppImageDrawUIEx), ImageManager::cppImageDrawUIEx>,
-    "DrawPixel", sol::c_call<decltype(Renderer::cppImageDrawPixel), Renderer::cppImageDrawPixel>);
+    "DrawUI", sol::overload(ImageManager::cppImageDrawUI, ImageManager::cppImageDrawUILayer),
+    "DrawUIEx", sol::overload(ImageManager::cppImageDrawUIEx, ImageManager::cppImageDrawUIExLayer),
+    "DrawPixel", sol::c_call<decltype(PixelLayer::cppImageDrawPixel), PixelLayer::cppImageDrawPixel>,
+    "DrawPixels", sol::c_call<decltype(PixelLayer::cppImageDrawPixels), PixelLayer::cppImageDrawPixels>,
+    "FillRect", sol::c_call<decltype(PixelLayer::cppImageFillRect), PixelLayer::cppImageFillRect>);
     
     
     L["Input"] = L.create_table_with(
-    "GetKey", sol::c_call<decltype(Input::cppInputGetKey), Input::cppInputGetKey>,
-    "GetKeyDown", sol::c_call<decltype(Input::cppInputGetKeyDown), Input::cppInputGetKeyDown>,
-    "GetKeyUp", sol::c_call<decltype(Input::cppInputGetKeyUp), Input::cppInputGetKeyUp>,
+    "Key", sol::c_call<decltype(Input::cppInputKey), Input::cppInputKey>,
+    "GetKey", sol::overload(Input::cppInputGetKeyHandle, Input::cppInputGetKey),
+    "GetKeyDown", sol::overload(Input::cppInputGetKeyDownHandle, Input::cppInputGetKeyDown),
+    "GetKeyUp", sol::overload(Input::cppInputGetKeyUpHandle, Input::cppInputGetKeyUp),
+    "Action", sol::c_call<decltype(Input::cppInputAction), Input::cppInputAction>,
+    "GetAction", sol::overload(Input::cppInputGetActionHandle, Input::cppInputGetAction),
+    "GetActionDown", sol::overload(Input::cppInputGetActionDownHandle, Input::cppInputGetActionDown),
+    "GetActionUp", sol::overload(Input::cppInputGetActionUpHandle, Input::cppInputGetActionUp),
+    "GetActionValue", sol::overload(Input::cppInputGetActionValueHandle, Input::cppInputGetActionValue),
+    "BindKey", sol::c_call<decltype(Input::cppInputBindKey), Input::cppInputBindKey>,
+    "BindNegativeKey", sol::c_call<decltype(Input::cppInputBindNegativeKey), Input::cppInputBindNegativeKey>,
+    "BindButton", sol::c_call<decltype(Input::cppInputBindButton), Input::cppInputBindButton>,
+    "BindNegativeButton", sol::c_call<decltype(Input::cppInputBindNegativeButton), Input::cppInputBindNegativeButton>,
+    "BindAxis", sol::c_call<decltype(Input::cppInputBindAxis), Input::cppInputBindAxis>,
+    "ClearBindings", sol::c_call<decltype(Input::cppInputClearBindings), Input::cppInputClearBindings>,
+    "GetAxis", sol::c_call<decltype(Input::cppGetAxis), Input::cppGetAxis>,
+    "Button", sol::c_call<decltype(Input::cppInputButton), Input::cppInputButton>,
+    "GetButton", sol::overload(Input::cppInputGetButtonHandle, Input::cppInputGetButton),
+    "GetButtonDown", sol::overload(Input::cppInputGetButtonDownHandle, Input::cppInputGetButtonDown),
+    "GetButtonUp", sol::overload(Input::cppInputGetButtonUpHandle, Input::cppInputGetButtonUp),
     "GetMouseButton", sol::c_call<decltype(Input::cppInputGetMouseButton), Input::cppInputGetMouseButton>,
     "GetMouseButtonDown", sol::c_call<decltype(Input::cppInputGetMouseButtonDown), Input::cppInputGetMouseButtonDown>,
     "GetMouseButtonUp", sol::c_call<decltype(Input::cppInputGetMouseButtonUp), Input::cppInputGetMouseButtonUp>,
@@ -257,6 +382,12 @@ void ComponentManager::Init()
     "GetMouseScrollDelta", sol::c_call<decltype(Input::cppInputGetMouseScrollDelta), Input::cppInputGetMouseScrollDelta>);
 
 
+    L["Layer"] = L.create_table_with(
+    "Create", sol::c_call<decltype(LayerManager::cppLayerCreate), LayerManager::cppLayerCreate>,
+    "SetOrder", sol::c_call<decltype(LayerManager::cppLayerSetOrder), LayerManager::cppLayerSetOrder>,
+    "Clear", sol::c_call<decltype(LayerManager::cppLayerClear), LayerManager::cppLayerClear>);
+
+
     L["LoopType"] = L.create_table_with(
     "Restart", LoopType::Restart,
     "Yoyo", LoopType::Yoyo,
@@ -264,8 +395,13 @@ void ComponentManager::Init()
     
     
     L["Physics"] = L.create_table_with(
-    "Raycast", sol::c_call<decltype(cppPhysicsRaycast), cppPhysicsRaycast>,
-    "RaycastAll", sol::c_call<decltype(cppPhysicsRaycastAll), cppPhysicsRaycastAll>);
+    "Raycast", sol::c_call<decltype(PhysicsManager::cppPhysicsRaycast), PhysicsManager::cppPhysicsRaycast>,
+    "RaycastAll", sol::c_call<decltype(PhysicsManager::cppPhysicsRaycastAll), PhysicsManager::cppPhysicsRaycastAll>,
+    "RaycastBatch", sol::c_call<decltype(PhysicsManager::cppPhysicsRaycastBatch), PhysicsManager::cppPhysicsRaycastBatch>,
+    "OverlapBox", sol::c_call<decltype(PhysicsManager::cppPhysicsOverlapBox), PhysicsManager::cppPhysicsOverlapBox>,
+    "OverlapCircle", sol::c_call<decltype(PhysicsManager::cppPhysicsOverlapCircle), PhysicsManager::cppPhysicsOverlapCircle>,
+    "BoxCast", sol::c_call<decltype(PhysicsManager::cppPhysicsBoxCast), PhysicsManager::cppPhysicsBoxCast>,
+    "CircleCast", sol::c_call<decltype(PhysicsManager::cppPhysicsCircleCast), PhysicsManager::cppPhysicsCircleCast>);
     
     
     L["Scene"] = L.create_table_with(
@@ -274,12 +410,21 @@ void ComponentManager::Init()
     "DontDestroy", sol::c_call<decltype(SceneManager::cppSceneDontDestroy), SceneManager::cppSceneDontDestroy>);
     
     
-    L["Text"] = L.create_table_with("Draw", sol::c_call<decltype(TextManager::cppTextDraw), TextManager::cppTextDraw>);
+    L["Text"] = L.create_table_with("Draw", sol::overload(TextManager::cppTextDraw, TextManager::cppTextDrawLayer));
     
     
     L["Time"] = L.create_table_with(
     "DeltaTime", sol::c_call<decltype(Engine::GetDeltaTime), Engine::GetDeltaTime>,
-    "FixedDeltaTime", sol::c_call<decltype(Engine::GetFixedDeltaTime), Engine::GetFixedDeltaTime>);
+    "FixedDeltaTime", sol::c_call<decltype(Engine::GetFixedDeltaTime), Engine::GetFixedDeltaTime>,
+    "IsLockstep", sol::c_call<decltype(Engine::IsLockstep), Engine::IsLockstep>);
+
+
+    L["Timer"] = L.create_table_with(
+    "After", sol::c_call<decltype(Scheduler::cppTimerAfter), Scheduler::cppTimerAfter>,
+    "Every", sol::c_call<decltype(Scheduler::cppTimerEvery), Scheduler::cppTimerEvery>,
+    "AfterFixed", sol::c_call<decltype(Scheduler::cppTimerAfterFixed), Scheduler::cppTimerAfterFixed>,
+    "EveryFixed", sol::c_call<decltype(Scheduler::cppTimerEveryFixed), Scheduler::cppTimerEveryFixed>,
+    "SetBudget", sol::c_call<decltype(Scheduler::cppTimerSetBudget), Scheduler::cppTimerSetBudget>);
 
 
     L["UpdateType"] = L.create_table_with(
@@ -350,3 +495,9 @@ ITween* ComponentManager::cppGOTweenTo(sol::table tween_table, sol::protected_fu
     ITween* new_tween = TweenManager::GOTo(getfunc, setfunc, start, end, duration).get();
     return new_tween;
 }
+
+
+Sequence* ComponentManager::cppGOTweenSequence()
+{
+    return TweenManager::GOSequence().get();
+}
@@ -6,6 +6,8 @@
 #include "Component.hpp"
 
 #include "box2d.h"
+#include "NativeTween.hpp"
+#include "Sequence.hpp"
 #include "Tween.hpp"
 #include "Utilities.hpp"
 
@@ -99,6 +101,8 @@ private:
     template <typename T>
     static ITween* cppGOTweenTo(sol::table tween_table, sol::protected_function getter, sol::protected_function setter, T end, float duration);
     
+    static Sequence* cppGOTweenSequence();
+    
     
     static inline sol::state L;
     
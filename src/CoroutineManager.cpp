@@ -0,0 +1,270 @@
+//
+//  CoroutineManager.cpp
+//  blitzENGINE
+//
+
+#include "CoroutineManager.hpp"
+
+#include "EventBus.hpp"
+#include "Utilities.hpp"
+
+#include <algorithm>
+
+
+void CoroutineHandle::Stop()
+{
+    if (!IsRunning())
+        return;
+
+    CoroutineManager::ScriptCoroutine &script_coroutine = CoroutineManager::coroutines[id];
+
+    // Its thread is still on the stack, so it is released once it yields
+    if (script_coroutine.running)
+        script_coroutine.stop_requested = true;
+    else
+        CoroutineManager::ReleaseCoroutine(id);
+}
+
+
+bool CoroutineHandle::IsRunning() const
+{
+    return id < CoroutineManager::coroutines.size() && CoroutineManager::coroutines[id].active && CoroutineManager::coroutines[id].generation == generation
+           && !CoroutineManager::coroutines[id].stop_requested;
+}
+
+
+void CoroutineManager::Update()
+{
+    frame_count++;
+
+    auto frame_waiters_end = frame_waiters.upper_bound(frame_count);
+
+    for (auto it = frame_waiters.begin(); it != frame_waiters_end; ++it)
+        ready_coroutines.push_back(std::move(it->second));
+
+    frame_waiters.erase(frame_waiters.begin(), frame_waiters_end);
+
+    // Coroutines made ready while these resume wait for the next update
+    std::vector<ReadyCoroutine> coroutines_to_resume;
+    coroutines_to_resume.swap(ready_coroutines);
+
+    ResumeAll(coroutines_to_resume);
+}
+
+
+void CoroutineManager::FixedUpdate()
+{
+    std::vector<ReadyCoroutine> coroutines_to_resume;
+    coroutines_to_resume.swap(fixed_update_waiters);
+
+    ResumeAll(coroutines_to_resume);
+}
+
+
+CoroutineHandle CoroutineManager::cppCoroutineStart(sol::protected_function function, sol::optional<sol::table> function_table)
+{
+    uint32_t id;
+
+    if (!free_ids.empty())
+    {
+        id = free_ids.back();
+        free_ids.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(coroutines.size());
+        coroutines.emplace_back();
+    }
+
+    ScriptCoroutine &script_coroutine = coroutines[id];
+
+    // Created off the main thread, since a coroutine started from another one can outlive it
+    script_coroutine.thread = sol::thread::create(sol::main_thread(function.lua_state(), function.lua_state()));
+    script_coroutine.coroutine = sol::coroutine(script_coroutine.thread.thread_state(), function);
+    script_coroutine.active = true;
+
+    coroutine_count++;
+
+    CoroutineHandle coroutine_handle(id, script_coroutine.generation);
+
+    Resume(id, function_table.has_value() ? sol::main_object(function_table.value()) : sol::main_object());
+
+    return coroutine_handle;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWait(float seconds)
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::Seconds;
+    wait_instruction.seconds = seconds;
+
+    return wait_instruction;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWaitFrames(int frames)
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::Frames;
+    wait_instruction.frames = static_cast<uint32_t>(std::max(frames, 1));
+
+    return wait_instruction;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWaitForFixedUpdate()
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::FixedUpdate;
+
+    return wait_instruction;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWaitForEvent(const std::string &event_type)
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::Event;
+    wait_instruction.event_type = event_type;
+
+    return wait_instruction;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWaitForTween(ITween* tween)
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::Tween;
+
+    if (tween)
+        wait_instruction.tween = tween->GetSharedPointer();
+
+    return wait_instruction;
+}
+
+
+WaitInstruction CoroutineManager::cppCoroutineWaitForNativeTween(NativeTween tween)
+{
+    WaitInstruction wait_instruction;
+    wait_instruction.wait_type = WaitType::NativeTween;
+    wait_instruction.native_tween = tween;
+
+    return wait_instruction;
+}
+
+
+void CoroutineManager::Resume(uint32_t id, const sol::main_object &resume_value)
+{
+    ScriptCoroutine &script_coroutine = coroutines[id];
+
+    script_coroutine.running = true;
+
+    sol::protected_function_result resume_result = resume_value.valid() ? script_coroutine.coroutine(resume_value) : script_coroutine.coroutine();
+
+    script_coroutine.running = false;
+
+    if (!resume_result.valid())
+    {
+        ReportError("Coroutine", resume_result);
+        ReleaseCoroutine(id);
+        return;
+    }
+
+    if (script_coroutine.stop_requested || resume_result.status() != sol::call_status::yielded)
+    {
+        ReleaseCoroutine(id);
+        return;
+    }
+
+    Wait(id, resume_result.get<sol::object>());
+}
+
+
+void CoroutineManager::Wait(uint32_t id, const sol::object &yielded)
+{
+    ScriptCoroutine &script_coroutine = coroutines[id];
+    uint32_t generation = script_coroutine.generation;
+
+    if (!yielded.is<WaitInstruction>())
+    {
+        frame_waiters.emplace(frame_count + 1, ReadyCoroutine{ id, generation, sol::main_object() });
+        return;
+    }
+
+    const WaitInstruction &wait_instruction = yielded.as<const WaitInstruction&>();
+
+    auto make_ready = [id, generation]() { MakeReady(id, generation, sol::main_object()); };
+
+    switch (wait_instruction.wait_type)
+    {
+        case WaitType::Seconds:
+            script_coroutine.wait_timer = Scheduler::After(wait_instruction.seconds, false, make_ready);
+            break;
+
+        case WaitType::FixedUpdate:
+            fixed_update_waiters.push_back({ id, generation, sol::main_object() });
+            break;
+
+        case WaitType::Event:
+            EventBus::WaitForEvent(wait_instruction.event_type, [id, generation](sol::optional<sol::table> event_object) {
+                MakeReady(id, generation, event_object.has_value() ? sol::main_object(event_object.value()) : sol::main_object());
+            });
+            break;
+
+        case WaitType::Tween:
+            if (!wait_instruction.tween || wait_instruction.tween->TweenCompleted())
+                make_ready();
+            else
+                wait_instruction.tween->AddFinishCallback(make_ready);
+            break;
+
+        case WaitType::NativeTween:
+            if (!NativeTweenManager::AddFinishCallback(wait_instruction.native_tween, make_ready))
+                make_ready();
+            break;
+
+        default:
+            frame_waiters.emplace(frame_count + wait_instruction.frames, ReadyCoroutine{ id, generation, sol::main_object() });
+            break;
+    }
+}
+
+
+void CoroutineManager::MakeReady(uint32_t id, uint32_t generation, sol::main_object resume_value)
+{
+    if (id >= coroutines.size() || !coroutines[id].active || coroutines[id].generation != generation)
+        return;
+
+    ready_coroutines.push_back({ id, generation, std::move(resume_value) });
+}
+
+
+void CoroutineManager::ResumeAll(std::vector<ReadyCoroutine> &coroutines_to_resume)
+{
+    for (const ReadyCoroutine &ready_coroutine : coroutines_to_resume)
+    {
+        // Stopped or ended while it waited
+        if (!coroutines[ready_coroutine.id].active || coroutines[ready_coroutine.id].generation != ready_coroutine.generation)
+            continue;
+
+        Resume(ready_coroutine.id, ready_coroutine.resume_value);
+    }
+}
+
+
+void CoroutineManager::ReleaseCoroutine(uint32_t id)
+{
+    ScriptCoroutine &script_coroutine = coroutines[id];
+
+    script_coroutine.wait_timer.Cancel();
+
+    script_coroutine.coroutine = sol::coroutine();
+    script_coroutine.thread = sol::thread();
+    script_coroutine.active = false;
+    script_coroutine.stop_requested = false;
+    script_coroutine.generation++;
+
+    free_ids.push_back(id);
+    coroutine_count--;
+}
@@ -0,0 +1,204 @@
+//
+//  CoroutineManager.hpp
+//  blitzENGINE
+//
+
+#ifndef CoroutineManager_hpp
+#define CoroutineManager_hpp
+
+#include "NativeTween.hpp"
+#include "Scheduler.hpp"
+#include "Tween.hpp"
+#include "sol/sol.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+enum class WaitType : uint8_t
+{
+    Frames,
+    Seconds,
+    FixedUpdate,
+    Event,
+    Tween,
+    NativeTween
+};
+
+/**
+ *  What a coroutine yields to say when it should be resumed, built by the Coroutine.Wait functions.
+ */
+struct WaitInstruction
+{
+    WaitType wait_type = WaitType::Frames;
+
+    uint32_t frames = 1;
+    double seconds = 0.0;
+
+    std::string event_type;
+
+    std::shared_ptr<ITween> tween;
+    NativeTween native_tween;
+};
+
+/**
+ *  A handle to a coroutine started through Coroutine.Start, which does nothing once the coroutine has ended.
+ */
+class CoroutineHandle {
+public:
+
+
+    CoroutineHandle() {}
+
+    /**
+     *  Ends the coroutine without resuming it again. A coroutine that stops itself ends at its next yield.
+     */
+    void Stop();
+
+
+    bool IsRunning() const;
+
+private:
+
+
+    friend class CoroutineManager;
+
+
+    CoroutineHandle(uint32_t id, uint32_t generation) : id(id), generation(generation) {}
+
+
+    uint32_t id = UINT32_MAX;
+
+
+    uint32_t generation = 0;
+};
+
+/**
+ *  Runs Lua functions as coroutines that yield WaitInstructions across frames.
+ *
+ *  A suspended coroutine is not polled. Each wait registers with whatever ends it, a
+ *  Scheduler timer, an event, a tween or a frame count, and that marks the coroutine
+ *  ready. Ready coroutines resume after the timers and before OnUpdate, in the order their
+ *  waits ended, and WaitForFixedUpdate ones before OnFixedUpdate on every fixed step, whether
+ *  or not the scene has a physics world. Yielding nothing, or anything other than a
+ *  WaitInstruction, waits one frame.
+ */
+class CoroutineManager {
+public:
+
+
+    static void Update();
+
+
+    static void FixedUpdate();
+
+
+    static size_t GetCoroutineCount();
+
+    /**
+     *  Starts function as a coroutine and runs it up to its first yield, passing it function_table if given.
+     */
+    static CoroutineHandle cppCoroutineStart(sol::protected_function function, sol::optional<sol::table> function_table);
+
+
+    static WaitInstruction cppCoroutineWait(float seconds);
+
+
+    static WaitInstruction cppCoroutineWaitFrames(int frames);
+
+
+    static WaitInstruction cppCoroutineWaitForFixedUpdate();
+
+    /**
+     *  The coroutine resumes with the event object of the next publish of event_type.
+     */
+    static WaitInstruction cppCoroutineWaitForEvent(const std::string &event_type);
+
+    /**
+     *  Waits until TweenManager drops the tween. Tweens added to a Sequence never are, so wait on the sequence instead.
+     */
+    static WaitInstruction cppCoroutineWaitForTween(ITween* tween);
+
+
+    static WaitInstruction cppCoroutineWaitForNativeTween(NativeTween tween);
+
+private:
+
+
+    friend class CoroutineHandle;
+
+
+    struct ScriptCoroutine
+    {
+        sol::thread thread;
+        sol::coroutine coroutine;
+
+        TimerHandle wait_timer;
+
+        uint32_t generation = 0;
+
+        bool active = false;
+        bool running = false;
+        bool stop_requested = false;
+    };
+
+
+    struct ReadyCoroutine
+    {
+        uint32_t id;
+        uint32_t generation;
+
+        sol::main_object resume_value;
+    };
+
+
+    static void Resume(uint32_t id, const sol::main_object &resume_value);
+
+    /**
+     *  Registers a suspended coroutine with whatever ends the wait it yielded.
+     */
+    static void Wait(uint32_t id, const sol::object &yielded);
+
+
+    static void MakeReady(uint32_t id, uint32_t generation, sol::main_object resume_value);
+
+
+    static void ResumeAll(std::vector<ReadyCoroutine> &coroutines_to_resume);
+
+
+    static void ReleaseCoroutine(uint32_t id);
+
+    /**
+     *  A deque, so a coroutine stays put while one it starts is added.
+     */
+    static inline std::deque<ScriptCoroutine> coroutines;
+
+
+    static inline std::vector<uint32_t> free_ids;
+
+
+    static inline std::vector<ReadyCoroutine> ready_coroutines;
+
+
+    static inline std::vector<ReadyCoroutine> fixed_update_waiters;
+
+    /**
+     *  Keyed by the frame to resume on. Coroutines waiting on the same frame resume in the order they yielded.
+     */
+    static inline std::multimap<uint64_t, ReadyCoroutine> frame_waiters;
+
+
+    static inline uint64_t frame_count = 0;
+
+
+    static inline size_t coroutine_count = 0;
+};
+
+
+inline size_t CoroutineManager::GetCoroutineCount()     { return coroutine_count; }
+
+#endif /* CoroutineManager_hpp */
@@ -0,0 +1,215 @@
+//
+//  DrawRectBatch.cpp
+//  blitzENGINE
+//
+
+#include "DrawRectBatch.hpp"
+
+#if defined(BLITZ_DRAW_RECT_AVX) || defined(BLITZ_DRAW_RECT_SSE2)
+#include <immintrin.h>
+#elif defined(BLITZ_DRAW_RECT_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <cmath>
+
+// Each backend wraps the handful of operations the kernel needs under the same names,
+// so Compute is written once for every instruction set
+namespace lanes {
+
+#if defined(BLITZ_DRAW_RECT_AVX)
+
+    const size_t kLanes = 8;
+    using FloatLanes = __m256;
+    using IntLanes = __m256i;
+
+    inline FloatLanes Load(const float *source)                         { return _mm256_loadu_ps(source); }
+    inline FloatLanes Splat(float value)                                { return _mm256_set1_ps(value); }
+    inline FloatLanes Add(FloatLanes lhs, FloatLanes rhs)               { return _mm256_add_ps(lhs, rhs); }
+    inline FloatLanes Sub(FloatLanes lhs, FloatLanes rhs)               { return _mm256_sub_ps(lhs, rhs); }
+    inline FloatLanes Mul(FloatLanes lhs, FloatLanes rhs)               { return _mm256_mul_ps(lhs, rhs); }
+    inline FloatLanes Abs(FloatLanes value)                             { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+    inline IntLanes Truncate(FloatLanes value)                          { return _mm256_cvttps_epi32(value); }
+    inline FloatLanes ToFloat(IntLanes value)                           { return _mm256_cvtepi32_ps(value); }
+    inline void Store(int32_t *destination, IntLanes value)             { _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), value); }
+
+#elif defined(BLITZ_DRAW_RECT_SSE2)
+
+    const size_t kLanes = 4;
+    using FloatLanes = __m128;
+    using IntLanes = __m128i;
+
+    inline FloatLanes Load(const float *source)                         { return _mm_loadu_ps(source); }
+    inline FloatLanes Splat(float value)                                { return _mm_set1_ps(value); }
+    inline FloatLanes Add(FloatLanes lhs, FloatLanes rhs)               { return _mm_add_ps(lhs, rhs); }
+    inline FloatLanes Sub(FloatLanes lhs, FloatLanes rhs)               { return _mm_sub_ps(lhs, rhs); }
+    inline FloatLanes Mul(FloatLanes lhs, FloatLanes rhs)               { return _mm_mul_ps(lhs, rhs); }
+    inline FloatLanes Abs(FloatLanes value)                             { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+    inline IntLanes Truncate(FloatLanes value)                          { return _mm_cvttps_epi32(value); }
+    inline FloatLanes ToFloat(IntLanes value)                           { return _mm_cvtepi32_ps(value); }
+    inline void Store(int32_t *destination, IntLanes value)             { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value); }
+
+#elif defined(BLITZ_DRAW_RECT_NEON)
+
+    const size_t kLanes = 4;
+    using FloatLanes = float32x4_t;
+    using IntLanes = int32x4_t;
+
+    inline FloatLanes Load(const float *source)                         { return vld1q_f32(source); }
+    inline FloatLanes Splat(float value)                                { return vdupq_n_f32(value); }
+    inline FloatLanes Add(FloatLanes lhs, FloatLanes rhs)               { return vaddq_f32(lhs, rhs); }
+    inline FloatLanes Sub(FloatLanes lhs, FloatLanes rhs)               { return vsubq_f32(lhs, rhs); }
+    inline FloatLanes Mul(FloatLanes lhs, FloatLanes rhs)               { return vmulq_f32(lhs, rhs); }
+    inline FloatLanes Abs(FloatLanes value)                             { return vabsq_f32(value); }
+    inline IntLanes Truncate(FloatLanes value)                          { return vcvtq_s32_f32(value); }
+    inline FloatLanes ToFloat(IntLanes value)                           { return vcvtq_f32_s32(value); }
+    inline void Store(int32_t *destination, IntLanes value)             { vst1q_s32(destination, value); }
+
+#endif
+
+}
+
+
+void DrawRectBatch::Clear()
+{
+    x.clear();
+    y.clear();
+    width.clear();
+    height.clear();
+    scale_x.clear();
+    scale_y.clear();
+    pivot_x.clear();
+    pivot_y.clear();
+    screen_space_mod.clear();
+}
+
+
+void DrawRectBatch::Reserve(size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    width.reserve(count);
+    height.reserve(count);
+    scale_x.reserve(count);
+    scale_y.reserve(count);
+    pivot_x.reserve(count);
+    pivot_y.reserve(count);
+    screen_space_mod.reserve(count);
+}
+
+
+void DrawRectBatch::Add(float x, float y, int width, int height, float scale_x, float scale_y, float pivot_x, float pivot_y, float screen_space_mod)
+{
+    DrawRectBatch::x.push_back(x);
+    DrawRectBatch::y.push_back(y);
+    DrawRectBatch::width.push_back(static_cast<float>(width));
+    DrawRectBatch::height.push_back(static_cast<float>(height));
+    DrawRectBatch::scale_x.push_back(scale_x);
+    DrawRectBatch::scale_y.push_back(scale_y);
+    DrawRectBatch::pivot_x.push_back(pivot_x);
+    DrawRectBatch::pivot_y.push_back(pivot_y);
+    DrawRectBatch::screen_space_mod.push_back(screen_space_mod);
+}
+
+
+void DrawRectBatch::Compute(const DrawRectCamera &camera)
+{
+    ResizeOutputs();
+
+    size_t vectorized_count = 0;
+
+#if !defined(BLITZ_DRAW_RECT_SCALAR)
+    using lanes::FloatLanes, lanes::IntLanes, lanes::Load, lanes::Splat, lanes::Add, lanes::Sub, lanes::Mul, lanes::Abs, lanes::Truncate, lanes::ToFloat, lanes::Store;
+
+    vectorized_count = Size() - Size() % lanes::kLanes;
+
+    // Same operation order as ComputeRange, so every lane rounds exactly like the scalar path
+    const FloatLanes one = Splat(1.0f);
+    const FloatLanes addend = Splat(camera.pixels_per_meter_addend);
+    const FloatLanes camera_x = Splat(camera.x);
+    const FloatLanes camera_y = Splat(camera.y);
+    const FloatLanes half_view_x = Splat(camera.width * 0.5f * (1.0f / camera.zoom_factor));
+    const FloatLanes half_view_y = Splat(camera.height * 0.5f * (1.0f / camera.zoom_factor));
+
+    for (size_t i = 0; i < vectorized_count; i += lanes::kLanes)
+    {
+        FloatLanes mod = Load(&screen_space_mod[i]);
+        FloatLanes pixels_per_meter = Add(one, Mul(mod, addend));
+
+        IntLanes w = Truncate(Mul(Load(&width[i]), Abs(Load(&scale_x[i]))));
+        IntLanes h = Truncate(Mul(Load(&height[i]), Abs(Load(&scale_y[i]))));
+
+        IntLanes pivot_center_x = Truncate(Mul(Load(&pivot_x[i]), ToFloat(w)));
+        IntLanes pivot_center_y = Truncate(Mul(Load(&pivot_y[i]), ToFloat(h)));
+
+        FloatLanes position_x = Sub(Load(&x[i]), Mul(camera_x, mod));
+        FloatLanes position_y = Sub(Load(&y[i]), Mul(camera_y, mod));
+
+        Store(&rect_x[i], Truncate(Sub(Add(Mul(position_x, pixels_per_meter), Mul(half_view_x, mod)), Mul(ToFloat(pivot_center_x), mod))));
+        Store(&rect_y[i], Truncate(Sub(Add(Mul(position_y, pixels_per_meter), Mul(half_view_y, mod)), Mul(ToFloat(pivot_center_y), mod))));
+        Store(&rect_w[i], w);
+        Store(&rect_h[i], h);
+        Store(&center_x[i], pivot_center_x);
+        Store(&center_y[i], pivot_center_y);
+    }
+#endif
+
+    ComputeRange(vectorized_count, Size(), camera);
+}
+
+
+void DrawRectBatch::ComputeScalar(const DrawRectCamera &camera)
+{
+    ResizeOutputs();
+    ComputeRange(0, Size(), camera);
+}
+
+
+const char* DrawRectBatch::GetBackendName()
+{
+#if defined(BLITZ_DRAW_RECT_AVX)
+    return "avx";
+#elif defined(BLITZ_DRAW_RECT_SSE2)
+    return "sse2";
+#elif defined(BLITZ_DRAW_RECT_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+
+void DrawRectBatch::ComputeRange(size_t begin, size_t end, const DrawRectCamera &camera)
+{
+    float half_view_x = camera.width * 0.5f * (1.0f / camera.zoom_factor);
+    float half_view_y = camera.height * 0.5f * (1.0f / camera.zoom_factor);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        float mod = screen_space_mod[i];
+        float pixels_per_meter = 1.0f + mod * camera.pixels_per_meter_addend;
+
+        rect_w[i] = static_cast<int32_t>(width[i] * std::abs(scale_x[i]));
+        rect_h[i] = static_cast<int32_t>(height[i] * std::abs(scale_y[i]));
+
+        center_x[i] = static_cast<int32_t>(pivot_x[i] * static_cast<float>(rect_w[i]));
+        center_y[i] = static_cast<int32_t>(pivot_y[i] * static_cast<float>(rect_h[i]));
+
+        float position_x = x[i] - camera.x * mod;
+        float position_y = y[i] - camera.y * mod;
+
+        rect_x[i] = static_cast<int32_t>(position_x * pixels_per_meter + half_view_x * mod - static_cast<float>(center_x[i]) * mod);
+        rect_y[i] = static_cast<int32_t>(position_y * pixels_per_meter + half_view_y * mod - static_cast<float>(center_y[i]) * mod);
+    }
+}
+
+
+void DrawRectBatch::ResizeOutputs()
+{
+    rect_x.resize(Size());
+    rect_y.resize(Size());
+    rect_w.resize(Size());
+    rect_h.resize(Size());
+    center_x.resize(Size());
+    center_y.resize(Size());
+}
@@ -0,0 +1,137 @@
+//
+//  DrawRectBatch.hpp
+//  blitzENGINE
+//
+
+#ifndef DrawRectBatch_hpp
+#define DrawRectBatch_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The widest instruction set the build targets is picked at compile time. Define
+// BLITZ_SCALAR_DRAW_RECTS to force the plain loop, e.g. to compare against it.
+#if defined(BLITZ_SCALAR_DRAW_RECTS)
+    #define BLITZ_DRAW_RECT_SCALAR 1
+#elif defined(__AVX__)
+    #define BLITZ_DRAW_RECT_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define BLITZ_DRAW_RECT_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define BLITZ_DRAW_RECT_NEON 1
+#else
+    #define BLITZ_DRAW_RECT_SCALAR 1
+#endif
+
+/**
+ *  The view the batch's rects are computed for.
+ */
+struct DrawRectCamera
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    
+    int width = 0;
+    int height = 0;
+    
+    float zoom_factor = 1.0f;
+    float pixels_per_meter_addend = 0.0f;
+};
+
+/**
+ *  Structure-of-arrays storage for the screen transforms of a frame's image draw requests.
+ *
+ *  The renderer adds every sorted request, then Compute works out all destination rects and
+ *  rotation pivots in one vectorized pass, instead of one request at a time inside the draw loop.
+ *  Results match Renderer's original scalar math, truncation included.
+ */
+class DrawRectBatch {
+public:
+
+
+    void Clear();
+
+
+    void Reserve(size_t count);
+
+    /**
+     *  @param  width, height       the image's size in pixels
+     *  @param  screen_space_mod    1 for scene space, 0 for UI space
+     */
+    void Add(float x, float y, int width, int height, float scale_x, float scale_y, float pivot_x, float pivot_y, float screen_space_mod);
+
+    /**
+     *  Computes every rect and pivot with the build's SIMD backend, finishing any remainder with the scalar loop.
+     */
+    void Compute(const DrawRectCamera &camera);
+
+    /**
+     *  Computes every rect and pivot one request at a time. Compute's reference, kept for benchmarks.
+     */
+    void ComputeScalar(const DrawRectCamera &camera);
+
+
+    size_t Size() const;
+
+
+    static const char* GetBackendName();
+
+
+    std::vector<int32_t> rect_x;
+
+
+    std::vector<int32_t> rect_y;
+
+
+    std::vector<int32_t> rect_w;
+
+
+    std::vector<int32_t> rect_h;
+
+
+    std::vector<int32_t> center_x;
+
+
+    std::vector<int32_t> center_y;
+
+private:
+
+
+    void ComputeRange(size_t begin, size_t end, const DrawRectCamera &camera);
+
+
+    void ResizeOutputs();
+
+
+    std::vector<float> x;
+
+
+    std::vector<float> y;
+
+
+    std::vector<float> width;
+
+
+    std::vector<float> height;
+
+
+    std::vector<float> scale_x;
+
+
+    std::vector<float> scale_y;
+
+
+    std::vector<float> pivot_x;
+
+
+    std::vector<float> pivot_y;
+
+
+    std::vector<float> screen_space_mod;
+};
+
+
+inline size_t DrawRectBatch::Size() const       { return x.size(); }
+
+#endif /* DrawRectBatch_hpp */
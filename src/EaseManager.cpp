@@ -10,11 +10,26 @@
 #include "glm.hpp"
 #include "box2d.h"
 
-float EaseManager::EvaluateEase(EaseType ease_type, float elapsed_time, float duration, float overshootOrAmplitude)
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+    constexpr size_t ease_type_count = static_cast<size_t>(EaseType::InOutBounce) + 1;
+    
+    // Sampled on a uniform grid over normalized time, filled by SetUseLookupTables
+    template <EaseType ease_type>
+    std::array<float, EaseManager::ease_table_size + 1> ease_table;
+}
+
+
+template <EaseType ease_type>
+float EaseManager::EvaluateEaseAs(float elapsed_time, float duration, float overshootOrAmplitude)
 {
     float s;
     float period = 0.3f;
     
+    // ease_type is a constant here, so every case but one compiles away
     switch (ease_type)
     {
         case EaseType::Linear:
@@ -174,7 +189,7 @@ float EaseManager::EvaluateEase(EaseType ease_type, float elapsed_time, float du
             return 0.5f * (elapsed_time * elapsed_time * ((overshootOrAmplitude + 1) * elapsed_time + overshootOrAmplitude) + 2);
 
         case EaseType::InBounce:
-            return 1 - EaseManager::EvaluateEase(EaseType::OutBounce, duration - elapsed_time, duration, overshootOrAmplitude);
+            return 1 - EvaluateEaseAs<EaseType::OutBounce>(duration - elapsed_time, duration, overshootOrAmplitude);
 
         case EaseType::OutBounce:
             elapsed_time /= duration;
@@ -194,10 +209,156 @@ float EaseManager::EvaluateEase(EaseType ease_type, float elapsed_time, float du
             return 7.5625f * elapsed_time * elapsed_time + 0.984375f;
 
         case EaseType::InOutBounce:
-            if (elapsed_time < duration * 0.5f) return EaseManager::EvaluateEase(EaseType::InBounce, elapsed_time * 2, duration, overshootOrAmplitude) * 0.5f;
-            return EaseManager::EvaluateEase(EaseType::OutBounce, elapsed_time * 2 - duration, duration, overshootOrAmplitude) * 0.5f + 0.5f;
+            if (elapsed_time < duration * 0.5f) return EvaluateEaseAs<EaseType::InBounce>(elapsed_time * 2, duration, overshootOrAmplitude) * 0.5f;
+            return EvaluateEaseAs<EaseType::OutBounce>(elapsed_time * 2 - duration, duration, overshootOrAmplitude) * 0.5f + 0.5f;
         
         default:
-            return EvaluateEase(EaseType::OutQuad, elapsed_time, duration, overshootOrAmplitude);
+            return EvaluateEaseAs<EaseType::OutQuad>(elapsed_time, duration, overshootOrAmplitude);
+    }
+}
+
+
+template <typename Function, size_t... indices, typename MakeFunction>
+constexpr std::array<Function, sizeof...(indices)> EaseManager::MakeFunctionTable(std::index_sequence<indices...>, MakeFunction make_function)
+{
+    return {{ make_function(std::integral_constant<EaseType, static_cast<EaseType>(indices)>())... }};
+}
+
+
+template <EaseType ease_type>
+void EaseManager::EvaluateEasesAs(const float* progress, float* eased_progress, size_t count, float overshootOrAmplitude)
+{
+    // EvaluateEaseAs inlines here, so the cheap eases vectorize
+    for (size_t i = 0; i < count; ++i)
+        eased_progress[i] = EvaluateEaseAs<ease_type>(progress[i], 1.0f, overshootOrAmplitude);
+}
+
+
+template <EaseType ease_type>
+void EaseManager::FillEaseTable()
+{
+    for (size_t i = 0; i <= ease_table_size; ++i)
+        ease_table<ease_type>[i] = EvaluateEaseAs<ease_type>(static_cast<float>(i) / ease_table_size, 1.0f, default_overshoot_or_amplitude);
+}
+
+
+template <EaseType ease_type>
+float EaseManager::EvaluateEaseFromTable(float elapsed_time, float duration, float)
+{
+    float position = std::clamp(elapsed_time / duration, 0.0f, 1.0f) * ease_table_size;
+    size_t index = std::min(static_cast<size_t>(position), ease_table_size - 1);
+    float fraction = position - static_cast<float>(index);
+    
+    const std::array<float, ease_table_size + 1> &table = ease_table<ease_type>;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+
+float EaseManager::EvaluateEase(EaseType ease_type, float elapsed_time, float duration, float overshootOrAmplitude)
+{
+    return GetExactEaseFunction(ease_type)(elapsed_time, duration, overshootOrAmplitude);
+}
+
+
+EaseFunction EaseManager::GetEaseFunction(EaseType ease_type)
+{
+    if (use_lookup_tables)
+    {
+        switch (ease_type)
+        {
+            case EaseType::InSine:      return EvaluateEaseFromTable<EaseType::InSine>;
+            case EaseType::OutSine:     return EvaluateEaseFromTable<EaseType::OutSine>;
+            case EaseType::InOutSine:   return EvaluateEaseFromTable<EaseType::InOutSine>;
+            case EaseType::InExpo:      return EvaluateEaseFromTable<EaseType::InExpo>;
+            case EaseType::OutExpo:     return EvaluateEaseFromTable<EaseType::OutExpo>;
+            case EaseType::InOutExpo:   return EvaluateEaseFromTable<EaseType::InOutExpo>;
+            default:                    break;
+        }
+    }
+    
+    return GetExactEaseFunction(ease_type);
+}
+
+
+void EaseManager::EvaluateEases(EaseType ease_type, const float* progress, float* eased_progress, size_t count, float overshootOrAmplitude)
+{
+    static constexpr auto batch_functions = MakeFunctionTable<EaseBatchFunction>(std::make_index_sequence<ease_type_count>(), [](auto ease) {
+        return &EvaluateEasesAs<decltype(ease)::value>;
+    });
+    
+    size_t index = static_cast<size_t>(ease_type);
+    batch_functions[(index < ease_type_count) ? index : static_cast<size_t>(EaseType::OutQuad)](progress, eased_progress, count, overshootOrAmplitude);
+}
+
+
+void EaseManager::SetUseLookupTables(bool use_lookup_tables)
+{
+    if (use_lookup_tables)
+    {
+        FillEaseTable<EaseType::InSine>();
+        FillEaseTable<EaseType::OutSine>();
+        FillEaseTable<EaseType::InOutSine>();
+        FillEaseTable<EaseType::InExpo>();
+        FillEaseTable<EaseType::OutExpo>();
+        FillEaseTable<EaseType::InOutExpo>();
     }
+    
+    EaseManager::use_lookup_tables = use_lookup_tables;
+}
+
+
+EaseFunction EaseManager::GetExactEaseFunction(EaseType ease_type)
+{
+    static constexpr auto ease_functions = MakeFunctionTable<EaseFunction>(std::make_index_sequence<ease_type_count>(), [](auto ease) {
+        return &EvaluateEaseAs<decltype(ease)::value>;
+    });
+    
+    size_t index = static_cast<size_t>(ease_type);
+    return ease_functions[(index < ease_type_count) ? index : static_cast<size_t>(EaseType::OutQuad)];
+}
+
+
+bool EaseManager::GetEaseTypeFromName(const std::string &ease_name, EaseType &ease_type)
+{
+    static const std::unordered_map<std::string, EaseType> ease_types_by_name = {
+        {"Linear", EaseType::Linear},
+        {"InQuad", EaseType::InQuad},
+        {"OutQuad", EaseType::OutQuad},
+        {"InOutQuad", EaseType::InOutQuad},
+        {"InCubic", EaseType::InCubic},
+        {"OutCubic", EaseType::OutCubic},
+        {"InOutCubic", EaseType::InOutCubic},
+        {"InQuart", EaseType::InQuart},
+        {"OutQuart", EaseType::OutQuart},
+        {"InOutQuart", EaseType::InOutQuart},
+        {"InQuint", EaseType::InQuint},
+        {"OutQuint", EaseType::OutQuint},
+        {"InOutQuint", EaseType::InOutQuint},
+        {"InSine", EaseType::InSine},
+        {"OutSine", EaseType::OutSine},
+        {"InOutSine", EaseType::InOutSine},
+        {"InExpo", EaseType::InExpo},
+        {"OutExpo", EaseType::OutExpo},
+        {"InOutExpo", EaseType::InOutExpo},
+        {"InCirc", EaseType::InCirc},
+        {"OutCirc", EaseType::OutCirc},
+        {"InOutCirc", EaseType::InOutCirc},
+        {"InElastic", EaseType::InElastic},
+        {"OutElastic", EaseType::OutElastic},
+        {"InOutElastic", EaseType::InOutElastic},
+        {"InBack", EaseType::InBack},
+        {"OutBack", EaseType::OutBack},
+        {"InOutBack", EaseType::InOutBack},
+        {"InBounce", EaseType::InBounce},
+        {"OutBounce", EaseType::OutBounce},
+        {"InOutBounce", EaseType::InOutBounce}
+    };
+    
+    auto ease_type_it = ease_types_by_name.find(ease_name);
+    
+    if (ease_type_it == ease_types_by_name.end())
+        return false;
+    
+    ease_type = ease_type_it->second;
+    return true;
 }
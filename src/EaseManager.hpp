@@ -9,6 +9,9 @@
 #define EaseManager_hpp
 
 #include <stdio.h>
+#include <array>
+#include <string>
+#include <utility>
 
 enum class EaseType
 {
@@ -46,9 +49,82 @@ enum class EaseType
 };
 
 
+/**
+ *  Evaluates a single EaseType, so a tween can pick its ease once instead of switching on it every update.
+ */
+using EaseFunction = float (*)(float elapsed_time, float duration, float overshootOrAmplitude);
+
+
+using EaseBatchFunction = void (*)(const float* progress, float* eased_progress, size_t count, float overshootOrAmplitude);
+
+
 class EaseManager {
 public:
     static float EvaluateEase(EaseType ease_type, float elapsed_time, float duration, float overshootOrAmplitude);
+    
+    /**
+     *  @return the same function EvaluateEase uses for ease_type, or its lookup table
+     *  version if lookup tables are enabled and ease_type has one
+     */
+    static EaseFunction GetEaseFunction(EaseType ease_type);
+    
+    /**
+     *  Evaluates one ease over an array of normalized times, i.e. with a duration of 1.
+     */
+    static void EvaluateEases(EaseType ease_type, const float* progress, float* eased_progress, size_t count, float overshootOrAmplitude);
+    
+    /**
+     *  Makes GetEaseFunction return lookup table versions of the Sine and Expo eases,
+     *  interpolating linearly between ease_table_size + 1 samples. Tweens keep the function
+     *  they had, so this should be set before any are created. Elastic is left out since it
+     *  depends on the duration and amplitude, and Circ since its endpoints are too steep.
+     *  Neither tabled curve reads the overshoot or amplitude, so the tables ignore it.
+     */
+    static void SetUseLookupTables(bool use_lookup_tables);
+    
+    /**
+     *  Looks up an EaseType by the name Lua uses for it, e.g. "OutQuad".
+     *
+     *  @return false, leaving ease_type untouched, if the name is unknown
+     */
+    static bool GetEaseTypeFromName(const std::string &ease_name, EaseType &ease_type);
+    
+    
+    static constexpr size_t ease_table_size = 1024;
+    
+    /**
+     *  The overshoot or amplitude tweens start with, and the one particle emitters always use.
+     */
+    static constexpr float default_overshoot_or_amplitude = 1.70158f;
+    
+private:
+    
+    static EaseFunction GetExactEaseFunction(EaseType ease_type);
+    
+    /**
+     *  Builds an array holding make_function(std::integral_constant<EaseType, i>()) for every index i.
+     */
+    template <typename Function, size_t... indices, typename MakeFunction>
+    static constexpr std::array<Function, sizeof...(indices)> MakeFunctionTable(std::index_sequence<indices...>, MakeFunction make_function);
+    
+    
+    template <EaseType ease_type>
+    static float EvaluateEaseAs(float elapsed_time, float duration, float overshootOrAmplitude);
+    
+    
+    template <EaseType ease_type>
+    static void EvaluateEasesAs(const float* progress, float* eased_progress, size_t count, float overshootOrAmplitude);
+    
+    
+    template <EaseType ease_type>
+    static void FillEaseTable();
+    
+    
+    template <EaseType ease_type>
+    static float EvaluateEaseFromTable(float elapsed_time, float duration, float overshootOrAmplitude);
+    
+    
+    static inline bool use_lookup_tables = false;
 };
 
 #endif /* EaseManager_hpp */
@@ -1,15 +1,61 @@
 #include "Engine.h"
 
 #include "AudioManager.hpp"
+#include "BenchReport.hpp"
+#include "LayerManager.hpp"
+#include "LuaProfiler.hpp"
 #include "TextManager.hpp"
+#include "PhysicsManager.hpp"
+#include "ReplayManager.hpp"
 #include "Rigidbody.hpp"
+#include "ThreadPool.hpp"
+#include "Tilemap.hpp"
 
-Engine::Engine() : engine_quit(false)
+#include <algorithm>
+#include <random>
+
+Engine::Engine() : Engine(0, nullptr) {}
+
+Engine::Engine(int argc, char* argv[]) : engine_quit(false)
 {
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        
+        if (arg == "--lockstep")
+            lockstep = true;
+        else if (arg == "--record" && i + 1 < argc)
+            record_path = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replay_path = argv[++i];
+        else if (arg == "--headless")
+            Renderer::SetHeadless(true);
+        else if (arg == "--frames" && i + 1 < argc)
+            max_frames = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--profile" && i + 1 < argc)
+            profile_path = argv[++i];
+        else if (arg == "--lua-profile" && i + 1 < argc)
+            lua_profile_path = argv[++i];
+        else if (arg == "--scene" && i + 1 < argc)
+            scene_override = argv[++i];
+        else if (arg == "--bench" && i + 1 < argc)
+            BenchReport::Start(argv[++i]);
+    }
+    
+    if (!profile_path.empty())
+        Profiler::SetEnabled(true);
+    
+    // With no display to pace against, headless runs advance a virtual clock by one timestep per frame
+    if (Renderer::IsHeadless())
+        lockstep = true;
+    
     update_timer = Timer();
     
     ComponentManager::Init();
     
+    if (!lua_profile_path.empty())
+        LuaProfiler::Start(ComponentManager::GetLuaState()->lua_state());
+    
     Renderer::Init();
     
     AudioManager::Init();
@@ -18,9 +64,16 @@ Engine::Engine() : engine_quit(false)
     
     TextManager::Init();
     
+    ThreadPool::Init();
+    
     
     ConfigGame();
     
+    if (!scene_override.empty())
+        name_of_scene_to_load = scene_override;
+    
+    StartLockstep();
+    
     Renderer::CreateWindow();
     
     SetCurrentScene();
@@ -33,13 +86,21 @@ void Engine::GameLoop()
         update_timer.Update();
         
         frame_time = update_timer.GetDeltaTimeSeconds();
-        float frame_time_discrepancy = min_frame_time > 0.0f ? min_frame_time - frame_time : -1.0f;
         
-        if (frame_time_discrepancy > 0.0f)
+        // The timer measures from the previous frame's start, so this is how long that frame took
+        if (BenchReport::IsRunning())
+            BenchReport::RecordFrame(frame_time);
+        
+        // Live lockstep runs are held to one step per timestep; replays run as fast as they can
+        float target_frame_time = lockstep ? std::max(min_frame_time, simulation_timestep) : min_frame_time;
+        float frame_time_discrepancy = target_frame_time > 0.0f ? target_frame_time - frame_time : -1.0f;
+        
+        if (frame_time_discrepancy > 0.0f && !ReplayManager::IsPlayingBack() && !Renderer::IsHeadless())
             Time::Sleep(frame_time_discrepancy * kMicroPerSecond);
         
-        SDL_Event e;
-        while(SDL_PollEvent(&e)) { HandleEvent(e); }
+        ProfileScope frame_scope("Frame");
+        
+        PollEvents();
         
         FixedUpdate();
         Start();
@@ -47,30 +108,146 @@ void Engine::GameLoop()
         LateUpdate();
         Input::TransitionInputStates();
         
-        RenderFrame();
+        if (lockstep)
+            ReplayManager::EndFrame(*current_scene);
+        
+        if (ReplayManager::PlaybackFinished() || ++frames_run == max_frames)
+            engine_quit = true;
+        
+        time_since_render += frame_time;
+        
+        // Presenting every replayed frame would cap playback at the display's refresh rate
+        if (!ReplayManager::IsPlayingBack() || time_since_render >= replay_render_interval)
+        {
+            time_since_render = 0.0f;
+            RenderFrame();
+        }
+        else
+            Renderer::DiscardFrame();
 
-        if (!name_of_scene_to_load.empty())
+        if (EventChannel<SceneLoadRequest>::Flush() > 0)
+        {
+            ProfileScope load_scope("LoadScene");
+            name_of_scene_to_load = EventChannel<SceneLoadRequest>::GetEvents().back().scene_name;
             SetCurrentScene();
+        }
     }
+    
+    ReplayManager::Finish();
+    
+    if (!profile_path.empty() && !Profiler::WriteChromeTrace(profile_path))
+        std::cout << "error: could not write profile to " << profile_path << std::endl;
+    
+    if (BenchReport::IsRunning() && !BenchReport::Write(*current_scene))
+        std::cout << "error: could not write benchmark report" << std::endl;
+    
+    if (!lua_profile_path.empty() && !LuaProfiler::WriteFoldedStacks(lua_profile_path))
+        std::cout << "error: could not write Lua profile to " << lua_profile_path << std::endl;
 }
 
 
 void Engine::FixedUpdate()
 {
+    ProfileScope fixed_update_scope("FixedUpdate");
+    
+    if (lockstep)
+    {
+        FixedStep();
+        return;
+    }
+    
+    simulation_time_budget += frame_time;
+    
+    while (simulation_time_budget > simulation_timestep)
+    {
+        FixedStep();
+        simulation_time_budget -= simulation_timestep;
+    }
+}
+
+
+void Engine::FixedStep()
+{
+    ProfileScope fixed_step_scope("FixedStep");
+    
+    {
+        ProfileScope tween_scope("Tweens");
+        TweenManager::FixedUpdate();
+    }
+    
+    // Scenes without a Rigidbody still step, so fixed timers, waits and OnFixedUpdate keep running
     if (Rigidbody::GetWorld())
     {
-        simulation_time_budget += frame_time;
+        ProfileScope step_scope("b2World::Step");
+        Rigidbody::GetWorld()->Step(simulation_timestep, 8, 3);
+        Rigidbody::ProcessMovedBodies();
+    }
+    
+    {
+        ProfileScope timer_scope("Timers");
+        Scheduler::FixedUpdate(simulation_timestep);
+    }
+    
+    {
+        ProfileScope coroutine_scope("Coroutines");
+        CoroutineManager::FixedUpdate();
+    }
+    
+    current_scene->OnFixedUpdate();
+    
+    {
+        ProfileScope contact_scope("ContactCallbacks");
+        CollisionManager::ProcessContactCallbacks();
+    }
+    
+    steps_taken_this_frame++;
+}
+
+
+void Engine::StartLockstep()
+{
+    uint32_t seed = 0;
+    
+    if (!replay_path.empty())
+    {
+        ReplayManager::StartPlayback(replay_path);
+        simulation_timestep = ReplayManager::GetRecordedTimestep();
+        seed = ReplayManager::GetSeed();
+        lockstep = true;
+    }
+    else if (!record_path.empty())
+    {
+        seed = std::random_device()();
+        ReplayManager::StartRecording(record_path, seed, simulation_timestep);
+        lockstep = true;
+    }
+    
+    // Lua seeds math.random from the clock, so lockstep runs always reseed it
+    if (lockstep)
+        (*ComponentManager::GetLuaState())["math"]["randomseed"](seed);
+}
+
+
+void Engine::PollEvents()
+{
+    ProfileScope poll_scope("PollEvents");
+    
+    SDL_Event e;
+    
+    while (SDL_PollEvent(&e))
+    {
+        // Only the log drives a replay, but the window can still be closed
+        if (ReplayManager::IsPlayingBack() && e.type != SDL_QUIT)
+            continue;
         
-        while (simulation_time_budget > simulation_timestep)
-        {
-            TweenManager::FixedUpdate();
-            Rigidbody::GetWorld()->Step(simulation_timestep, 8, 3);
-            current_scene->OnFixedUpdate();
-            CollisionManager::ProcessContactCallbacks();
-            simulation_time_budget -= simulation_timestep;
-            steps_taken_this_frame++;
-        }
+        ReplayManager::RecordEvent(e);
+        HandleEvent(e);
     }
+    
+    while (ReplayManager::PollEvent(e))
+        HandleEvent(e);
+    
+    Input::UpdateActions();
 }
 
 
@@ -98,6 +275,24 @@ void Engine::ConfigGame()
     if (config_doc.HasMember("physics_timesteps_per_second") && config_doc["physics_timesteps_per_second"].IsNumber())
         simulation_timestep = 1.0f / config_doc["physics_timesteps_per_second"].GetFloat();
     
+    if (config_doc.HasMember("lockstep") && config_doc["lockstep"].IsBool())
+        lockstep = lockstep || config_doc["lockstep"].GetBool();
+    
+    if (config_doc.HasMember("perf_hud_key") && config_doc["perf_hud_key"].IsString())
+        PerfHUD::SetToggleKey(config_doc["perf_hud_key"].GetString());
+    
+    if (config_doc.HasMember("perf_hud_font") && config_doc["perf_hud_font"].IsString())
+        PerfHUD::SetFont(config_doc["perf_hud_font"].GetString());
+    
+    if (config_doc.HasMember("parallel_physics") && config_doc["parallel_physics"].IsBool())
+        PhysicsManager::SetParallelStepping(config_doc["parallel_physics"].GetBool());
+    
+    if (config_doc.HasMember("ease_lookup_tables") && config_doc["ease_lookup_tables"].IsBool())
+        EaseManager::SetUseLookupTables(config_doc["ease_lookup_tables"].GetBool());
+    
+    if (fs::exists(INPUT_CONFIG_PATH))
+        Input::LoadActionMap(INPUT_CONFIG_PATH);
+    
     if (fs::exists(RENDERING_CONFIG_PATH))
     {
         // Load game config
@@ -126,6 +321,9 @@ void Engine::ConfigGame()
 
 void Engine::SetCurrentScene()
 {
+    // The old scene's bodies are still alive here, and moved_bodies mustn't outlive them
+    Rigidbody::ProcessMovedBodies();
+    
     SceneManager::SetCurrentScene(name_of_scene_to_load);
     name_of_scene_to_load = "";
     current_scene = &SceneManager::current_scene;
@@ -141,7 +339,15 @@ void Engine::HandleEvent(const SDL_Event &e)
             engine_quit = true;
             break;
             
+        // Render target contents are lost when the device resets, so baked tilemap chunks and layers need redoing
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            Tilemap::InvalidateBakedChunks();
+            LayerManager::InvalidateLayers();
+            break;
+            
         default:
+            PerfHUD::HandleEvent(e);
             Input::ProcessInput(e);
             break;
     }
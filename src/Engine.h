@@ -15,18 +15,32 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include "Actor.hpp"
+#include "BenchReport.hpp"
+#include "CoroutineManager.hpp"
 #include "EventBus.hpp"
+#include "EventChannel.hpp"
 #include "glm.hpp"
 #include "ImageManager.hpp"
 #include "Input.hpp"
+#include "PerfHUD.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
 #include "SceneManager.hpp"
+#include "Scheduler.hpp"
 #include "TweenManager.hpp"
 #include "Timer.hpp"
 
 
 namespace fs = std::filesystem;
 
+/**
+ *  Sent by Scene.Load. The engine loads the last scene requested once the frame is done.
+ */
+struct SceneLoadRequest
+{
+    std::string scene_name;
+};
+
 
 class Engine
 {
@@ -34,6 +48,21 @@ public:
     
     
     Engine();
+    
+    /**
+     *  Parses the command line before starting the engine.
+     *
+     *  --lockstep          steps the simulation exactly once per frame with a fixed delta time
+     *  --record <path>     runs in lockstep and writes every input event and state hash to path
+     *  --replay <path>     replays a recorded log as fast as possible, verifying every frame
+     *  --headless          runs without a display or audio device on a virtual clock, discarding frames unless --bench is collecting a report
+     *  --frames <count>    quits after count frames
+     *  --profile <path>    profiles from the first frame and writes a Chrome trace to path on exit
+     *  --lua-profile <path>    samples Lua call stacks and writes them to path as folded stacks on exit
+     *  --scene <name>      starts in the named scene instead of game.config's initial_scene
+     *  --bench <path>      writes frame time percentiles, allocations and Lua heap size to path as JSON on exit
+     */
+    Engine(int argc, char* argv[]);
 
     
     void ConfigGame();
@@ -51,6 +80,9 @@ public:
     static float GetFixedDeltaTime();
     
     
+    static bool IsLockstep();
+    
+    
     static void cppCameraSetPosition(float x, float y);
     
     
@@ -60,6 +92,9 @@ public:
     static float cppCameraGetPositionY();
     
     
+    static NativeTween cppCameraTweenPosition(float x, float y, float duration);
+    
+    
     static void cppSceneLoad(const std::string &scene_name);
     
     
@@ -77,6 +112,9 @@ private:
     void FixedUpdate();
     
     
+    void FixedStep();
+    
+    
     void LateUpdate();
     
     
@@ -89,6 +127,12 @@ private:
     void HandleEvent(const SDL_Event &e);
     
     
+    void StartLockstep();
+    
+    
+    void PollEvents();
+    
+    
     static inline Scene *current_scene;
     
     
@@ -119,36 +163,117 @@ private:
     
     static inline uint16_t steps_taken_this_frame = 0;
     
+    /**
+     *  Steps exactly once per frame and reports simulation_timestep as the delta time,
+     *  so a run only depends on its inputs and not on how long frames took.
+     */
+    static inline bool lockstep = false;
+    
+    
+    static inline float time_since_render = 0.0f;
+    
+    
+    static inline const float replay_render_interval = 1.0f / 60.0f;
+    
+    
+    std::string record_path;
+    
+    
+    std::string replay_path;
+    
+    /**
+     *  Quits once this many frames have run. Zero runs until the game quits.
+     */
+    uint64_t max_frames = 0;
+    
+    
+    uint64_t frames_run = 0;
+    
+    
+    std::string profile_path;
+    
+    
+    std::string lua_profile_path;
+    
+    
+    std::string scene_override;
+    
     
     bool engine_quit = false;
     
 };
 
 
-inline void Engine::Start()     { current_scene->OnStart(); }
+inline void Engine::Start()
+{
+    ProfileScope start_scope("Start");
+    current_scene->OnStart();
+}
 
 
 inline void Engine::Update()
 {
-    TweenManager::Update();
+    ProfileScope update_scope("Update");
+    
+    {
+        ProfileScope tween_scope("Tweens");
+        TweenManager::Update();
+    }
+    
+    {
+        ProfileScope timer_scope("Timers");
+        Scheduler::Update(GetDeltaTime());
+    }
+    
+    {
+        ProfileScope coroutine_scope("Coroutines");
+        CoroutineManager::Update();
+    }
+    
     current_scene->OnUpdate();
 }
 
 
 inline void Engine::LateUpdate()
 {
-    TweenManager::LateUpdate();
+    ProfileScope late_update_scope("LateUpdate");
+    
+    {
+        ProfileScope tween_scope("Tweens");
+        TweenManager::LateUpdate();
+    }
+    
     current_scene->OnLateUpdate();
-    EventBus::LateUpdate();
+    
+    {
+        ProfileScope event_bus_scope("EventBus");
+        EventBus::LateUpdate();
+    }
+    
+    ProfileScope destroy_scope("OnDestroy");
     current_scene->OnDestroy();
 }
 
 
 inline void Engine::RenderFrame()
 {
+    ProfileScope render_scope("Render");
+    
+    PerfHUD::RecordFrame(frame_time, steps_taken_this_frame);
     steps_taken_this_frame = 0;
+    
+    // Benchmarks still draw through the software renderer, or the rendering scenes would measure nothing
+    if (Renderer::IsHeadless() && !BenchReport::IsRunning())
+    {
+        Renderer::DiscardFrame();
+        return;
+    }
+    
     Renderer::ClearFrame();
     Renderer::DrawFrame();
+    PerfHUD::Draw(Renderer::GetSDLRenderer(), *current_scene);
+    
+    ProfileScope present_scope("Present");
     Renderer::PresentFrame();
     
 #if DEBUG_FPS
@@ -160,12 +285,15 @@ inline void Engine::RenderFrame()
 inline glm::vec2 Engine::GetCameraPosition()                    { return camera_position; }
 
 
-inline double Engine::GetDeltaTime()                            { return update_timer.GetDeltaTimeSeconds(); }
+inline double Engine::GetDeltaTime()                            { return lockstep ? simulation_timestep : update_timer.GetDeltaTimeSeconds(); }
 
 
 inline float Engine::GetFixedDeltaTime()                        { return simulation_timestep; }
 
 
+inline bool Engine::IsLockstep()                                { return lockstep; }
+
+
 inline void Engine::cppCameraSetPosition(float x, float y)      { camera_position = glm::vec2(x, y); }
 
 
@@ -175,7 +303,13 @@ inline float Engine::cppCameraGetPositionX()                    { return GetCame
 inline float Engine::cppCameraGetPositionY()                    { return GetCameraPosition().y; }
 
 
-inline void Engine::cppSceneLoad(const std::string &scene_name) { name_of_scene_to_load = scene_name; }
+inline NativeTween Engine::cppCameraTweenPosition(float x, float y, float duration)
+{
+    return NativeTweenManager::CreateVec2(&camera_position.x, &camera_position.y, camera_position.x, camera_position.y, x, y, duration);
+}
+
+
+inline void Engine::cppSceneLoad(const std::string &scene_name) { EventChannel<SceneLoadRequest>::Publish({ scene_name }); }
 
 
 #endif // !ENGINE_H
@@ -7,10 +7,152 @@
 
 #include "EventBus.hpp"
 
+#include <algorithm>
+
 
 void EventBus::LateUpdate()
 {
+    // Events deferred while these are delivered wait for the next frame
+    std::vector<DeferredEvent> events_to_deliver;
+    events_to_deliver.swap(deferred_events);
+
+    for (const DeferredEvent &deferred_event : events_to_deliver)
+        Publish(deferred_event.event_id, deferred_event.event_object);
+
     for (const std::function<void()> &sub_unsub_to_process : sub_unsubs_to_process) { sub_unsub_to_process(); }
-    
+
     sub_unsubs_to_process.clear();
 }
+
+
+EventID EventBus::GetEventID(const std::string &event_type)
+{
+    auto [event_id_it, inserted] = event_ids.try_emplace(event_type, static_cast<EventID>(event_subscribers.size()));
+
+    if (inserted)
+        event_subscribers.emplace_back();
+
+    return event_id_it->second;
+}
+
+
+NativeSubscription EventBus::SubscribeNative(EventID event_id, NativeEventFunction function)
+{
+    NativeSubscription subscription;
+
+    if (event_id >= event_subscribers.size())
+        return subscription;
+
+    Subscriber subscriber;
+    subscriber.native_function = std::move(function);
+    subscriber.native_id = native_subscribers_added++;
+
+    event_subscribers[event_id].subscribers.push_back(std::move(subscriber));
+
+    subscription.event_id = event_id;
+    subscription.id = event_subscribers[event_id].subscribers.back().native_id;
+
+    return subscription;
+}
+
+
+void EventBus::UnsubscribeNative(const NativeSubscription &subscription)
+{
+    if (subscription.event_id >= event_subscribers.size())
+        return;
+
+    EventSubscribers &event_entry = event_subscribers[subscription.event_id];
+
+    for (Subscriber &subscriber : event_entry.subscribers)
+    {
+        if (subscriber.alive && subscriber.native_id == subscription.id)
+        {
+            subscriber.alive = false;
+            event_entry.dead_count++;
+            break;
+        }
+    }
+
+    Sweep(event_entry);
+}
+
+
+void EventBus::EventBusSubscribe(EventID event_id, sol::main_table component, sol::main_protected_function function)
+{
+    Subscriber subscriber;
+    subscriber.function = function;
+    subscriber.component = component;
+
+    event_subscribers[event_id].subscribers.push_back(std::move(subscriber));
+}
+
+
+void EventBus::EventBusUnsubscribe(EventID event_id, sol::main_table component, sol::main_protected_function function)
+{
+    EventSubscribers &event_entry = event_subscribers[event_id];
+
+    // Every matching subscription goes, so subscribing twice and unsubscribing once leaves none
+    for (Subscriber &subscriber : event_entry.subscribers)
+    {
+        if (subscriber.alive && !subscriber.native_function && subscriber.function == function && subscriber.component == component)
+        {
+            subscriber.alive = false;
+            event_entry.dead_count++;
+        }
+    }
+
+    Sweep(event_entry);
+}
+
+
+void EventBus::Publish(EventID event_id, sol::optional<sol::table> event_object)
+{
+    publish_depth++;
+
+    // Indexed rather than iterated, since subscribers added from a callback may grow the vector
+    size_t subscriber_count = event_subscribers[event_id].subscribers.size();
+
+    for (size_t i = 0; i < subscriber_count; ++i)
+    {
+        Subscriber &subscriber = event_subscribers[event_id].subscribers[i];
+
+        if (!subscriber.alive)
+            continue;
+
+        if (subscriber.native_function)
+        {
+            // Copied, since the subscriber's storage can move during the call
+            NativeEventFunction native_function = subscriber.native_function;
+            native_function(event_object);
+            continue;
+        }
+
+        sol::main_protected_function function = subscriber.function;
+        sol::protected_function_result pub_sub_result = function(subscriber.component, event_object);
+
+        if (!pub_sub_result.valid())
+            ReportError("EventBus", pub_sub_result);
+    }
+
+    std::vector<NativeEventFunction> waiters;
+    waiters.swap(event_subscribers[event_id].waiters);
+
+    for (NativeEventFunction &waiter : waiters)
+        waiter(event_object);
+
+    publish_depth--;
+
+    Sweep(event_subscribers[event_id]);
+}
+
+
+void EventBus::Sweep(EventSubscribers &event_entry)
+{
+    if (publish_depth > 0 || event_entry.dead_count == 0)
+        return;
+
+    event_entry.subscribers.erase(std::remove_if(event_entry.subscribers.begin(), event_entry.subscribers.end(), [](const Subscriber &subscriber) { return !subscriber.alive; }),
+                                  event_entry.subscribers.end());
+
+    event_entry.dead_count = 0;
+}
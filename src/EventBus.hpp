@@ -10,77 +10,208 @@
 
 #include "Actor.hpp"
 
+#include <cstdint>
+#include <functional>
 #include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+
+using EventID = uint32_t;
+
+
+using NativeEventFunction = std::function<void(const sol::optional<sol::table>&)>;
+
+/**
+ *  Returned by EventBus::SubscribeNative to unsubscribe with later.
+ */
+struct NativeSubscription
+{
+    EventID event_id = UINT32_MAX;
+    uint32_t id = UINT32_MAX;
+};
+
+/**
+ *  Event types are interned to EventIDs the first time they are seen, and each one keeps
+ *  its subscribers in a flat vector. Unsubscribing only marks a subscriber dead, so a publish
+ *  can walk the vector while subscribers come and go, and dead ones are swept out once no
+ *  publish is running. Lua subscribes and unsubscribes still take effect in LateUpdate.
+ */
 class EventBus {
 public:
-    
-    
+
+
     static void cppEventPublish(const std::string &event_type, sol::optional<sol::table> event_object);
-    
-    
+
+
+    static void cppEventPublishID(EventID event_id, sol::optional<sol::table> event_object);
+
+    /**
+     *  Queues the event to be delivered with the rest of the frame's deferred events in LateUpdate.
+     */
+    static void cppEventPublishDeferred(const std::string &event_type, sol::optional<sol::table> event_object);
+
+
+    static void cppEventPublishDeferredID(EventID event_id, sol::optional<sol::table> event_object);
+
+
     static void cppEventSubscribe(const std::string &event_type, sol::table component, sol::protected_function function);
-    
-    
+
+
     static void cppEventUnsubscribe(const std::string &event_type, sol::table component, sol::protected_function function);
-    
-    
+
+
+    static EventID cppEventGetID(const std::string &event_type);
+
+    /**
+     *  Delivers the deferred events, then applies the frame's Lua subscribes and unsubscribes.
+     */
     static void LateUpdate();
-    
-    
+
+    /**
+     *  Interns event_type, so the same name always gets the same EventID.
+     */
+    static EventID GetEventID(const std::string &event_type);
+
+    /**
+     *  Adds a C++ subscriber right away. One added during a publish of its event misses that publish.
+     */
+    static NativeSubscription SubscribeNative(EventID event_id, NativeEventFunction function);
+
+
+    static void UnsubscribeNative(const NativeSubscription &subscription);
+
+    /**
+     *  Calls waiter with the event object the next time event_type is published, once.
+     *  Waiters run during the publish, so they should only queue work.
+     */
+    static void WaitForEvent(const std::string &event_type, NativeEventFunction waiter);
+
+
     static inline std::vector<std::function<void()>> sub_unsubs_to_process;
-    
+
 private:
-    
-    
-    static void EventBusSubscribe(const std::string &event_type, sol::table component, sol::protected_function function);
-    
-    
-    static void EventBusUnsubscribe(const std::string &event_type, sol::table component, sol::protected_function function);
-    
-    
-    static inline std::map<std::string, std::vector<std::pair<sol::protected_function, sol::table>>> event_bus;
+
+
+    struct Subscriber
+    {
+        sol::main_protected_function function;
+        sol::main_table component;
+
+        NativeEventFunction native_function;
+
+        uint32_t native_id = UINT32_MAX;
+
+        bool alive = true;
+    };
+
+
+    struct EventSubscribers
+    {
+        std::vector<Subscriber> subscribers;
+
+        std::vector<NativeEventFunction> waiters;
+
+        uint32_t dead_count = 0;
+    };
+
+
+    struct DeferredEvent
+    {
+        EventID event_id;
+        sol::optional<sol::main_table> event_object;
+    };
+
+
+    static void EventBusSubscribe(EventID event_id, sol::main_table component, sol::main_protected_function function);
+
+
+    static void EventBusUnsubscribe(EventID event_id, sol::main_table component, sol::main_protected_function function);
+
+
+    static void Publish(EventID event_id, sol::optional<sol::table> event_object);
+
+    /**
+     *  Drops dead subscribers, unless a publish is running.
+     */
+    static void Sweep(EventSubscribers &event_entry);
+
+
+    static inline std::unordered_map<std::string, EventID> event_ids;
+
+    /**
+     *  Indexed by EventID.
+     */
+    static inline std::vector<EventSubscribers> event_subscribers;
+
+
+    static inline std::vector<DeferredEvent> deferred_events;
+
+
+    static inline uint32_t native_subscribers_added = 0;
+
+
+    static inline int publish_depth = 0;
 };
 
 
 inline void EventBus::cppEventPublish(const std::string &event_type, sol::optional<sol::table> event_object)
 {
-    for (std::pair<sol::protected_function, sol::table> &event_subscriber : event_bus[event_type])
-    {
-        sol::protected_function_result pub_sub_result = (event_subscriber.first)(event_subscriber.second, event_object);
-        
-        if (!pub_sub_result.valid())
-            ReportError("EventBus", pub_sub_result);
-    }
+    // Publishing an event nobody has named yet reaches nobody, so it isn't interned
+    auto event_id_it = event_ids.find(event_type);
+
+    if (event_id_it != event_ids.end())
+        Publish(event_id_it->second, event_object);
 }
 
 
-inline void EventBus::cppEventSubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
+inline void EventBus::cppEventPublishID(EventID event_id, sol::optional<sol::table> event_object)
 {
-    sub_unsubs_to_process.emplace_back( [event_type, component, function] { EventBusSubscribe(event_type, component, function); });
+    if (event_id < event_subscribers.size())
+        Publish(event_id, event_object);
 }
 
 
-inline void EventBus::cppEventUnsubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
+inline void EventBus::cppEventPublishDeferred(const std::string &event_type, sol::optional<sol::table> event_object)
+{
+    deferred_events.push_back({ GetEventID(event_type), std::move(event_object) });
+}
+
+
+inline void EventBus::cppEventPublishDeferredID(EventID event_id, sol::optional<sol::table> event_object)
 {
-    sub_unsubs_to_process.emplace_back( [event_type, component, function] { EventBusUnsubscribe(event_type, component, function); });
+    if (event_id < event_subscribers.size())
+        deferred_events.push_back({ event_id, std::move(event_object) });
 }
 
 
+inline void EventBus::cppEventSubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
+{
+    EventID event_id = GetEventID(event_type);
 
+    // Processed at the end of the frame, by which point a coroutine that subscribed may have finished
+    sub_unsubs_to_process.emplace_back( [event_id, component = sol::main_table(component), function = sol::main_protected_function(function)] {
+        EventBusSubscribe(event_id, component, function);
+    });
+}
 
 
-inline void EventBus::EventBusSubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
+inline void EventBus::cppEventUnsubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
 {
-    std::pair<sol::protected_function, sol::table> function_component_pair = std::make_pair(function, component);
-    event_bus[event_type].emplace_back(function_component_pair);
+    EventID event_id = GetEventID(event_type);
+    sub_unsubs_to_process.emplace_back( [event_id, component = sol::main_table(component), function = sol::main_protected_function(function)] {
+        EventBusUnsubscribe(event_id, component, function);
+    });
 }
 
 
-inline void EventBus::EventBusUnsubscribe(const std::string &event_type, sol::table component, sol::protected_function function)
+inline EventID EventBus::cppEventGetID(const std::string &event_type)    { return GetEventID(event_type); }
+
+
+inline void EventBus::WaitForEvent(const std::string &event_type, NativeEventFunction waiter)
 {
-    std::pair<sol::protected_function, sol::table> function_component_pair = std::make_pair(function, component);
-    event_bus[event_type].erase(std::remove_if(event_bus[event_type].begin(), event_bus[event_type].end(), [function_component_pair](std::pair<sol::protected_function, sol::table> subscriber) { return function_component_pair == subscriber; }));
+    event_subscribers[GetEventID(event_type)].waiters.push_back(std::move(waiter));
 }
 
 #endif /* EventBus_hpp */
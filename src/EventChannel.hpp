@@ -0,0 +1,277 @@
+//
+//  EventChannel.hpp
+//  blitzENGINE
+//
+
+#ifndef EventChannel_hpp
+#define EventChannel_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/**
+ *  A fixed-size ring for one producer thread and one consumer thread.
+ */
+template <typename Event, size_t Capacity>
+class SPSCRing {
+public:
+
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ring capacity must be a power of two");
+
+    /**
+     *  @return false if the ring is full, in which case the event is dropped
+     */
+    bool TryPush(const Event &event);
+
+
+    bool TryPop(Event &event);
+
+private:
+
+
+    static constexpr size_t cache_line_size = 64;
+
+
+    std::array<Event, Capacity> slots;
+
+
+    alignas(cache_line_size) std::atomic<size_t> head{0};
+
+
+    alignas(cache_line_size) std::atomic<size_t> tail{0};
+};
+
+/**
+ *  A fixed-size ring for any number of producer threads and one consumer thread.
+ *
+ *  Each slot carries a sequence number, so producers claim slots with a single
+ *  compare-exchange on the tail and the consumer knows when a claimed slot is written.
+ */
+template <typename Event, size_t Capacity>
+class MPSCRing {
+public:
+
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ring capacity must be a power of two");
+
+
+    MPSCRing();
+
+    /**
+     *  @return false if the ring is full, in which case the event is dropped
+     */
+    bool TryPush(const Event &event);
+
+
+    bool TryPop(Event &event);
+
+private:
+
+
+    static constexpr size_t cache_line_size = 64;
+
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Event event;
+    };
+
+
+    std::array<Slot, Capacity> slots;
+
+
+    alignas(cache_line_size) std::atomic<size_t> head{0};
+
+
+    alignas(cache_line_size) std::atomic<size_t> tail{0};
+};
+
+/**
+ *  A typed channel for engine systems to message each other without going through Lua.
+ *
+ *  Each event type gets its own channel, e.g. EventChannel<ContactEvent>. Worker threads
+ *  Post into a lock-free ring and the main thread Publishes straight into the frame's list.
+ *  Once per frame the owning system calls Flush on the main thread, and until the next flush
+ *  every reader walks the same GetEvents list without copying it. Both lists keep their
+ *  capacity, so a channel stops allocating once it has seen its busiest frame.
+ *
+ *  Ring is SPSCRing when only one thread ever posts, MPSCRing otherwise.
+ */
+template <typename Event, typename Ring = MPSCRing<Event, 256>>
+class EventChannel {
+public:
+
+    /**
+     *  Queues an event from any thread. Events posted while the ring is full are dropped and counted.
+     */
+    static bool Post(const Event &event);
+
+    /**
+     *  Queues an event from the main thread. Never drops.
+     */
+    static void Publish(const Event &event);
+
+    /**
+     *  Makes everything queued since the last flush readable through GetEvents. Main thread only.
+     *
+     *  @return the number of events now readable
+     */
+    static size_t Flush();
+
+
+    static const std::vector<Event>& GetEvents();
+
+
+    static uint64_t GetDroppedCount();
+
+private:
+
+
+    static inline Ring ring;
+
+
+    static inline std::vector<Event> pending_events;
+
+
+    static inline std::vector<Event> events;
+
+
+    static inline std::atomic<uint64_t> dropped_count{0};
+};
+
+
+template <typename Event, size_t Capacity>
+inline bool SPSCRing<Event, Capacity>::TryPush(const Event &event)
+{
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+
+    if (current_tail - head.load(std::memory_order_acquire) == Capacity)
+        return false;
+
+    slots[current_tail & (Capacity - 1)] = event;
+    tail.store(current_tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+template <typename Event, size_t Capacity>
+inline bool SPSCRing<Event, Capacity>::TryPop(Event &event)
+{
+    size_t current_head = head.load(std::memory_order_relaxed);
+
+    if (current_head == tail.load(std::memory_order_acquire))
+        return false;
+
+    event = std::move(slots[current_head & (Capacity - 1)]);
+    head.store(current_head + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+template <typename Event, size_t Capacity>
+inline MPSCRing<Event, Capacity>::MPSCRing()
+{
+    for (size_t i = 0; i < Capacity; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+
+template <typename Event, size_t Capacity>
+inline bool MPSCRing<Event, Capacity>::TryPush(const Event &event)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true)
+    {
+        slot = &slots[position & (Capacity - 1)];
+
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        // The slot is free for this lap, so try to claim it
+        if (difference == 0)
+        {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        // The consumer hasn't emptied the slot from the last lap yet
+        else if (difference < 0)
+            return false;
+        // Another producer claimed it first
+        else
+            position = tail.load(std::memory_order_relaxed);
+    }
+
+    slot->event = event;
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+template <typename Event, size_t Capacity>
+inline bool MPSCRing<Event, Capacity>::TryPop(Event &event)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    Slot &slot = slots[position & (Capacity - 1)];
+
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+        return false;
+
+    event = std::move(slot.event);
+    slot.sequence.store(position + Capacity, std::memory_order_release);
+    head.store(position + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+
+template <typename Event, typename Ring>
+inline bool EventChannel<Event, Ring>::Post(const Event &event)
+{
+    if (ring.TryPush(event))
+        return true;
+
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+
+template <typename Event, typename Ring>
+inline void EventChannel<Event, Ring>::Publish(const Event &event)
+{
+    pending_events.push_back(event);
+}
+
+
+template <typename Event, typename Ring>
+inline size_t EventChannel<Event, Ring>::Flush()
+{
+    Event event;
+
+    while (ring.TryPop(event))
+        pending_events.push_back(std::move(event));
+
+    events.swap(pending_events);
+    pending_events.clear();
+
+    return events.size();
+}
+
+
+template <typename Event, typename Ring>
+inline const std::vector<Event>& EventChannel<Event, Ring>::GetEvents()    { return events; }
+
+
+template <typename Event, typename Ring>
+inline uint64_t EventChannel<Event, Ring>::GetDroppedCount()               { return dropped_count.load(std::memory_order_relaxed); }
+
+#endif /* EventChannel_hpp */
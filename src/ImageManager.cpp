@@ -7,6 +7,7 @@
 
 #include "ImageManager.hpp"
 
+#include "LayerManager.hpp"
 #include "Renderer.hpp"
 
 #include <iostream>
@@ -64,6 +65,18 @@ void ImageManager::cppImageDrawEx(const std::string &image_name, float _x, float
 
 
 void ImageManager::cppImageDrawUIEx(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order)
+{
+    Renderer::ui_render_requests.push_back(CreateUIDrawRequest(image_name, _x, _y, _r, _g, _b, _a, _sorting_order));
+}
+
+
+void ImageManager::cppImageDrawUIExLayer(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order, const std::string &layer_name)
+{
+    LayerManager::GetLayer(layer_name).ui_render_requests.push_back(CreateUIDrawRequest(image_name, _x, _y, _r, _g, _b, _a, _sorting_order));
+}
+
+
+ImageDrawRequest ImageManager::CreateUIDrawRequest(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order)
 {
     ImageDrawRequest image_draw_req;
     
@@ -81,5 +94,5 @@ void ImageManager::cppImageDrawUIEx(const std::string &image_name, float _x, flo
     
     image_draw_req.screen_space_mod = 0.0f;
     
-    Renderer::ui_render_requests.push_back(image_draw_req);
+    return image_draw_req;
 }
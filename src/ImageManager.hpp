@@ -10,6 +10,8 @@
 #include <string>
 #include <unordered_map>
 
+struct ImageDrawRequest;
+
 class ImageManager {
     
 public:
@@ -42,10 +44,24 @@ public:
     
     
     static void cppImageDrawUIEx(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order);
+    
+    
+    static void cppImageDrawUILayer(const std::string &image_name, float _x, float _y, const std::string &layer_name);
+    
+    /**
+     *  Draws into the named layer instead of straight to the frame. See LayerManager.
+     */
+    static void cppImageDrawUIExLayer(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order, const std::string &layer_name);
+    
+    
+    static size_t GetCachedImageCount();
 
 private:
     
     
+    static ImageDrawRequest CreateUIDrawRequest(const std::string &image_name, float _x, float _y, float _r, float _g, float _b, float _a, float _sorting_order);
+    
+    
     static inline std::unordered_map<std::string, std::shared_ptr<Image>> image_cache;
 };
 
@@ -83,6 +99,9 @@ inline std::shared_ptr<Image> ImageManager::AddImage(const std::string &image_na
 inline bool ImageManager::CheckImage(const std::string &image_name) { return (bool) image_cache.count(image_name); }
 
 
+inline size_t ImageManager::GetCachedImageCount()                   { return image_cache.size(); }
+
+
 inline void ImageManager::cppImageDraw(const std::string &image_name, float _x, float _y)
 {
     cppImageDrawEx(image_name, _x, _y, 0, 1, 1, 0.5f, 0.5f, 255, 255, 255, 255, 0);
@@ -91,4 +110,10 @@ inline void ImageManager::cppImageDraw(const std::string &image_name, float _x,
 
 inline void ImageManager::cppImageDrawUI(const std::string &image_name, float _x, float _y) { cppImageDrawUIEx(image_name, _x, _y, 255, 255, 255, 255, 0); }
 
+
+inline void ImageManager::cppImageDrawUILayer(const std::string &image_name, float _x, float _y, const std::string &layer_name)
+{
+    cppImageDrawUIExLayer(image_name, _x, _y, 255, 255, 255, 255, 0, layer_name);
+}
+
 #endif /* ImageManager_hpp */
@@ -7,6 +7,10 @@
 
 #include "Input.hpp"
 
+#include "Utilities.hpp"
+
+#include <cmath>
+
 std::unordered_map<std::string, SDL_Scancode> __keycode_to_scancode = {
     // Directional (arrow) Keys
     {"up", SDL_SCANCODE_UP},
@@ -106,8 +110,8 @@ std::unordered_map<std::string, SDL_GameControllerButton> __button_name_to_sdl_b
     /* D-Pad Buttons */
     {"Up", SDL_CONTROLLER_BUTTON_DPAD_UP},
     {"Down", SDL_CONTROLLER_BUTTON_DPAD_DOWN},
-    {"Right", SDL_CONTROLLER_BUTTON_DPAD_LEFT},
-    {"Left", SDL_CONTROLLER_BUTTON_DPAD_RIGHT},
+    {"Right", SDL_CONTROLLER_BUTTON_DPAD_RIGHT},
+    {"Left", SDL_CONTROLLER_BUTTON_DPAD_LEFT},
     
     /* Xbox Series X share button, PS5 microphone button, Nintendo Switch Pro capture button, Amazon Luna microphone button */
     {"Misc1", SDL_CONTROLLER_BUTTON_MISC1},
@@ -135,14 +139,17 @@ void Input::Init()
 {
     SDL_Init(SDL_INIT_EVENTS);
     
-    keyboard_states.clear();
+    keyboard_states.fill(INPUT_STATE_UP);
+    just_changed_scancodes.reset();
     
-    mouse_button_states.clear();
+    mouse_button_states.fill(INPUT_STATE_UP);
+    just_changed_mouse_buttons.reset();
     mouse_position = glm::vec2(0,0);
     mouse_scroll_delta = 0.0f;
     
-    controller_button_states.clear();
-    controller_axis_states.clear();
+    controller_button_states.fill(INPUT_STATE_UP);
+    just_changed_controller_buttons.reset();
+    controller_axis_states.fill(0.0f);
     controller_touchpad_position = glm::vec2(0,0);
 }
 
@@ -151,68 +158,27 @@ void Input::ProcessInput(const SDL_Event &e)
     switch (e.type)
     {
         case SDL_KEYDOWN: {
-            SDL_Scancode scancode = e.key.keysym.scancode;
-            
-            // If first time being pressed, or currently up, set to down
-            if (keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_UP || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-            {
-                keyboard_states[scancode] = INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
-            }
-            else
-            {
-                keyboard_states[scancode] = INPUT_STATE_JUST_BECAME_DOWN;
-                just_changed_scancodes.push(scancode);
-            }
-                
+            // Unmapped keys arrive as SDL_SCANCODE_UNKNOWN, which is also what unknown key names look up
+            if (e.key.keysym.scancode != SDL_SCANCODE_UNKNOWN)
+                Press(keyboard_states, just_changed_scancodes, e.key.keysym.scancode);
             break;
         }
             
         case SDL_KEYUP: {
-            SDL_Scancode scancode = e.key.keysym.scancode;
-            
-            
-            if (keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_DOWN || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-            {
-                keyboard_states[scancode] = INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
-            }
-            else
-            {
-                keyboard_states[scancode] = INPUT_STATE_JUST_BECAME_UP;
-                just_changed_scancodes.push(scancode);
-            }
-                
+            if (e.key.keysym.scancode != SDL_SCANCODE_UNKNOWN)
+                Release(keyboard_states, just_changed_scancodes, e.key.keysym.scancode);
             break;
         }
             
         case SDL_MOUSEBUTTONDOWN: {
-            Uint8 mouse_button = e.button.button;
-            
-            // If first time being pressed, or currently up, set to down
-            if (mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-            {
-                mouse_button_states[mouse_button] = INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
-            }
-            else
-            {
-                mouse_button_states[mouse_button] = INPUT_STATE_JUST_BECAME_DOWN;
-                just_changed_mouse_buttons.push(mouse_button);
-            }
+            if (e.button.button < mouse_button_count)
+                Press(mouse_button_states, just_changed_mouse_buttons, e.button.button);
             break;
         }
             
         case SDL_MOUSEBUTTONUP: {
-            Uint8 mouse_button = e.button.button;
-            
-            // If first time being pressed, or currently up, set to down
-            if (mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-            {
-                mouse_button_states[mouse_button] = INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
-            }
-            else
-            {
-                mouse_button_states[mouse_button] = INPUT_STATE_JUST_BECAME_UP;
-                just_changed_mouse_buttons.push(mouse_button);
-            }
+            if (e.button.button < mouse_button_count)
+                Release(mouse_button_states, just_changed_mouse_buttons, e.button.button);
             break;
         }
             
@@ -230,34 +196,20 @@ void Input::ProcessInput(const SDL_Event &e)
         }
             
         case SDL_CONTROLLERBUTTONDOWN: {
-            SDL_GameControllerButton controller_button = (SDL_GameControllerButton) e.cbutton.button;
-            
-            // If first time being pressed, or currently up, set to down
-            if (controller_button_states[controller_button] == INPUT_STATE_JUST_BECAME_UP || controller_button_states[controller_button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-            {
-                controller_button_states[controller_button] = INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
-            }
-            else
-            {
-                mouse_button_states[controller_button] = INPUT_STATE_JUST_BECAME_DOWN;
-                just_changed_controller_buttons.push(controller_button);
-            }
+            if (e.cbutton.button < SDL_CONTROLLER_BUTTON_MAX)
+                Press(controller_button_states, just_changed_controller_buttons, e.cbutton.button);
             break;
         }
             
         case SDL_CONTROLLERBUTTONUP: {
-            SDL_GameControllerButton controller_button = (SDL_GameControllerButton) e.cbutton.button;
+            if (e.cbutton.button < SDL_CONTROLLER_BUTTON_MAX)
+                Release(controller_button_states, just_changed_controller_buttons, e.cbutton.button);
+            break;
+        }
             
-            // If first time being pressed, or currently up, set to down
-            if (controller_button_states[controller_button] == INPUT_STATE_JUST_BECAME_DOWN || controller_button_states[controller_button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-            {
-                controller_button_states[controller_button] = INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
-            }
-            else
-            {
-                controller_button_states[controller_button] = INPUT_STATE_JUST_BECAME_UP;
-                just_changed_controller_buttons.push(controller_button);
-            }
+        case SDL_CONTROLLERAXISMOTION: {
+            if (e.caxis.axis < SDL_CONTROLLER_AXIS_MAX)
+                controller_axis_states[e.caxis.axis] = std::max(e.caxis.value / 32767.0f, -1.0f);
             break;
         }
             
@@ -284,63 +236,47 @@ void Input::ProcessInput(const SDL_Event &e)
     }
 }
 
-bool Input::cppInputGetKey(const std::string &keycode)
+int Input::cppInputKey(const std::string &keycode)
 {
-    if(__keycode_to_scancode.count(keycode) <= 0)
-        return false;
-    
-    // If key currently is up, return false
-    if (keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_DOWN || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_DOWN || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-        return true;
+    auto scancode_it = __keycode_to_scancode.find(keycode);
     
-    return false;
+    return scancode_it != __keycode_to_scancode.end() ? scancode_it->second : SDL_SCANCODE_UNKNOWN;
 }
 
-bool Input::cppInputGetKeyDown(const std::string &keycode)
+bool Input::cppInputGetKey(const std::string &keycode)        { return IsDown(keyboard_states[cppInputKey(keycode)]); }
+
+bool Input::cppInputGetKeyDown(const std::string &keycode)    { return IsJustDown(keyboard_states[cppInputKey(keycode)]); }
+
+bool Input::cppInputGetKeyUp(const std::string &keycode)      { return IsJustUp(keyboard_states[cppInputKey(keycode)]); }
+
+bool Input::cppInputGetKeyHandle(int scancode)
 {
-    if(__keycode_to_scancode.count(keycode) <= 0)
-        return false;
-    
-    if (keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_DOWN || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
-    
-    return false;
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && IsDown(keyboard_states[scancode]);
 }
 
-bool Input::cppInputGetKeyUp(const std::string &keycode)
+bool Input::cppInputGetKeyDownHandle(int scancode)
 {
-    if(__keycode_to_scancode.count(keycode) <= 0)
-        return false;
-    
-    if (keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_UP || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || keyboard_states[__keycode_to_scancode[keycode]] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
-    
-    return false;
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && IsJustDown(keyboard_states[scancode]);
+}
+
+bool Input::cppInputGetKeyUpHandle(int scancode)
+{
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && IsJustUp(keyboard_states[scancode]);
 }
 
 bool Input::cppInputGetMouseButton(Uint8 mouse_button)
 {
-    // If key currently is up, return false
-    if (mouse_button_states[mouse_button] == INPUT_STATE_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-        return true;
-    
-    return false;
+    return mouse_button < mouse_button_count && IsDown(mouse_button_states[mouse_button]);
 }
 
 bool Input::cppInputGetMouseButtonDown(Uint8 mouse_button)
 {
-    if (mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
-    
-    return false;
+    return mouse_button < mouse_button_count && IsJustDown(mouse_button_states[mouse_button]);
 }
 
 bool Input::cppInputGetMouseButtonUp(Uint8 mouse_button)
 {
-    if (mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || mouse_button_states[mouse_button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
-    
-    return false;
+    return mouse_button < mouse_button_count && IsJustUp(mouse_button_states[mouse_button]);
 }
 
 glm::vec2 Input::cppInputGetMousePosition() { return mouse_position; }
@@ -349,74 +285,269 @@ float Input::cppInputGetMouseScrollDelta()  { return mouse_scroll_delta; }
 
 void Input::TransitionInputStates()
 {
-    while(!just_changed_scancodes.empty())
+    Transition(keyboard_states, just_changed_scancodes);
+    Transition(mouse_button_states, just_changed_mouse_buttons);
+    Transition(controller_button_states, just_changed_controller_buttons);
+    
+    mouse_scroll_delta = 0;
+}
+
+int Input::cppInputButton(const std::string &button_name)
+{
+    auto button_it = __button_name_to_sdl_button.find(button_name);
+    
+    return button_it != __button_name_to_sdl_button.end() ? button_it->second : SDL_CONTROLLER_BUTTON_INVALID;
+}
+
+bool Input::cppInputGetButton(const std::string &button_name)        { return cppInputGetButtonHandle(cppInputButton(button_name)); }
+
+bool Input::cppInputGetButtonDown(const std::string &button_name)    { return cppInputGetButtonDownHandle(cppInputButton(button_name)); }
+
+bool Input::cppInputGetButtonUp(const std::string &button_name)      { return cppInputGetButtonUpHandle(cppInputButton(button_name)); }
+
+bool Input::cppInputGetButtonHandle(int controller_button)
+{
+    return controller_button >= 0 && controller_button < SDL_CONTROLLER_BUTTON_MAX && IsDown(controller_button_states[controller_button]);
+}
+
+bool Input::cppInputGetButtonDownHandle(int controller_button)
+{
+    return controller_button >= 0 && controller_button < SDL_CONTROLLER_BUTTON_MAX && IsJustDown(controller_button_states[controller_button]);
+}
+
+bool Input::cppInputGetButtonUpHandle(int controller_button)
+{
+    return controller_button >= 0 && controller_button < SDL_CONTROLLER_BUTTON_MAX && IsJustUp(controller_button_states[controller_button]);
+}
+
+float Input::cppGetAxis(const std::string &axis_name)
+{
+    auto axis_it = __axis_name_to_sdl_axis.find(axis_name);
+    
+    return axis_it != __axis_name_to_sdl_axis.end() ? controller_axis_states[axis_it->second] : 0.0f;
+}
+
+void Input::LoadActionMap(const std::string &config_path)
+{
+    rapidjson::Document input_config_doc;
+    ReadJsonFile(config_path, input_config_doc);
+    
+    if (!input_config_doc.HasMember("actions") || !input_config_doc["actions"].IsObject())
+        ErrorExit("error: input.config has no actions");
+    
+    for (const auto &action_member : input_config_doc["actions"].GetObject())
     {
-        switch (keyboard_states[just_changed_scancodes.front()]) {
-            case INPUT_STATE_JUST_BECAME_UP: case INPUT_STATE_JUST_BECAME_DOWN_AND_UP:
-                keyboard_states[just_changed_scancodes.front()] = INPUT_STATE_UP;
-                break;
-                
-            case INPUT_STATE_JUST_BECAME_DOWN: case INPUT_STATE_JUST_BECAME_UP_AND_DOWN:
-                keyboard_states[just_changed_scancodes.front()] = INPUT_STATE_DOWN;
-                break;
-                
-            default:
-                break;
-        }
+        std::string action_name = action_member.name.GetString();
+        const rapidjson::Value &action_doc = action_member.value;
+        
+        AddAction(action_name);
+        
+        // Every binding has to name a real key, button or axis, so typos are caught at startup
+        auto bind_all = [&](const char* member, bool (*bind)(const std::string&, const std::string&)) {
+            if (!action_doc.HasMember(member) || !action_doc[member].IsArray())
+                return;
+            
+            for (const rapidjson::Value &binding : action_doc[member].GetArray())
+            {
+                if (!binding.IsString() || !bind(action_name, binding.GetString()))
+                    ErrorExit("error: action " + action_name + " has an unknown binding in " + member);
+            }
+        };
+        
+        bind_all("keys", cppInputBindKey);
+        bind_all("negative_keys", cppInputBindNegativeKey);
+        bind_all("buttons", cppInputBindButton);
+        bind_all("negative_buttons", cppInputBindNegativeButton);
         
-        just_changed_scancodes.pop();
+        float deadzone = (action_doc.HasMember("deadzone") && action_doc["deadzone"].IsNumber()) ? action_doc["deadzone"].GetFloat() : 0.2f;
+        
+        if (action_doc.HasMember("axes") && action_doc["axes"].IsArray())
+        {
+            for (const rapidjson::Value &binding : action_doc["axes"].GetArray())
+            {
+                if (!binding.IsString() || !cppInputBindAxis(action_name, binding.GetString(), deadzone))
+                    ErrorExit("error: action " + action_name + " has an unknown binding in axes");
+            }
+        }
     }
-    while(!just_changed_mouse_buttons.empty())
+}
+
+void Input::UpdateActions()
+{
+    for (size_t i = 0; i < actions.size(); ++i)
     {
-        switch (mouse_button_states[just_changed_mouse_buttons.front()]) {
-            case INPUT_STATE_JUST_BECAME_UP: case INPUT_STATE_JUST_BECAME_DOWN_AND_UP:
-                mouse_button_states[just_changed_mouse_buttons.front()] = INPUT_STATE_UP;
-                break;
-                
-            case INPUT_STATE_JUST_BECAME_DOWN: case INPUT_STATE_JUST_BECAME_UP_AND_DOWN:
-                mouse_button_states[just_changed_mouse_buttons.front()] = INPUT_STATE_DOWN;
-                break;
-                
-            default:
-                break;
+        const InputAction &action = actions[i];
+        ActionState &action_state = action_states[i];
+        
+        bool was_held = action_state.held;
+        bool positive = false;
+        bool negative = false;
+        bool tapped = false;
+        bool retapped = false;
+        
+        for (SDL_Scancode scancode : action.keys)
+        {
+            positive = positive || IsDown(keyboard_states[scancode]);
+            tapped = tapped || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+            retapped = retapped || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
         }
         
-        just_changed_mouse_buttons.pop();
+        for (SDL_Scancode scancode : action.negative_keys)
+        {
+            negative = negative || IsDown(keyboard_states[scancode]);
+            tapped = tapped || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+            retapped = retapped || keyboard_states[scancode] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
+        }
+        
+        for (SDL_GameControllerButton button : action.buttons)
+        {
+            positive = positive || IsDown(controller_button_states[button]);
+            tapped = tapped || controller_button_states[button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+            retapped = retapped || controller_button_states[button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
+        }
+        
+        for (SDL_GameControllerButton button : action.negative_buttons)
+        {
+            negative = negative || IsDown(controller_button_states[button]);
+            tapped = tapped || controller_button_states[button] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+            retapped = retapped || controller_button_states[button] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
+        }
+        
+        float value = (positive ? 1.0f : 0.0f) - (negative ? 1.0f : 0.0f);
+        
+        // The axis furthest past the deadzone wins if it beats the keys, rescaled so it still reaches 1
+        for (SDL_GameControllerAxis axis : action.axes)
+        {
+            float axis_value = controller_axis_states[axis];
+            float magnitude = std::abs(axis_value);
+            
+            if (magnitude <= action.deadzone)
+                continue;
+            
+            float scaled_value = std::copysign(std::min((magnitude - action.deadzone) / (1.0f - action.deadzone), 1.0f), axis_value);
+            
+            if (std::abs(scaled_value) > std::abs(value))
+                value = scaled_value;
+        }
+        
+        action_state.value = value;
+        action_state.held = positive || negative || value != 0.0f;
+        
+        // A press and release within one frame still reports both edges, as does a release and press
+        action_state.down = (!was_held && (action_state.held || tapped)) || retapped;
+        action_state.up = (was_held && !action_state.held) || (tapped && !action_state.held) || retapped;
     }
+}
+
+int Input::cppInputAction(const std::string &action_name)
+{
+    auto action_it = action_handles.find(action_name);
     
-    mouse_scroll_delta = 0;
+    return action_it != action_handles.end() ? action_it->second : -1;
 }
 
-bool Input::cppInputGetButton(const std::string &button_name)
+bool Input::cppInputGetAction(const std::string &action_name)          { return cppInputGetActionHandle(cppInputAction(action_name)); }
+
+bool Input::cppInputGetActionDown(const std::string &action_name)      { return cppInputGetActionDownHandle(cppInputAction(action_name)); }
+
+bool Input::cppInputGetActionUp(const std::string &action_name)        { return cppInputGetActionUpHandle(cppInputAction(action_name)); }
+
+float Input::cppInputGetActionValue(const std::string &action_name)    { return cppInputGetActionValueHandle(cppInputAction(action_name)); }
+
+bool Input::cppInputGetActionHandle(int action)
+{
+    return action >= 0 && action < static_cast<int>(action_states.size()) && action_states[action].held;
+}
+
+bool Input::cppInputGetActionDownHandle(int action)
 {
-    if(__button_name_to_sdl_button.count(button_name) <= 0)
+    return action >= 0 && action < static_cast<int>(action_states.size()) && action_states[action].down;
+}
+
+bool Input::cppInputGetActionUpHandle(int action)
+{
+    return action >= 0 && action < static_cast<int>(action_states.size()) && action_states[action].up;
+}
+
+float Input::cppInputGetActionValueHandle(int action)
+{
+    return (action >= 0 && action < static_cast<int>(action_states.size())) ? action_states[action].value : 0.0f;
+}
+
+bool Input::cppInputBindKey(const std::string &action_name, const std::string &keycode)
+{
+    auto scancode_it = __keycode_to_scancode.find(keycode);
+    
+    if (scancode_it == __keycode_to_scancode.end())
         return false;
     
-    // If key currently is up, return false
-    if (controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_DOWN || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_DOWN || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
-        return true;
+    actions[AddAction(action_name)].keys.push_back(scancode_it->second);
+    return true;
+}
+
+bool Input::cppInputBindNegativeKey(const std::string &action_name, const std::string &keycode)
+{
+    auto scancode_it = __keycode_to_scancode.find(keycode);
     
-    return false;
+    if (scancode_it == __keycode_to_scancode.end())
+        return false;
+    
+    actions[AddAction(action_name)].negative_keys.push_back(scancode_it->second);
+    return true;
 }
 
-bool Input::cppInputGetButtonDown(const std::string &button_name)
+bool Input::cppInputBindButton(const std::string &action_name, const std::string &button_name)
 {
-    if(__button_name_to_sdl_button.count(button_name) <= 0)
+    auto button_it = __button_name_to_sdl_button.find(button_name);
+    
+    if (button_it == __button_name_to_sdl_button.end())
         return false;
     
-    if (controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_DOWN || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
+    actions[AddAction(action_name)].buttons.push_back(button_it->second);
+    return true;
+}
+
+bool Input::cppInputBindNegativeButton(const std::string &action_name, const std::string &button_name)
+{
+    auto button_it = __button_name_to_sdl_button.find(button_name);
     
-    return false;
+    if (button_it == __button_name_to_sdl_button.end())
+        return false;
+    
+    actions[AddAction(action_name)].negative_buttons.push_back(button_it->second);
+    return true;
 }
 
-bool Input::cppInputGetButtonUp(const std::string &button_name)
+bool Input::cppInputBindAxis(const std::string &action_name, const std::string &axis_name, float deadzone)
 {
-    if(__button_name_to_sdl_button.count(button_name) <= 0)
+    auto axis_it = __axis_name_to_sdl_axis.find(axis_name);
+    
+    if (axis_it == __axis_name_to_sdl_axis.end())
         return false;
     
-    if (controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_UP || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || controller_button_states[__button_name_to_sdl_button[button_name]] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
-        return true;
+    InputAction &action = actions[AddAction(action_name)];
+    action.axes.push_back(axis_it->second);
+    action.deadzone = std::clamp(deadzone, 0.0f, 0.99f);
+    return true;
+}
+
+void Input::cppInputClearBindings(const std::string &action_name)
+{
+    int action = cppInputAction(action_name);
+    
+    if (action >= 0)
+        actions[action] = InputAction();
+}
+
+int Input::AddAction(const std::string &action_name)
+{
+    auto [action_it, inserted] = action_handles.try_emplace(action_name, static_cast<int>(actions.size()));
+    
+    if (inserted)
+    {
+        actions.emplace_back();
+        action_states.emplace_back();
+    }
     
-    return false;
+    return action_it->second;
 }
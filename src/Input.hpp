@@ -8,17 +8,21 @@
 #ifndef Input_hpp
 #define Input_hpp
 
+#define INPUT_CONFIG_PATH "resources/input.config"
+
 #include "glm.hpp"
 #include "SDL2/SDL.h"
 
+#include <array>
+#include <bitset>
 #include <iostream>
-#include <queue>
 #include <stdio.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
-enum INPUT_STATE { UNINIT, INPUT_STATE_UP, INPUT_STATE_JUST_BECAME_DOWN, INPUT_STATE_DOWN, INPUT_STATE_JUST_BECAME_UP, INPUT_STATE_JUST_BECAME_DOWN_AND_UP, INPUT_STATE_JUST_BECAME_UP_AND_DOWN };
+enum INPUT_STATE : uint8_t { UNINIT, INPUT_STATE_UP, INPUT_STATE_JUST_BECAME_DOWN, INPUT_STATE_DOWN, INPUT_STATE_JUST_BECAME_UP, INPUT_STATE_JUST_BECAME_DOWN_AND_UP, INPUT_STATE_JUST_BECAME_UP_AND_DOWN };
 
 
 class Input
@@ -27,39 +31,216 @@ public:
     static void Init(); // Call before main loop begins.
     static void ProcessInput(const SDL_Event & e); // Call every frame at start of event loop.
     static void TransitionInputStates();
+    
+    /**
+     *  Reads the action map from input.config, which binds each named action to keys, controller
+     *  buttons and axes:
+     *
+     *  "actions": { "move_x": { "keys": ["d"], "negative_keys": ["a"], "axes": ["LeftX"], "deadzone": 0.2 } }
+     *
+     *  "buttons" and "negative_buttons" bind controller buttons the same way.
+     */
+    static void LoadActionMap(const std::string &config_path);
+    
+    /**
+     *  Computes every action's state from the bindings. Call once per frame, after the frame's events.
+     */
+    static void UpdateActions();
+
+    /**
+     *  Resolves a key name once, so scripts can poll with the returned scancode instead of the name.
+     *  Unknown names resolve to SDL_SCANCODE_UNKNOWN, which is never down.
+     */
+    static int cppInputKey(const std::string &keycode);
 
     static bool cppInputGetKey(const std::string &keycode);
     static bool cppInputGetKeyDown(const std::string &keycode);
     static bool cppInputGetKeyUp(const std::string &keycode);
     
+    static bool cppInputGetKeyHandle(int scancode);
+    static bool cppInputGetKeyDownHandle(int scancode);
+    static bool cppInputGetKeyUpHandle(int scancode);
+    
     static bool cppInputGetMouseButton(Uint8 mouse_button);
     static bool cppInputGetMouseButtonDown(Uint8 mouse_button);
     static bool cppInputGetMouseButtonUp(Uint8 mouse_button);
     static glm::vec2 cppInputGetMousePosition();
     static float cppInputGetMouseScrollDelta();
     
+    /**
+     *  Like cppInputKey, for controller button names.
+     */
+    static int cppInputButton(const std::string &button_name);
+    
     static bool cppInputGetButton(const std::string &button_name);
     static bool cppInputGetButtonDown(const std::string &button_name);
     static bool cppInputGetButtonUp(const std::string &button_name);
     
+    static bool cppInputGetButtonHandle(int controller_button);
+    static bool cppInputGetButtonDownHandle(int controller_button);
+    static bool cppInputGetButtonUpHandle(int controller_button);
+    
     static float cppGetAxis(const std::string &axis_name);
     
+    /**
+     *  Resolves an action name to a handle for the GetAction functions, or -1 if there is no such action.
+     */
+    static int cppInputAction(const std::string &action_name);
+    
+    static bool cppInputGetAction(const std::string &action_name);
+    static bool cppInputGetActionDown(const std::string &action_name);
+    static bool cppInputGetActionUp(const std::string &action_name);
+    static float cppInputGetActionValue(const std::string &action_name);
+    
+    static bool cppInputGetActionHandle(int action);
+    static bool cppInputGetActionDownHandle(int action);
+    static bool cppInputGetActionUpHandle(int action);
+    static float cppInputGetActionValueHandle(int action);
+    
+    /**
+     *  Rebinding adds the action if it doesn't exist yet, so handles already resolved stay valid.
+     *  Each returns false if the key, button or axis name is unknown.
+     */
+    static bool cppInputBindKey(const std::string &action_name, const std::string &keycode);
+    static bool cppInputBindNegativeKey(const std::string &action_name, const std::string &keycode);
+    static bool cppInputBindButton(const std::string &action_name, const std::string &button_name);
+    static bool cppInputBindNegativeButton(const std::string &action_name, const std::string &button_name);
+    static bool cppInputBindAxis(const std::string &action_name, const std::string &axis_name, float deadzone);
+    static void cppInputClearBindings(const std::string &action_name);
+    
     static glm::vec2 cppInputGetControllerTouchpadPosition();
 
 private:
-    static inline std::unordered_map<SDL_Scancode, INPUT_STATE> keyboard_states;
-    static inline std::queue<SDL_Scancode> just_changed_scancodes;
+    static constexpr size_t mouse_button_count = 16;
+    
+    struct InputAction
+    {
+        std::vector<SDL_Scancode> keys;
+        std::vector<SDL_Scancode> negative_keys;
+        std::vector<SDL_GameControllerButton> buttons;
+        std::vector<SDL_GameControllerButton> negative_buttons;
+        std::vector<SDL_GameControllerAxis> axes;
+        float deadzone = 0.2f;
+    };
+    
+    struct ActionState
+    {
+        float value = 0.0f;
+        bool held = false;
+        bool down = false;
+        bool up = false;
+    };
+    
+    static int AddAction(const std::string &action_name);
+    
+    static bool IsDown(INPUT_STATE state);
+    static bool IsJustDown(INPUT_STATE state);
+    static bool IsJustUp(INPUT_STATE state);
+    
+    /**
+     *  Moves a state on for a press or release event, flagging it for TransitionInputStates unless it
+     *  already changed this frame.
+     */
+    template <size_t Count>
+    static void Press(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed, size_t index);
+    template <size_t Count>
+    static void Release(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed, size_t index);
+    
+    template <size_t Count>
+    static void Transition(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed);
     
-    static inline std::unordered_map<Uint8, INPUT_STATE> mouse_button_states;
-    static inline std::queue<Uint8> just_changed_mouse_buttons;
+    // Indexed by scancode, mouse button and controller button, so polling never hashes
+    static inline std::array<INPUT_STATE, SDL_NUM_SCANCODES> keyboard_states;
+    static inline std::bitset<SDL_NUM_SCANCODES> just_changed_scancodes;
+    
+    static inline std::array<INPUT_STATE, mouse_button_count> mouse_button_states;
+    static inline std::bitset<mouse_button_count> just_changed_mouse_buttons;
     static inline glm::vec2 mouse_position;
     static inline float mouse_scroll_delta;
     
-    static inline std::unordered_map<SDL_GameControllerButton, INPUT_STATE> controller_button_states;
-    static inline std::queue<Uint8> just_changed_controller_buttons;
+    static inline std::array<INPUT_STATE, SDL_CONTROLLER_BUTTON_MAX> controller_button_states;
+    static inline std::bitset<SDL_CONTROLLER_BUTTON_MAX> just_changed_controller_buttons;
     
-    static inline std::unordered_map<SDL_GameControllerAxis, float> controller_axis_states;
+    static inline std::array<float, SDL_CONTROLLER_AXIS_MAX> controller_axis_states;
     static inline glm::vec2 controller_touchpad_position;
+    
+    // Indexed by action handle
+    static inline std::vector<InputAction> actions;
+    static inline std::vector<ActionState> action_states;
+    static inline std::unordered_map<std::string, int> action_handles;
 };
 
+
+inline bool Input::IsDown(INPUT_STATE state)
+{
+    return state == INPUT_STATE_DOWN || state == INPUT_STATE_JUST_BECAME_DOWN || state == INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
+}
+
+inline bool Input::IsJustDown(INPUT_STATE state)
+{
+    return state == INPUT_STATE_JUST_BECAME_DOWN || state == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || state == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+}
+
+inline bool Input::IsJustUp(INPUT_STATE state)
+{
+    return state == INPUT_STATE_JUST_BECAME_UP || state == INPUT_STATE_JUST_BECAME_UP_AND_DOWN || state == INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+}
+
+template <size_t Count>
+inline void Input::Press(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed, size_t index)
+{
+    // If released this frame, it was tapped; otherwise set to down
+    if (states[index] == INPUT_STATE_JUST_BECAME_UP || states[index] == INPUT_STATE_JUST_BECAME_DOWN_AND_UP)
+    {
+        states[index] = INPUT_STATE_JUST_BECAME_UP_AND_DOWN;
+    }
+    else
+    {
+        states[index] = INPUT_STATE_JUST_BECAME_DOWN;
+        just_changed.set(index);
+    }
+}
+
+template <size_t Count>
+inline void Input::Release(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed, size_t index)
+{
+    if (states[index] == INPUT_STATE_JUST_BECAME_DOWN || states[index] == INPUT_STATE_JUST_BECAME_UP_AND_DOWN)
+    {
+        states[index] = INPUT_STATE_JUST_BECAME_DOWN_AND_UP;
+    }
+    else
+    {
+        states[index] = INPUT_STATE_JUST_BECAME_UP;
+        just_changed.set(index);
+    }
+}
+
+template <size_t Count>
+inline void Input::Transition(std::array<INPUT_STATE, Count> &states, std::bitset<Count> &just_changed)
+{
+    if (just_changed.none())
+        return;
+    
+    for (size_t index = 0; index < Count; ++index)
+    {
+        if (!just_changed.test(index))
+            continue;
+        
+        switch (states[index]) {
+            case INPUT_STATE_JUST_BECAME_UP: case INPUT_STATE_JUST_BECAME_DOWN_AND_UP:
+                states[index] = INPUT_STATE_UP;
+                break;
+                
+            case INPUT_STATE_JUST_BECAME_DOWN: case INPUT_STATE_JUST_BECAME_UP_AND_DOWN:
+                states[index] = INPUT_STATE_DOWN;
+                break;
+                
+            default:
+                break;
+        }
+    }
+    
+    just_changed.reset();
+}
+
 #endif /* Input_hpp */
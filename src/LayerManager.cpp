@@ -0,0 +1,186 @@
+//
+//  LayerManager.cpp
+//  blitzENGINE
+//
+
+#include "LayerManager.hpp"
+
+#include "Utilities.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+void LayerManager::PrepareLayers()
+{
+    redraw_count = 0;
+
+    for (std::unique_ptr<RenderLayer> &layer : layers)
+    {
+        bool submitted = !layer->ui_render_requests.empty() || !layer->text_render_requests.empty();
+
+        // Static layers keep their last contents until something new is drawn to them
+        if (submitted || !layer->is_static)
+        {
+            std::stable_sort(layer->ui_render_requests.begin(), layer->ui_render_requests.end(), [](const ImageDrawRequest &lhs, const ImageDrawRequest &rhs) {
+                return lhs.sorting_order < rhs.sorting_order;
+            });
+
+            uint64_t draw_list_hash = HashDrawList(layer->ui_render_requests, layer->text_render_requests);
+
+            if (draw_list_hash != layer->draw_list_hash)
+            {
+                layer->drawn_ui_requests.swap(layer->ui_render_requests);
+                layer->drawn_text_requests.swap(layer->text_render_requests);
+
+                layer->draw_list_hash = draw_list_hash;
+                layer->needs_redraw = true;
+            }
+
+            layer->ui_render_requests.clear();
+            layer->text_render_requests.clear();
+        }
+
+        if (layer->needs_redraw)
+            redraw_count++;
+    }
+}
+
+
+void LayerManager::Discard()
+{
+    for (std::unique_ptr<RenderLayer> &layer : layers)
+    {
+        layer->ui_render_requests.clear();
+        layer->text_render_requests.clear();
+    }
+}
+
+
+void LayerManager::InvalidateLayers()
+{
+    for (std::unique_ptr<RenderLayer> &layer : layers)
+        layer->needs_redraw = true;
+}
+
+
+RenderLayer& LayerManager::GetLayer(const std::string &layer_name)
+{
+    auto layer_it = layers_by_name.find(layer_name);
+
+    if (layer_it == layers_by_name.end())
+        ErrorExit("error: layer " + layer_name + " does not exist");
+
+    return *layer_it->second;
+}
+
+
+void LayerManager::cppLayerCreate(const std::string &layer_name, bool is_static)
+{
+    auto layer_it = layers_by_name.find(layer_name);
+
+    if (layer_it != layers_by_name.end())
+    {
+        layer_it->second->is_static = is_static;
+        return;
+    }
+
+    std::unique_ptr<RenderLayer> layer = std::make_unique<RenderLayer>();
+
+    layer->name = layer_name;
+    layer->is_static = is_static;
+    layer->draw_list_hash = HashDrawList({}, {});
+
+    SDL_Renderer* sdl_renderer = Renderer::GetSDLRenderer();
+
+    // Without render targets or premultiplied blending the layer is drawn straight to the frame instead
+    if (SDL_RenderTargetSupported(sdl_renderer))
+    {
+        layer->texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                           Renderer::GetCameraDimensionsX(), Renderer::GetCameraDimensionsY());
+
+        // Blending into a cleared target leaves its colors premultiplied by alpha
+        SDL_BlendMode premultiplied_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                                            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+        if (layer->texture && SDL_SetTextureBlendMode(layer->texture, premultiplied_blend_mode) != 0)
+        {
+            SDL_DestroyTexture(layer->texture);
+            layer->texture = nullptr;
+        }
+    }
+
+    layers_by_name.emplace(layer_name, layer.get());
+    layers.push_back(std::move(layer));
+}
+
+
+void LayerManager::cppLayerSetOrder(const std::string &layer_name, int order)
+{
+    GetLayer(layer_name).order = order;
+
+    std::stable_sort(layers.begin(), layers.end(), [](const std::unique_ptr<RenderLayer> &lhs, const std::unique_ptr<RenderLayer> &rhs) {
+        return lhs->order < rhs->order;
+    });
+}
+
+
+void LayerManager::cppLayerClear(const std::string &layer_name)
+{
+    RenderLayer &layer = GetLayer(layer_name);
+
+    layer.ui_render_requests.clear();
+    layer.text_render_requests.clear();
+    layer.drawn_ui_requests.clear();
+    layer.drawn_text_requests.clear();
+
+    layer.draw_list_hash = HashDrawList({}, {});
+    layer.needs_redraw = true;
+}
+
+
+uint64_t LayerManager::HashDrawList(const std::vector<ImageDrawRequest> &ui_requests, const std::vector<TextDrawRequest> &text_requests)
+{
+    // FNV-1a over every field that changes what ends up in the texture
+    uint64_t hash = 14695981039346656037ull;
+
+    auto hash_value = [&hash](const auto &value) {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+
+        for (unsigned char byte : bytes)
+        {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (const ImageDrawRequest &ui_request : ui_requests)
+    {
+        hash_value(ui_request.image.get());
+        hash_value(ui_request.x);
+        hash_value(ui_request.y);
+        hash_value(ui_request.scale_x);
+        hash_value(ui_request.scale_y);
+        hash_value(ui_request.pivot_x);
+        hash_value(ui_request.pivot_y);
+        hash_value(ui_request.rotation_degrees);
+        hash_value(ui_request.sorting_order);
+        hash_value(ui_request.r);
+        hash_value(ui_request.g);
+        hash_value(ui_request.b);
+        hash_value(ui_request.a);
+    }
+
+    // Separates the two lists, so moving a request from one to the other changes the hash
+    hash_value(ui_requests.size());
+
+    for (const TextDrawRequest &text_request : text_requests)
+    {
+        hash_value(text_request.image.get());
+        hash_value(text_request.x);
+        hash_value(text_request.y);
+    }
+
+    return hash;
+}
@@ -0,0 +1,109 @@
+//
+//  LayerManager.hpp
+//  blitzENGINE
+//
+
+#ifndef LayerManager_hpp
+#define LayerManager_hpp
+
+#include "Renderer.hpp"
+#include "SDL2/SDL.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ *  A named screen-space layer whose UI images and text are rendered into its own texture.
+ *
+ *  The texture is only redrawn when the layer's draw list changes, so an unchanged layer
+ *  costs a single copy. A dynamic layer expects its contents every frame and is empty on
+ *  frames nothing is drawn to it. A static layer keeps what it was last given until it is
+ *  drawn to again or cleared, so scripts only need to submit it when something changes.
+ */
+struct RenderLayer
+{
+    std::string name;
+
+    SDL_Texture* texture = nullptr;
+
+    std::vector<ImageDrawRequest> ui_render_requests;
+    std::vector<TextDrawRequest> text_render_requests;
+
+    std::vector<ImageDrawRequest> drawn_ui_requests;
+    std::vector<TextDrawRequest> drawn_text_requests;
+
+    uint64_t draw_list_hash = 0;
+
+    int order = 0;
+
+    bool is_static = false;
+    bool needs_redraw = true;
+};
+
+class LayerManager {
+public:
+
+    /**
+     *  Moves each layer's draw requests for this frame into the list it draws from, and
+     *  flags layers whose list differs from what their texture already holds.
+     */
+    static void PrepareLayers();
+
+    /**
+     *  Drops the draw requests submitted to layers this frame.
+     */
+    static void Discard();
+
+    /**
+     *  Forces every layer to redraw, for when the renderer drops its render targets.
+     */
+    static void InvalidateLayers();
+
+
+    static RenderLayer& GetLayer(const std::string &layer_name);
+
+
+    static const std::vector<std::unique_ptr<RenderLayer>>& GetLayers();
+
+
+    static size_t GetRedrawCount();
+
+    /**
+     *  Creates a layer, or changes whether an existing one is static.
+     */
+    static void cppLayerCreate(const std::string &layer_name, bool is_static);
+
+    /**
+     *  Layers with a negative order are composited beneath the scene, the rest above the UI,
+     *  lowest first. Layers with the same order keep their creation order.
+     */
+    static void cppLayerSetOrder(const std::string &layer_name, int order);
+
+
+    static void cppLayerClear(const std::string &layer_name);
+
+private:
+
+
+    static uint64_t HashDrawList(const std::vector<ImageDrawRequest> &ui_requests, const std::vector<TextDrawRequest> &text_requests);
+
+
+    static inline std::vector<std::unique_ptr<RenderLayer>> layers;
+
+
+    static inline std::unordered_map<std::string, RenderLayer*> layers_by_name;
+
+
+    static inline size_t redraw_count = 0;
+};
+
+
+inline const std::vector<std::unique_ptr<RenderLayer>>& LayerManager::GetLayers()   { return layers; }
+
+
+inline size_t LayerManager::GetRedrawCount()                                        { return redraw_count; }
+
+#endif /* LayerManager_hpp */
@@ -0,0 +1,179 @@
+//
+//  LuaProfiler.cpp
+//  blitzENGINE
+//
+
+#include "LuaProfiler.hpp"
+
+#include "ComponentManager.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+
+void LuaProfiler::Start(lua_State *L, uint32_t sample_interval_microseconds)
+{
+    Stop();
+
+    stack_samples.clear();
+    total_samples = 0;
+
+    sample_interval = std::chrono::microseconds(std::max(sample_interval_microseconds, 1u));
+    next_sample_time = std::chrono::steady_clock::now() + sample_interval;
+    profiled_state = L;
+
+    lua_sethook(L, Hook, LUA_MASKCOUNT, hook_instruction_count);
+}
+
+
+void LuaProfiler::Stop()
+{
+    if (!profiled_state)
+        return;
+
+    lua_sethook(profiled_state, nullptr, 0, 0);
+    profiled_state = nullptr;
+}
+
+
+bool LuaProfiler::WriteFoldedStacks(const std::string &path)
+{
+    std::ofstream folded_stream(path, std::ios::out | std::ios::trunc);
+
+    if (!folded_stream.is_open())
+        return false;
+
+    for (auto &[stack, samples] : stack_samples)
+        folded_stream << stack << ' ' << samples << '\n';
+
+    return true;
+}
+
+
+void LuaProfiler::cppDebugLuaProfile(bool enabled, sol::optional<uint32_t> sample_interval_microseconds)
+{
+    if (enabled)
+        Start(ComponentManager::GetLuaState()->lua_state(), sample_interval_microseconds.value_or(default_sample_interval));
+    else
+        Stop();
+}
+
+
+bool LuaProfiler::cppDebugSaveLuaProfile(sol::optional<std::string> path)
+{
+    return WriteFoldedStacks(path.value_or("lua_profile.folded"));
+}
+
+
+sol::table LuaProfiler::cppDebugLuaProfileReport(sol::optional<uint32_t> max_entries)
+{
+    std::vector<std::pair<const std::string*, uint64_t>> hottest_stacks;
+    hottest_stacks.reserve(stack_samples.size());
+
+    for (auto &[stack, samples] : stack_samples)
+        hottest_stacks.emplace_back(&stack, samples);
+
+    std::sort(hottest_stacks.begin(), hottest_stacks.end(), [](const auto &lhs, const auto &rhs) { return lhs.second > rhs.second; });
+
+    size_t entry_count = std::min<size_t>(hottest_stacks.size(), max_entries.value_or(10));
+
+    sol::state* L = ComponentManager::GetLuaState();
+    sol::table report = L->create_table(static_cast<int>(entry_count), 0);
+
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        report[i + 1] = L->create_table_with(
+            "stack", *hottest_stacks[i].first,
+            "samples", hottest_stacks[i].second,
+            "percent", 100.0 * hottest_stacks[i].second / std::max<uint64_t>(total_samples, 1));
+    }
+
+    return report;
+}
+
+
+void LuaProfiler::Hook(lua_State *L, lua_Debug *)
+{
+    // Threads created while profiling inherit the hook, and Stop only clears the main one
+    if (!profiled_state)
+    {
+        lua_sethook(L, nullptr, 0, 0);
+        return;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (now < next_sample_time)
+        return;
+
+    next_sample_time = now + sample_interval;
+    TakeSample(L);
+}
+
+
+void LuaProfiler::TakeSample(lua_State *L)
+{
+    lua_Debug frames[max_stack_depth];
+    int depth = 0;
+
+    while (depth < max_stack_depth && lua_getstack(L, depth, &frames[depth]))
+    {
+        lua_getinfo(L, "Snl", &frames[depth]);
+        depth++;
+    }
+
+    if (depth == 0)
+        return;
+
+    // Folded stacks list the outermost frame first
+    std::string stack;
+
+    for (int level = depth - 1; level >= 0; --level)
+    {
+        const lua_Debug &frame = frames[level];
+
+        if (!stack.empty())
+            stack += ';';
+
+        stack += frame.what[0] == 'C' ? "[C]" : GetScriptName(frame.source);
+        stack += '.';
+
+        // Callbacks the engine invokes directly have no name, so fall back to where they were defined
+        if (frame.name)
+            stack += frame.name;
+        else if (frame.what[0] == 'm')
+            stack += "main";
+        else
+            stack += "function@" + std::to_string(frame.linedefined);
+
+        if (level == 0 && frame.currentline > 0)
+        {
+            stack += ':';
+            stack += std::to_string(frame.currentline);
+        }
+    }
+
+    stack_samples[stack]++;
+    total_samples++;
+}
+
+
+const std::string& LuaProfiler::GetScriptName(const char *source)
+{
+    auto script_name_it = script_names.find(source);
+
+    if (script_name_it != script_names.end())
+        return script_name_it->second;
+
+    std::string script_name = source[0] == '@' ? source + 1 : "[string]";
+
+    size_t last_slash = script_name.find_last_of("/\\");
+    if (last_slash != std::string::npos)
+        script_name.erase(0, last_slash + 1);
+
+    if (script_name.size() > 4 && script_name.compare(script_name.size() - 4, 4, ".lua") == 0)
+        script_name.erase(script_name.size() - 4);
+
+    return script_names.emplace(source, script_name).first->second;
+}
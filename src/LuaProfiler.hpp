@@ -0,0 +1,97 @@
+//
+//  LuaProfiler.hpp
+//  blitzENGINE
+//
+
+#ifndef LuaProfiler_hpp
+#define LuaProfiler_hpp
+
+#include "lua.hpp"
+#include "sol/sol.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ *  Samples the Lua call stack on a timer and counts identical stacks.
+ *
+ *  A count hook runs every few hundred VM instructions and takes a sample only once the
+ *  sample interval has passed, so the cost is one clock read per hook rather than a stack
+ *  walk. Frames are named "<ComponentType>.<function>", with the line being run appended
+ *  to the innermost one, so samples from every instance of a component add up together.
+ *
+ *  Reports are written in the folded stack format flamegraph.pl and speedscope read.
+ */
+class LuaProfiler {
+public:
+
+
+    static void Start(lua_State *L, uint32_t sample_interval_microseconds = default_sample_interval);
+
+
+    static void Stop();
+
+
+    static bool IsRunning();
+
+
+    static bool WriteFoldedStacks(const std::string &path);
+
+
+    static void cppDebugLuaProfile(bool enabled, sol::optional<uint32_t> sample_interval_microseconds);
+
+
+    static bool cppDebugSaveLuaProfile(sol::optional<std::string> path);
+
+    /**
+     *  @returns    an array of { stack = ..., samples = ... } tables for the hottest stacks, hottest first
+     */
+    static sol::table cppDebugLuaProfileReport(sol::optional<uint32_t> max_entries);
+
+private:
+
+
+    static void Hook(lua_State *L, lua_Debug *ar);
+
+
+    static void TakeSample(lua_State *L);
+
+    /**
+     *  Maps a chunk name like "@resources/component_types/Player.lua" to "Player".
+     */
+    static const std::string& GetScriptName(const char *source);
+
+
+    static inline std::unordered_map<std::string, uint64_t> stack_samples;
+
+
+    static inline std::unordered_map<std::string, std::string> script_names;
+
+
+    static inline std::chrono::steady_clock::time_point next_sample_time;
+
+
+    static inline std::chrono::microseconds sample_interval;
+
+
+    static inline lua_State* profiled_state = nullptr;
+
+
+    static inline uint64_t total_samples = 0;
+
+
+    static inline const uint32_t default_sample_interval = 1000;
+
+
+    static inline const int hook_instruction_count = 500;
+
+
+    static inline const int max_stack_depth = 32;
+};
+
+
+inline bool LuaProfiler::IsRunning()    { return profiled_state != nullptr; }
+
+#endif /* LuaProfiler_hpp */
@@ -0,0 +1,715 @@
+//
+//  NativeTween.cpp
+//  blitzENGINE
+//
+
+#include "NativeTween.hpp"
+
+#include "Utilities.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+uint32_t TweenBatch::Add(uint32_t id, TweenTargetType target_type, void* target_x, void* target_y, float start_x, float start_y, float end_x, float end_y, float duration)
+{
+    uint32_t slot = static_cast<uint32_t>(Size());
+
+    ids.push_back(id);
+    TweenBatch::target_type.push_back(target_type);
+    TweenBatch::target_x.push_back(target_x);
+    TweenBatch::target_y.push_back(target_y);
+
+    TweenBatch::start_x.push_back(start_x);
+    TweenBatch::start_y.push_back(start_y);
+    TweenBatch::end_x.push_back(end_x);
+    TweenBatch::end_y.push_back(end_y);
+    value_x.push_back(start_x);
+    value_y.push_back(start_y);
+
+    elapsed_time.push_back(0.0f);
+    evaluated_duration.push_back(duration);
+    TweenBatch::duration.push_back(duration);
+    timescale.push_back(1.0f);
+    overshoot.push_back(EaseManager::default_overshoot_or_amplitude);
+    eased_progress.push_back(0.0f);
+
+    // Same defaults as ITween
+    ease_function.push_back(EaseManager::GetEaseFunction(EaseType::OutQuad));
+    loop_type.push_back(LoopType::Restart);
+    axis_constraint.push_back(AxisConstraint::None);
+    loops.push_back(1);
+    loops_completed.push_back(0);
+
+    snapping.push_back(0);
+    playing.push_back(1);
+    killed.push_back(0);
+    completed.push_back(0);
+
+    return slot;
+}
+
+
+uint32_t TweenBatch::AddFrom(const TweenBatch &other, uint32_t other_slot)
+{
+    uint32_t slot = static_cast<uint32_t>(Size());
+
+    ForEachField([other_slot](auto &field, const auto &other_field) { field.push_back(other_field[other_slot]); }, *this, other);
+
+    return slot;
+}
+
+
+uint32_t TweenBatch::Remove(uint32_t slot)
+{
+    bool last_slot = slot + 1 == Size();
+
+    ForEachField([slot](auto &field) {
+        field[slot] = field.back();
+        field.pop_back();
+    }, *this);
+
+    return last_slot ? no_tween : ids[slot];
+}
+
+
+void TweenBatch::Update(float delta_time, std::vector<DeferredTweenWrite> &deferred_writes, std::vector<uint32_t> &finished_slots)
+{
+    uint32_t tween_count = static_cast<uint32_t>(Size());
+
+    float* __restrict elapsed = elapsed_time.data();
+    const uint8_t* __restrict tween_playing = playing.data();
+
+    for (uint32_t i = 0; i < tween_count; ++i)
+        elapsed[i] += tween_playing[i] ? delta_time : 0.0f;
+
+    for (uint32_t i = 0; i < tween_count; ++i)
+    {
+        if (killed[i])
+        {
+            finished_slots.push_back(i);
+            continue;
+        }
+
+        if (!playing[i])
+            continue;
+
+        if (elapsed[i] >= evaluated_duration[i] && WrapLoop(i))
+        {
+            completed[i] = 1;
+            eased_progress[i] = 1.0f;
+            finished_slots.push_back(i);
+            continue;
+        }
+
+        eased_progress[i] = ease_function[i](elapsed[i], evaluated_duration[i], overshoot[i]);
+    }
+
+    const float* __restrict from_x = start_x.data();
+    const float* __restrict from_y = start_y.data();
+    const float* __restrict to_x = end_x.data();
+    const float* __restrict to_y = end_y.data();
+    const float* __restrict progress = eased_progress.data();
+    float* __restrict current_x = value_x.data();
+    float* __restrict current_y = value_y.data();
+
+    for (uint32_t i = 0; i < tween_count; ++i)
+    {
+        current_x[i] = from_x[i] + (to_x[i] - from_x[i]) * progress[i];
+        current_y[i] = from_y[i] + (to_y[i] - from_y[i]) * progress[i];
+    }
+
+    for (uint32_t i = 0; i < tween_count; ++i)
+    {
+        if (!playing[i] || killed[i])
+            continue;
+
+        float x = current_x[i];
+        float y = current_y[i];
+
+        // A completed tween lands exactly on its end value, like ITween does
+        if (completed[i])
+        {
+            x = to_x[i];
+            y = to_y[i];
+        }
+        else
+        {
+            if (snapping[i])
+            {
+                x = std::round(x);
+                y = std::round(y);
+            }
+
+            if (axis_constraint[i] == AxisConstraint::X)
+                y = from_y[i];
+            else if (axis_constraint[i] == AxisConstraint::Y)
+                x = from_x[i];
+        }
+
+        switch (target_type[i])
+        {
+            case TweenTargetType::Float:
+                *static_cast<float*>(target_x[i]) = x;
+                break;
+
+            case TweenTargetType::Vec2:
+                *static_cast<float*>(target_x[i]) = x;
+                *static_cast<float*>(target_y[i]) = y;
+                break;
+
+            case TweenTargetType::Uint32:
+                *static_cast<uint32_t*>(target_x[i]) = static_cast<uint32_t>(std::max(x, 0.0f));
+                break;
+
+            case TweenTargetType::Rigidbody:
+            case TweenTargetType::LuaField:
+                deferred_writes.push_back({target_type[i], target_x[i], x, y});
+                break;
+        }
+    }
+}
+
+
+bool TweenBatch::WrapLoop(uint32_t slot)
+{
+    if (evaluated_duration[slot] <= 0.0f)
+        return true;
+
+    loops_completed[slot] += static_cast<int32_t>(elapsed_time[slot] / evaluated_duration[slot]);
+
+    if (loops[slot] >= 0 && loops_completed[slot] >= loops[slot])
+        return true;
+
+    elapsed_time[slot] = 0.0f;
+
+    float previous_end_x = end_x[slot];
+    float previous_end_y = end_y[slot];
+
+    switch (loop_type[slot])
+    {
+        case LoopType::Yoyo:
+            end_x[slot] = start_x[slot];
+            end_y[slot] = start_y[slot];
+            start_x[slot] = previous_end_x;
+            start_y[slot] = previous_end_y;
+            break;
+
+        case LoopType::Incremental:
+            end_x[slot] += previous_end_x - start_x[slot];
+            end_y[slot] += previous_end_y - start_y[slot];
+            start_x[slot] = previous_end_x;
+            start_y[slot] = previous_end_y;
+            break;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+
+template <typename Function>
+void NativeTweenManager::ForEachLinked(const NativeTween &tween, Function function)
+{
+    uint32_t slot;
+    TweenBatch* batch = FindTween(tween, slot);
+
+    if (!batch)
+        return;
+
+    function(*batch, slot);
+
+    auto linked_it = linked_tweens.find(tween.id);
+
+    if (linked_it == linked_tweens.end())
+        return;
+
+    for (const NativeTween &follower : linked_it->second)
+    {
+        if ((batch = FindTween(follower, slot)))
+            function(*batch, slot);
+    }
+}
+
+
+NativeTween NativeTween::Play()
+{
+    NativeTweenManager::ForEachLinked(*this, [](TweenBatch &batch, uint32_t slot) { batch.playing[slot] = 1; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::Pause()
+{
+    NativeTweenManager::ForEachLinked(*this, [](TweenBatch &batch, uint32_t slot) { batch.playing[slot] = 0; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::Rewind()
+{
+    NativeTweenManager::ForEachLinked(*this, [](TweenBatch &batch, uint32_t slot) { batch.elapsed_time[slot] = 0.0f; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::Stop()
+{
+    uint32_t slot;
+
+    // A stale handle's id may belong to a newer tween, whose callback isn't this handle's to drop
+    if (NativeTweenManager::FindTween(*this, slot))
+        NativeTweenManager::kill_callbacks.erase(id);
+
+    return Kill();
+}
+
+
+NativeTween NativeTween::Kill()
+{
+    NativeTweenManager::ForEachLinked(*this, [](TweenBatch &batch, uint32_t slot) { batch.killed[slot] = 1; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::OnKill(sol::protected_function kill_func, sol::optional<sol::table> kill_table)
+{
+    uint32_t slot;
+
+    if (!NativeTweenManager::FindTween(*this, slot))
+        return *this;
+
+    if (kill_table.has_value())
+        NativeTweenManager::kill_callbacks[id] = [kill_func = sol::main_protected_function(kill_func), kill_table = sol::main_table(kill_table.value())]() { kill_func(kill_table); };
+    else
+        NativeTweenManager::kill_callbacks[id] = [kill_func = sol::main_protected_function(kill_func)]() { kill_func(); };
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetOvershootOrAmplitude(float overshootOrAmplitude)
+{
+    NativeTweenManager::ForEachLinked(*this, [overshootOrAmplitude](TweenBatch &batch, uint32_t slot) { batch.overshoot[slot] = overshootOrAmplitude; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetTimescale(float timescale)
+{
+    NativeTweenManager::ForEachLinked(*this, [timescale](TweenBatch &batch, uint32_t slot) {
+        batch.timescale[slot] = timescale;
+        batch.evaluated_duration[slot] = batch.duration[slot] / timescale;
+    });
+
+    return *this;
+}
+
+
+float NativeTween::GetTimescale() const
+{
+    uint32_t slot;
+    TweenBatch* batch = NativeTweenManager::FindTween(*this, slot);
+
+    return batch ? batch->timescale[slot] : 1.0f;
+}
+
+
+NativeTween NativeTween::SetLoops(int32_t loops, LoopType loop_type)
+{
+    NativeTweenManager::ForEachLinked(*this, [loops, loop_type](TweenBatch &batch, uint32_t slot) {
+        batch.loops[slot] = loops;
+        batch.loop_type[slot] = loop_type;
+    });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetEase(EaseType ease_type)
+{
+    EaseFunction ease_function = EaseManager::GetEaseFunction(ease_type);
+    NativeTweenManager::ForEachLinked(*this, [ease_function](TweenBatch &batch, uint32_t slot) { batch.ease_function[slot] = ease_function; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetUpdate(UpdateType update_type)
+{
+    // Collected first, since moving a tween shifts the slots ForEachLinked hands out
+    std::vector<uint32_t> ids;
+
+    NativeTweenManager::ForEachLinked(*this, [&ids](TweenBatch &batch, uint32_t slot) { ids.push_back(batch.ids[slot]); });
+
+    for (uint32_t tween_id : ids)
+        NativeTweenManager::MoveTween(tween_id, update_type);
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetAxisConstraint(AxisConstraint axis_constraint)
+{
+    NativeTweenManager::ForEachLinked(*this, [axis_constraint](TweenBatch &batch, uint32_t slot) { batch.axis_constraint[slot] = axis_constraint; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetSnapping(bool snapping)
+{
+    NativeTweenManager::ForEachLinked(*this, [snapping](TweenBatch &batch, uint32_t slot) { batch.snapping[slot] = snapping; });
+
+    return *this;
+}
+
+
+NativeTween NativeTween::SetProgress(float progress)
+{
+    NativeTweenManager::ForEachLinked(*this, [progress](TweenBatch &batch, uint32_t slot) {
+        batch.elapsed_time[slot] = std::clamp(progress, 0.0f, 1.0f) * batch.evaluated_duration[slot];
+    });
+
+    return *this;
+}
+
+
+float NativeTween::GetProgress() const
+{
+    uint32_t slot;
+    TweenBatch* batch = NativeTweenManager::FindTween(*this, slot);
+
+    if (!batch || batch->evaluated_duration[slot] <= 0.0f)
+        return 0.0f;
+
+    return batch->elapsed_time[slot] / batch->evaluated_duration[slot];
+}
+
+
+bool NativeTween::IsPlaying() const
+{
+    uint32_t slot;
+    TweenBatch* batch = NativeTweenManager::FindTween(*this, slot);
+
+    return batch && batch->playing[slot] && !batch->killed[slot];
+}
+
+
+bool NativeTween::IsAlive() const
+{
+    uint32_t slot;
+    TweenBatch* batch = NativeTweenManager::FindTween(*this, slot);
+
+    return batch && !batch->killed[slot];
+}
+
+
+NativeTween NativeTweenManager::CreateFloat(float* target, float start, float end, float duration)
+{
+    return Create(TweenTargetType::Float, target, nullptr, start, 0.0f, end, 0.0f, duration);
+}
+
+
+NativeTween NativeTweenManager::CreateVec2(float* target_x, float* target_y, float start_x, float start_y, float end_x, float end_y, float duration)
+{
+    return Create(TweenTargetType::Vec2, target_x, target_y, start_x, start_y, end_x, end_y, duration);
+}
+
+
+NativeTween NativeTweenManager::CreateUint32(uint32_t* target, float start, float end, float duration)
+{
+    return Create(TweenTargetType::Uint32, target, nullptr, start, 0.0f, end, 0.0f, duration);
+}
+
+
+NativeTween NativeTweenManager::CreateDeferred(TweenTargetType target_type, void* target, float start_x, float start_y, float end_x, float end_y, float duration)
+{
+    return Create(target_type, target, nullptr, start_x, start_y, end_x, end_y, duration);
+}
+
+
+NativeTween NativeTweenManager::CreateLuaField(const sol::table &table, const sol::object &key, float end, float duration)
+{
+    lua_State* lua_state = table.lua_state();
+
+    if (!key.valid() || key.get_type() == sol::type::lua_nil)
+        return NativeTween();
+
+    table.push(lua_state);
+    key.push(lua_state);
+    lua_rawget(lua_state, -2);
+
+    bool is_number = lua_type(lua_state, -1) == LUA_TNUMBER;
+    float start = static_cast<float>(lua_tonumber(lua_state, -1));
+
+    lua_pop(lua_state, 2);
+
+    if (!is_number)
+        return NativeTween();
+
+    LuaFieldTarget* target;
+
+    if (!free_lua_field_targets.empty())
+    {
+        target = free_lua_field_targets.back();
+        free_lua_field_targets.pop_back();
+    }
+    else
+        target = &lua_field_targets.emplace_back();
+
+    // The registry is shared, so the main thread can write the field after a coroutine's thread is gone
+    target->lua_state = sol::main_thread(lua_state, lua_state);
+
+    table.push(lua_state);
+    target->table_ref = luaL_ref(lua_state, LUA_REGISTRYINDEX);
+
+    key.push(lua_state);
+    target->key_ref = luaL_ref(lua_state, LUA_REGISTRYINDEX);
+
+    return Create(TweenTargetType::LuaField, target, nullptr, start, 0.0f, end, 0.0f, duration);
+}
+
+
+bool NativeTweenManager::AddFinishCallback(const NativeTween &tween, std::function<void()> callback)
+{
+    uint32_t slot;
+
+    if (!FindTween(tween, slot))
+        return false;
+
+    finish_callbacks[tween.id].push_back(std::move(callback));
+    return true;
+}
+
+
+void NativeTweenManager::Link(const NativeTween &leader, const NativeTween &follower)
+{
+    uint32_t slot;
+
+    if (FindTween(leader, slot) && FindTween(follower, slot))
+        linked_tweens[leader.id].push_back(follower);
+}
+
+
+NativeTween NativeTweenManager::cppGOTweenField(sol::table tween_table, sol::object key, float end, float duration)
+{
+    NativeTween new_tween = CreateLuaField(tween_table, key, end, duration);
+
+    if (!new_tween.IsAlive())
+    {
+        lua_State* lua_state = tween_table.lua_state();
+
+        // Prefixed with the calling script's file and line, like a Lua error would be
+        luaL_where(lua_state, 1);
+        std::string message = lua_tostring(lua_state, -1);
+
+        key.push(lua_state);
+        message += "GOTween.Field target " + std::string(luaL_tolstring(lua_state, -1, nullptr)) + " is not a number";
+        lua_pop(lua_state, 3);
+
+        ReportError("GOTween", sol::error(sol::detail::direct_error, message));
+    }
+
+    return new_tween;
+}
+
+
+NativeTween NativeTweenManager::cppGOTweenFields(sol::table tween_table, sol::table ends, float duration)
+{
+    NativeTween leader;
+
+    for (const auto &[key, end] : ends)
+    {
+        if (end.get_type() != sol::type::number)
+            continue;
+
+        NativeTween new_tween = cppGOTweenField(tween_table, key, end.as<float>(), duration);
+
+        if (!leader.IsAlive())
+            leader = new_tween;
+        else
+            Link(leader, new_tween);
+    }
+
+    return leader;
+}
+
+
+void NativeTweenManager::Update(UpdateType update_type, float delta_time)
+{
+    TweenBatch &batch = GetBatch(update_type);
+
+    finished_slots.clear();
+    batch.Update(delta_time, deferred_writes, finished_slots);
+
+    // Removes from the back, so the tween swapped into a freed slot is never one still waiting to be removed
+    for (auto slot_it = finished_slots.rbegin(); slot_it != finished_slots.rend(); ++slot_it)
+    {
+        uint32_t slot = *slot_it;
+        uint32_t id = batch.ids[slot];
+
+        auto kill_callback_it = kill_callbacks.find(id);
+
+        if (kill_callback_it != kill_callbacks.end())
+        {
+            if (batch.completed[slot])
+                pending_kill_callbacks.push_back(std::move(kill_callback_it->second));
+
+            kill_callbacks.erase(kill_callback_it);
+        }
+
+        // Freed in FinishUpdate, once the tween's last write has been applied
+        if (batch.target_type[slot] == TweenTargetType::LuaField)
+            released_lua_field_targets.push_back(static_cast<LuaFieldTarget*>(batch.target_x[slot]));
+
+        ReleaseTween(id);
+
+        uint32_t moved_id = batch.Remove(slot);
+
+        if (moved_id != TweenBatch::no_tween)
+            records[moved_id].slot = slot;
+    }
+
+    // Collected back to front above, so this restores completion order
+    std::reverse(pending_kill_callbacks.begin(), pending_kill_callbacks.end());
+}
+
+
+void NativeTweenManager::FinishUpdate()
+{
+    for (LuaFieldTarget* target : released_lua_field_targets)
+    {
+        luaL_unref(target->lua_state, LUA_REGISTRYINDEX, target->table_ref);
+        luaL_unref(target->lua_state, LUA_REGISTRYINDEX, target->key_ref);
+
+        *target = LuaFieldTarget();
+        free_lua_field_targets.push_back(target);
+    }
+
+    released_lua_field_targets.clear();
+
+    // Swapped out first, since callbacks are free to create or kill tweens
+    std::vector<std::function<void()>> kill_callbacks_to_run;
+    kill_callbacks_to_run.swap(pending_kill_callbacks);
+
+    for (std::function<void()> &kill_callback : kill_callbacks_to_run)
+        kill_callback();
+}
+
+
+void NativeTweenManager::KillTarget(const void* target)
+{
+    for (TweenBatch &batch : batches)
+    {
+        for (size_t i = 0; i < batch.Size(); ++i)
+        {
+            if (batch.target_x[i] == target || batch.target_y[i] == target)
+                batch.killed[i] = 1;
+        }
+    }
+}
+
+
+size_t NativeTweenManager::GetTweenCount()
+{
+    size_t tween_count = 0;
+
+    for (const TweenBatch &batch : batches)
+        tween_count += batch.Size();
+
+    return tween_count;
+}
+
+
+NativeTween NativeTweenManager::Create(TweenTargetType target_type, void* target_x, void* target_y, float start_x, float start_y, float end_x, float end_y, float duration)
+{
+    uint32_t id;
+
+    if (!free_ids.empty())
+    {
+        id = free_ids.back();
+        free_ids.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+
+    TweenRecord &record = records[id];
+
+    record.alive = true;
+    record.update_type = UpdateType::Normal;
+    record.slot = GetBatch(UpdateType::Normal).Add(id, target_type, target_x, target_y, start_x, start_y, end_x, end_y, duration);
+
+    return NativeTween(id, record.generation);
+}
+
+
+TweenBatch* NativeTweenManager::FindTween(const NativeTween &tween, uint32_t &slot)
+{
+    if (tween.id >= records.size())
+        return nullptr;
+
+    const TweenRecord &record = records[tween.id];
+
+    if (!record.alive || record.generation != tween.generation)
+        return nullptr;
+
+    slot = record.slot;
+
+    return &GetBatch(record.update_type);
+}
+
+
+void NativeTweenManager::MoveTween(uint32_t id, UpdateType update_type)
+{
+    TweenRecord &record = records[id];
+
+    if (record.update_type == update_type)
+        return;
+
+    TweenBatch &from_batch = GetBatch(record.update_type);
+    TweenBatch &to_batch = GetBatch(update_type);
+
+    uint32_t new_slot = to_batch.AddFrom(from_batch, record.slot);
+    uint32_t moved_id = from_batch.Remove(record.slot);
+
+    if (moved_id != TweenBatch::no_tween)
+        records[moved_id].slot = record.slot;
+
+    record.slot = new_slot;
+    record.update_type = update_type;
+}
+
+
+void NativeTweenManager::ReleaseTween(uint32_t id)
+{
+    TweenRecord &record = records[id];
+
+    record.alive = false;
+    record.generation++;
+
+    linked_tweens.erase(id);
+
+    free_ids.push_back(id);
+
+    auto finish_callbacks_it = finish_callbacks.find(id);
+
+    if (finish_callbacks_it != finish_callbacks.end())
+    {
+        std::vector<std::function<void()>> callbacks_to_run = std::move(finish_callbacks_it->second);
+        finish_callbacks.erase(finish_callbacks_it);
+
+        for (std::function<void()> &callback : callbacks_to_run)
+            callback();
+    }
+}
@@ -0,0 +1,435 @@
+//
+//  NativeTween.hpp
+//  blitzENGINE
+//
+
+#ifndef NativeTween_hpp
+#define NativeTween_hpp
+
+#include "EaseManager.hpp"
+#include "Tween.hpp"
+#include "sol/sol.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ *  How a native tween writes its value each update.
+ *
+ *  Float, Vec2 and Uint32 targets are stored to directly through their pointers. The rest
+ *  need more than a store, like moving a body or setting a Lua field, so their values are
+ *  handed back as DeferredTweenWrites for the owner to apply after the update.
+ */
+enum class TweenTargetType : uint8_t
+{
+    Float,
+    Vec2,
+    Uint32,
+    Rigidbody,
+    LuaField
+};
+
+struct DeferredTweenWrite
+{
+    TweenTargetType target_type;
+    void* target;
+    float x;
+    float y;
+};
+
+/**
+ *  A field of a Lua table, held through registry references so it can be set without looking anything up by name.
+ */
+struct LuaFieldTarget
+{
+    lua_State* lua_state = nullptr;
+
+    int table_ref = LUA_NOREF;
+    int key_ref = LUA_NOREF;
+};
+
+/**
+ *  Every native tween of one UpdateType, stored as one array per field.
+ *
+ *  Update advances the clocks and interpolates the values in loops over plain float
+ *  arrays, so they vectorize, and only drops to per-tween branches for loop wraps and
+ *  target writes. Float tweens leave the y fields unused.
+ */
+class TweenBatch {
+public:
+
+
+    uint32_t Add(uint32_t id, TweenTargetType target_type, void* target_x, void* target_y, float start_x, float start_y, float end_x, float end_y, float duration);
+
+    /**
+     *  Appends a copy of another batch's tween, for moving it to a different UpdateType.
+     */
+    uint32_t AddFrom(const TweenBatch &other, uint32_t other_slot);
+
+    /**
+     *  Removes a tween by moving the last one into its slot.
+     *
+     *  @return the id of the tween now in the slot, or no_tween if the slot was the last one
+     */
+    uint32_t Remove(uint32_t slot);
+
+    /**
+     *  Advances, evaluates and applies every tween.
+     *
+     *  @param finished_slots receives, in ascending order, the slots of tweens that completed or were killed
+     */
+    void Update(float delta_time, std::vector<DeferredTweenWrite> &deferred_writes, std::vector<uint32_t> &finished_slots);
+
+
+    size_t Size() const;
+
+
+    std::vector<uint32_t> ids;
+    std::vector<TweenTargetType> target_type;
+    std::vector<void*> target_x;
+    std::vector<void*> target_y;
+
+    std::vector<float> start_x;
+    std::vector<float> start_y;
+    std::vector<float> end_x;
+    std::vector<float> end_y;
+    std::vector<float> value_x;
+    std::vector<float> value_y;
+
+    std::vector<float> elapsed_time;
+    std::vector<float> evaluated_duration;
+    std::vector<float> duration;
+    std::vector<float> timescale;
+    std::vector<float> overshoot;
+    std::vector<float> eased_progress;
+
+    std::vector<EaseFunction> ease_function;
+    std::vector<LoopType> loop_type;
+    std::vector<AxisConstraint> axis_constraint;
+    std::vector<int32_t> loops;
+    std::vector<int32_t> loops_completed;
+
+    std::vector<uint8_t> snapping;
+    std::vector<uint8_t> playing;
+    std::vector<uint8_t> killed;
+    std::vector<uint8_t> completed;
+
+
+    static inline const uint32_t no_tween = UINT32_MAX;
+
+private:
+
+    /**
+     *  @return true if the tween has run all of its loops, otherwise restarts it for the next one
+     */
+    bool WrapLoop(uint32_t slot);
+
+    /**
+     *  Calls function with the matching field of every batch, for each field.
+     */
+    template <typename Function, typename... Batches>
+    static void ForEachField(Function function, Batches&... batches);
+};
+
+/**
+ *  A handle to a tween run by NativeTweenManager, with the same chaining API as ITween.
+ *
+ *  Handles are plain ids, so they are cheap to copy into Lua and do nothing once their
+ *  tween has finished or been killed.
+ */
+class NativeTween {
+public:
+
+
+    NativeTween() {}
+
+
+    NativeTween Play();
+
+
+    NativeTween Pause();
+
+
+    NativeTween Rewind();
+
+
+    NativeTween Stop();
+
+
+    NativeTween Kill();
+
+
+    NativeTween OnKill(sol::protected_function kill_func, sol::optional<sol::table> kill_table);
+
+
+    NativeTween SetOvershootOrAmplitude(float overshootOrAmplitude);
+
+
+    NativeTween SetTimescale(float timescale);
+
+
+    float GetTimescale() const;
+
+
+    NativeTween SetLoops(int32_t loops, LoopType loop_type);
+
+
+    NativeTween SetEase(EaseType ease_type);
+
+
+    NativeTween SetUpdate(UpdateType update_type);
+
+
+    NativeTween SetAxisConstraint(AxisConstraint axis_constraint);
+
+
+    NativeTween SetSnapping(bool snapping);
+
+    /**
+     *  Jumps to a point in the current loop, from 0 at its start to 1 at its end.
+     */
+    NativeTween SetProgress(float progress);
+
+
+    float GetProgress() const;
+
+
+    bool IsPlaying() const;
+
+    /**
+     *  @return false once the tween has finished or been killed
+     */
+    bool IsAlive() const;
+
+private:
+
+
+    friend class NativeTweenManager;
+
+
+    NativeTween(uint32_t id, uint32_t generation) : id(id), generation(generation) {}
+
+
+    uint32_t id = TweenBatch::no_tween;
+
+
+    uint32_t generation = 0;
+};
+
+/**
+ *  Runs tweens on engine-owned values without std::function or Lua calls.
+ *
+ *  Each UpdateType has its own TweenBatch. Tweens are addressed through an id table, so
+ *  handles stay valid while tweens move around inside the batches.
+ */
+class NativeTweenManager {
+public:
+
+
+    static NativeTween CreateFloat(float* target, float start, float end, float duration);
+
+
+    static NativeTween CreateVec2(float* target_x, float* target_y, float start_x, float start_y, float end_x, float end_y, float duration);
+
+    /**
+     *  Tweens an integer such as a frame index, truncating the value on every write.
+     */
+    static NativeTween CreateUint32(uint32_t* target, float start, float end, float duration);
+
+    /**
+     *  Creates a tween whose writes are left in GetDeferredWrites. target_type must be one of the deferred types.
+     */
+    static NativeTween CreateDeferred(TweenTargetType target_type, void* target, float start_x, float start_y, float end_x, float end_y, float duration);
+
+    /**
+     *  Tweens a number field of a Lua table from its current value, writing it with a raw set.
+     *
+     *  @return a handle that does nothing if the field does not hold a number
+     */
+    static NativeTween CreateLuaField(const sol::table &table, const sol::object &key, float end, float duration);
+
+    /**
+     *  GOTween.Field. Reports a script error and returns a dead handle if the field does not hold a number.
+     */
+    static NativeTween cppGOTweenField(sol::table tween_table, sol::object key, float end, float duration);
+
+    /**
+     *  GOTween.Fields. Tweens every number field named in ends, driven by the returned handle.
+     */
+    static NativeTween cppGOTweenFields(sol::table tween_table, sol::table ends, float duration);
+
+    /**
+     *  Makes every call on leader apply to follower too, so several tweens can be driven
+     *  through one handle. Only the leader's OnKill callback runs.
+     */
+    static void Link(const NativeTween &leader, const NativeTween &follower);
+
+    /**
+     *  Calls callback once tween completes or is killed. Finish callbacks run inside Update,
+     *  so unlike OnKill callbacks they must not call into Lua.
+     *
+     *  @return false, without keeping callback, if the tween has already finished
+     */
+    static bool AddFinishCallback(const NativeTween &tween, std::function<void()> callback);
+
+    /**
+     *  Updates every tween of one UpdateType and removes those that completed or were killed.
+     *
+     *  Writes for deferred targets are left in GetDeferredWrites. The caller applies them
+     *  and then calls FinishUpdate, so callbacks see their tween's final value.
+     */
+    static void Update(UpdateType update_type, float delta_time);
+
+    /**
+     *  Frees the targets of tweens removed by the last Update and runs the OnKill callbacks of those that completed.
+     */
+    static void FinishUpdate();
+
+    /**
+     *  Kills every tween writing to target, for owners that are about to be destroyed.
+     */
+    static void KillTarget(const void* target);
+
+
+    static std::vector<DeferredTweenWrite>& GetDeferredWrites();
+
+
+    static void WriteLuaField(const LuaFieldTarget &target, float value);
+
+
+    static size_t GetTweenCount();
+
+private:
+
+
+    friend class NativeTween;
+
+
+    struct TweenRecord
+    {
+        uint32_t generation = 0;
+        uint32_t slot = 0;
+
+        UpdateType update_type = UpdateType::Normal;
+
+        bool alive = false;
+    };
+
+
+    static NativeTween Create(TweenTargetType target_type, void* target_x, void* target_y, float start_x, float start_y, float end_x, float end_y, float duration);
+
+
+    static TweenBatch* FindTween(const NativeTween &tween, uint32_t &slot);
+
+    /**
+     *  Calls function with the batch and slot of tween and of every tween linked to it.
+     */
+    template <typename Function>
+    static void ForEachLinked(const NativeTween &tween, Function function);
+
+
+    static void MoveTween(uint32_t id, UpdateType update_type);
+
+
+    static void ReleaseTween(uint32_t id);
+
+
+    static TweenBatch& GetBatch(UpdateType update_type);
+
+
+    static inline std::array<TweenBatch, 3> batches;
+
+
+    static inline std::vector<TweenRecord> records;
+
+
+    static inline std::vector<uint32_t> free_ids;
+
+
+    static inline std::unordered_map<uint32_t, std::function<void()>> kill_callbacks;
+
+
+    static inline std::unordered_map<uint32_t, std::vector<NativeTween>> linked_tweens;
+
+
+    static inline std::unordered_map<uint32_t, std::vector<std::function<void()>>> finish_callbacks;
+
+
+    static inline std::vector<std::function<void()>> pending_kill_callbacks;
+
+
+    static inline std::vector<uint32_t> finished_slots;
+
+
+    static inline std::vector<DeferredTweenWrite> deferred_writes;
+
+    /**
+     *  A deque, so targets stay put while tweens point at them.
+     */
+    static inline std::deque<LuaFieldTarget> lua_field_targets;
+
+
+    static inline std::vector<LuaFieldTarget*> free_lua_field_targets;
+
+
+    static inline std::vector<LuaFieldTarget*> released_lua_field_targets;
+};
+
+
+inline size_t TweenBatch::Size() const                                          { return ids.size(); }
+
+
+inline std::vector<DeferredTweenWrite>& NativeTweenManager::GetDeferredWrites() { return deferred_writes; }
+
+
+inline void NativeTweenManager::WriteLuaField(const LuaFieldTarget &target, float value)
+{
+    lua_State* lua_state = target.lua_state;
+
+    lua_rawgeti(lua_state, LUA_REGISTRYINDEX, target.table_ref);
+    lua_rawgeti(lua_state, LUA_REGISTRYINDEX, target.key_ref);
+    lua_pushnumber(lua_state, value);
+    lua_rawset(lua_state, -3);
+    lua_pop(lua_state, 1);
+}
+
+
+inline TweenBatch& NativeTweenManager::GetBatch(UpdateType update_type)         { return batches[static_cast<size_t>(update_type)]; }
+
+
+template <typename Function, typename... Batches>
+inline void TweenBatch::ForEachField(Function function, Batches&... batches)
+{
+    function(batches.ids...);
+    function(batches.target_type...);
+    function(batches.target_x...);
+    function(batches.target_y...);
+    function(batches.start_x...);
+    function(batches.start_y...);
+    function(batches.end_x...);
+    function(batches.end_y...);
+    function(batches.value_x...);
+    function(batches.value_y...);
+    function(batches.elapsed_time...);
+    function(batches.evaluated_duration...);
+    function(batches.duration...);
+    function(batches.timescale...);
+    function(batches.overshoot...);
+    function(batches.eased_progress...);
+    function(batches.ease_function...);
+    function(batches.loop_type...);
+    function(batches.axis_constraint...);
+    function(batches.loops...);
+    function(batches.loops_completed...);
+    function(batches.snapping...);
+    function(batches.playing...);
+    function(batches.killed...);
+    function(batches.completed...);
+}
+
+
+#endif /* NativeTween_hpp */
@@ -0,0 +1,370 @@
+//
+//  ParticleEmitter.cpp
+//  blitzENGINE
+//
+
+#include "ParticleEmitter.hpp"
+
+#include "Engine.h"
+#include "ImageManager.hpp"
+#include "Renderer.hpp"
+#include "ThreadPool.hpp"
+
+#include <cmath>
+
+
+ParticleEmitter::ParticleEmitter()
+{
+    type = "ParticleEmitter";
+
+    component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
+
+    has_on_start = true;
+    has_on_update = true;
+}
+
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitter &other)
+    :   NativeComponent::NativeComponent(other),
+        image_name(other.image_name),
+        start_color(other.start_color),
+        end_color(other.end_color),
+        size_ease(other.size_ease),
+        color_ease(other.color_ease),
+        _x(other._x),
+        _y(other._y),
+        _rate(other._rate),
+        lifetime(other.lifetime),
+        lifetime_variance(other.lifetime_variance),
+        speed(other.speed),
+        speed_variance(other.speed_variance),
+        direction(other.direction),
+        spread(other.spread),
+        gravity_x(other.gravity_x),
+        gravity_y(other.gravity_y),
+        start_size(other.start_size),
+        end_size(other.end_size),
+        max_particles(other.max_particles),
+        random_state(other.random_state),
+        sorting_order(other.sorting_order),
+        playing(other.playing)
+{
+    // Clones would otherwise emit the same stream as their template, so each one mixes in its own count
+    random_state ^= ++clones_made * 0x9E3779B9u;
+
+    if (random_state == 0)
+        random_state = 0x2545F491u;
+
+    component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
+}
+
+
+void ParticleEmitter::UpdateComponentWithJSON(const rapidjson::Value &component_json)
+{
+    if (component_json.HasMember("image") && component_json["image"].IsString())
+        image_name = component_json["image"].GetString();
+
+    if (component_json.HasMember("x") && component_json["x"].IsNumber())
+        _x = component_json["x"].GetFloat();
+
+    if (component_json.HasMember("y") && component_json["y"].IsNumber())
+        _y = component_json["y"].GetFloat();
+
+    if (component_json.HasMember("rate") && component_json["rate"].IsNumber())
+        SetRate(component_json["rate"].GetFloat());
+
+    if (component_json.HasMember("max_particles") && component_json["max_particles"].IsUint())
+        max_particles = component_json["max_particles"].GetUint();
+
+    if (component_json.HasMember("lifetime") && component_json["lifetime"].IsNumber())
+        lifetime = component_json["lifetime"].GetFloat();
+
+    if (component_json.HasMember("lifetime_variance") && component_json["lifetime_variance"].IsNumber())
+        lifetime_variance = component_json["lifetime_variance"].GetFloat();
+
+    if (component_json.HasMember("speed") && component_json["speed"].IsNumber())
+        speed = component_json["speed"].GetFloat();
+
+    if (component_json.HasMember("speed_variance") && component_json["speed_variance"].IsNumber())
+        speed_variance = component_json["speed_variance"].GetFloat();
+
+    if (component_json.HasMember("direction") && component_json["direction"].IsNumber())
+        direction = component_json["direction"].GetFloat();
+
+    if (component_json.HasMember("spread") && component_json["spread"].IsNumber())
+        spread = component_json["spread"].GetFloat();
+
+    if (component_json.HasMember("gravity_x") && component_json["gravity_x"].IsNumber())
+        gravity_x = component_json["gravity_x"].GetFloat();
+
+    if (component_json.HasMember("gravity_y") && component_json["gravity_y"].IsNumber())
+        gravity_y = component_json["gravity_y"].GetFloat();
+
+    if (component_json.HasMember("start_size") && component_json["start_size"].IsNumber())
+        start_size = component_json["start_size"].GetFloat();
+
+    if (component_json.HasMember("end_size") && component_json["end_size"].IsNumber())
+        end_size = component_json["end_size"].GetFloat();
+
+    if (component_json.HasMember("start_color"))
+        ReadColor(component_json["start_color"], start_color);
+
+    if (component_json.HasMember("end_color"))
+        ReadColor(component_json["end_color"], end_color);
+
+    if (component_json.HasMember("size_ease") && component_json["size_ease"].IsString())
+    {
+        if (!EaseManager::GetEaseTypeFromName(component_json["size_ease"].GetString(), size_ease))
+            ErrorExit("error: unknown size_ease " + std::string(component_json["size_ease"].GetString()));
+    }
+
+    if (component_json.HasMember("color_ease") && component_json["color_ease"].IsString())
+    {
+        if (!EaseManager::GetEaseTypeFromName(component_json["color_ease"].GetString(), color_ease))
+            ErrorExit("error: unknown color_ease " + std::string(component_json["color_ease"].GetString()));
+    }
+
+    if (component_json.HasMember("sorting_order") && component_json["sorting_order"].IsNumber())
+        sorting_order = static_cast<uint16_t>(component_json["sorting_order"].GetFloat());
+
+    if (component_json.HasMember("playing") && component_json["playing"].IsBool())
+        playing = component_json["playing"].GetBool();
+
+    if (component_json.HasMember("seed") && component_json["seed"].IsUint())
+        random_state = std::max(component_json["seed"].GetUint(), 1u);
+}
+
+
+void ParticleEmitter::OnStart()
+{
+    if (!image_name.empty())
+        image = ImageManager::GetImage(image_name);
+
+    BuildEaseTable(size_ease_table, size_ease);
+    BuildEaseTable(color_ease_table, color_ease);
+
+    position_x.reserve(max_particles);
+    position_y.reserve(max_particles);
+    velocity_x.reserve(max_particles);
+    velocity_y.reserve(max_particles);
+    age.reserve(max_particles);
+    inverse_lifetime.reserve(max_particles);
+
+    vertices = std::make_shared<std::vector<SDL_Vertex>>();
+    vertices->reserve(static_cast<size_t>(max_particles) * 4);
+
+    // Every quad uses the same two triangles, so the index buffer is built once
+    indices = std::make_shared<std::vector<int>>(static_cast<size_t>(max_particles) * 6);
+
+    for (uint32_t i = 0; i < max_particles; ++i)
+    {
+        int first_vertex = static_cast<int>(i * 4);
+        int* quad_indices = &(*indices)[static_cast<size_t>(i) * 6];
+
+        quad_indices[0] = first_vertex;
+        quad_indices[1] = first_vertex + 1;
+        quad_indices[2] = first_vertex + 2;
+        quad_indices[3] = first_vertex;
+        quad_indices[4] = first_vertex + 2;
+        quad_indices[5] = first_vertex + 3;
+    }
+}
+
+
+void ParticleEmitter::OnUpdate()
+{
+    float delta_time = static_cast<float>(Engine::GetDeltaTime());
+
+    if (playing)
+    {
+        emission_remainder += _rate * delta_time;
+
+        uint32_t spawn_count = static_cast<uint32_t>(emission_remainder);
+        emission_remainder -= spawn_count;
+
+        Spawn(spawn_count);
+    }
+
+    ThreadPool::ParallelFor(static_cast<uint32_t>(age.size()), parallel_batch_size, [this, delta_time](uint32_t begin, uint32_t end) {
+        Simulate(begin, end, delta_time);
+    });
+
+    RemoveDeadParticles();
+
+    uint32_t particle_count = static_cast<uint32_t>(age.size());
+
+    if (particle_count == 0)
+        return;
+
+    vertices->resize(static_cast<size_t>(particle_count) * 4);
+
+    ThreadPool::ParallelFor(particle_count, parallel_batch_size, [this](uint32_t begin, uint32_t end) {
+        BuildVertices(begin, end);
+    });
+
+    GeometryDrawRequest geometry_draw_request;
+
+    geometry_draw_request.image = image;
+    geometry_draw_request.vertices = vertices;
+    geometry_draw_request.indices = indices;
+    geometry_draw_request.index_count = static_cast<int>(particle_count * 6);
+    geometry_draw_request.sorting_order = sorting_order;
+
+    Renderer::geometry_render_requests.push_back(geometry_draw_request);
+}
+
+
+void ParticleEmitter::OnDestroy() {}
+
+
+void ParticleEmitter::cppParticleEmitterEmit(int count)
+{
+    if (count > 0)
+        Spawn(static_cast<uint32_t>(count));
+}
+
+
+void ParticleEmitter::cppParticleEmitterClear()
+{
+    position_x.clear();
+    position_y.clear();
+    velocity_x.clear();
+    velocity_y.clear();
+    age.clear();
+    inverse_lifetime.clear();
+
+    emission_remainder = 0.0f;
+}
+
+
+void ParticleEmitter::Spawn(uint32_t count)
+{
+    count = std::min<uint32_t>(count, max_particles - static_cast<uint32_t>(age.size()));
+
+    const float degrees_to_radians = 3.14159265f / 180.0f;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float angle = (direction + RandomRange(-0.5f, 0.5f) * spread) * degrees_to_radians;
+        float particle_speed = speed + RandomRange(-speed_variance, speed_variance);
+        float particle_lifetime = std::max(lifetime + RandomRange(-lifetime_variance, lifetime_variance), 0.001f);
+
+        position_x.push_back(_x);
+        position_y.push_back(_y);
+        velocity_x.push_back(std::cos(angle) * particle_speed);
+        velocity_y.push_back(std::sin(angle) * particle_speed);
+        age.push_back(0.0f);
+        inverse_lifetime.push_back(1.0f / particle_lifetime);
+    }
+}
+
+
+void ParticleEmitter::Simulate(uint32_t begin, uint32_t end, float delta_time)
+{
+    float* __restrict px = position_x.data();
+    float* __restrict py = position_y.data();
+    float* __restrict vx = velocity_x.data();
+    float* __restrict vy = velocity_y.data();
+    float* __restrict particle_age = age.data();
+
+    float gravity_step_x = gravity_x * delta_time;
+    float gravity_step_y = gravity_y * delta_time;
+
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        particle_age[i] += delta_time;
+
+        vx[i] += gravity_step_x;
+        vy[i] += gravity_step_y;
+
+        px[i] += vx[i] * delta_time;
+        py[i] += vy[i] * delta_time;
+    }
+}
+
+
+void ParticleEmitter::BuildVertices(uint32_t begin, uint32_t end)
+{
+    const float pixels_per_meter = 1.0f + PIXELS_PER_METER_ADDEND;
+    const float last_ease_index = static_cast<float>(size_ease_table.size() - 1);
+
+    SDL_Vertex* quad = vertices->data() + static_cast<size_t>(begin) * 4;
+
+    for (uint32_t i = begin; i < end; ++i, quad += 4)
+    {
+        size_t ease_index = static_cast<size_t>(std::min(age[i] * inverse_lifetime[i], 1.0f) * last_ease_index);
+
+        float half_size = 0.5f * (start_size + (end_size - start_size) * size_ease_table[ease_index]);
+        float color_progress = color_ease_table[ease_index];
+
+        SDL_Color color;
+        color.r = static_cast<Uint8>(std::clamp(start_color[0] + (end_color[0] - start_color[0]) * color_progress, 0.0f, 255.0f));
+        color.g = static_cast<Uint8>(std::clamp(start_color[1] + (end_color[1] - start_color[1]) * color_progress, 0.0f, 255.0f));
+        color.b = static_cast<Uint8>(std::clamp(start_color[2] + (end_color[2] - start_color[2]) * color_progress, 0.0f, 255.0f));
+        color.a = static_cast<Uint8>(std::clamp(start_color[3] + (end_color[3] - start_color[3]) * color_progress, 0.0f, 255.0f));
+
+        float center_x = position_x[i] * pixels_per_meter;
+        float center_y = position_y[i] * pixels_per_meter;
+
+        quad[0] = SDL_Vertex{{center_x - half_size, center_y - half_size}, color, {0.0f, 0.0f}};
+        quad[1] = SDL_Vertex{{center_x + half_size, center_y - half_size}, color, {1.0f, 0.0f}};
+        quad[2] = SDL_Vertex{{center_x + half_size, center_y + half_size}, color, {1.0f, 1.0f}};
+        quad[3] = SDL_Vertex{{center_x - half_size, center_y + half_size}, color, {0.0f, 1.0f}};
+    }
+}
+
+
+void ParticleEmitter::RemoveDeadParticles()
+{
+    size_t particle_count = age.size();
+
+    // Swaps each expired particle with the last one, so removal never shifts the arrays
+    for (size_t i = 0; i < particle_count;)
+    {
+        if (age[i] * inverse_lifetime[i] < 1.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        --particle_count;
+
+        position_x[i] = position_x[particle_count];
+        position_y[i] = position_y[particle_count];
+        velocity_x[i] = velocity_x[particle_count];
+        velocity_y[i] = velocity_y[particle_count];
+        age[i] = age[particle_count];
+        inverse_lifetime[i] = inverse_lifetime[particle_count];
+    }
+
+    position_x.resize(particle_count);
+    position_y.resize(particle_count);
+    velocity_x.resize(particle_count);
+    velocity_y.resize(particle_count);
+    age.resize(particle_count);
+    inverse_lifetime.resize(particle_count);
+}
+
+
+void ParticleEmitter::BuildEaseTable(std::array<float, 64> &ease_table, EaseType ease_type)
+{
+    std::array<float, 64> progress;
+
+    for (size_t i = 0; i < progress.size(); ++i)
+        progress[i] = static_cast<float>(i) / (progress.size() - 1);
+
+    EaseManager::EvaluateEases(ease_type, progress.data(), ease_table.data(), ease_table.size(), EaseManager::default_overshoot_or_amplitude);
+}
+
+
+void ParticleEmitter::ReadColor(const rapidjson::Value &color_json, std::array<float, 4> &color)
+{
+    if (!color_json.IsArray() || color_json.Size() < 3)
+        return;
+
+    for (rapidjson::SizeType channel = 0; channel < std::min<rapidjson::SizeType>(color_json.Size(), 4); ++channel)
+    {
+        if (color_json[channel].IsNumber())
+            color[channel] = color_json[channel].GetFloat();
+    }
+}
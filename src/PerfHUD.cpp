@@ -0,0 +1,215 @@
+//
+//  PerfHUD.cpp
+//  blitzENGINE
+//
+
+#include "PerfHUD.hpp"
+
+#include "ComponentManager.hpp"
+#include "CoroutineManager.hpp"
+#include "ImageManager.hpp"
+#include "LayerManager.hpp"
+#include "PixelLayer.hpp"
+#include "Renderer.hpp"
+#include "Rigidbody.hpp"
+#include "Scheduler.hpp"
+#include "TextManager.hpp"
+#include "TweenManager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+
+void PerfHUD::SetToggleKey(const std::string &toggle_key_name)
+{
+    SDL_Scancode scancode = SDL_GetScancodeFromName(toggle_key_name.c_str());
+
+    if (scancode == SDL_SCANCODE_UNKNOWN)
+        std::cout << "error: unknown perf_hud_key " << toggle_key_name << std::endl;
+    else
+        toggle_scancode = scancode;
+}
+
+
+void PerfHUD::HandleEvent(const SDL_Event &e)
+{
+    if (e.type == SDL_KEYDOWN && !e.key.repeat && e.key.keysym.scancode == toggle_scancode)
+    {
+        visible = !visible;
+        time_since_refresh = refresh_interval;
+    }
+}
+
+
+void PerfHUD::RecordFrame(float frame_time, uint16_t physics_steps)
+{
+    frame_times[next_frame_time] = frame_time;
+    next_frame_time = (next_frame_time + 1) % frame_times.size();
+
+    PerfHUD::physics_steps = physics_steps;
+    time_since_refresh += frame_time;
+
+    screenspace_requests = Renderer::screenspace_render_requests.size();
+    ui_requests = Renderer::ui_render_requests.size();
+    text_requests = Renderer::text_render_queue.size();
+    pixels_written = PixelLayer::GetPixelsWritten();
+}
+
+
+void PerfHUD::Draw(SDL_Renderer *sdl_renderer, Scene &scene)
+{
+    if (!visible)
+        return;
+
+    if (time_since_refresh >= refresh_interval)
+    {
+        RefreshText(sdl_renderer, scene);
+        time_since_refresh = 0.0f;
+    }
+
+    int panel_width = static_cast<int>(frame_times.size()) + 2 * margin;
+    int panel_height = histogram_height + 2 * margin;
+
+    for (const std::shared_ptr<Image> &text_line : text_lines)
+    {
+        panel_width = std::max(panel_width, text_line->width + 2 * margin);
+        panel_height += text_line->height;
+    }
+
+    SDL_RenderSetScale(sdl_renderer, 1, 1);
+    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_BLEND);
+
+    SDL_Rect panel{0, 0, panel_width, panel_height};
+    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(sdl_renderer, &panel);
+
+    int y = margin;
+
+    for (const std::shared_ptr<Image> &text_line : text_lines)
+    {
+        SDL_Rect line_rect{margin, y, text_line->width, text_line->height};
+        SDL_RenderCopy(sdl_renderer, text_line->texture, NULL, &line_rect);
+        y += text_line->height;
+    }
+
+    DrawHistogram(sdl_renderer, margin, y);
+
+    Renderer::ResetDrawState();
+}
+
+
+void PerfHUD::RefreshText(SDL_Renderer *sdl_renderer, Scene &scene)
+{
+    for (const std::shared_ptr<Image> &text_line : text_lines)
+        SDL_DestroyTexture(text_line->texture);
+
+    text_lines.clear();
+
+    TTF_Font* font = GetHUDFont();
+
+    if (!font)
+        return;
+
+    float total_frame_time = 0.0f;
+    float max_frame_time = 0.0f;
+
+    for (float frame_time : frame_times)
+    {
+        total_frame_time += frame_time;
+        max_frame_time = std::max(max_frame_time, frame_time);
+    }
+
+    float average_frame_time = total_frame_time / frame_times.size();
+
+    size_t component_count = 0;
+
+    for (auto &[uuid, actor] : scene.actors_by_uuid)
+        component_count += actor->actor_components.size();
+
+    b2World* world = Rigidbody::GetWorld();
+
+    size_t tween_count = TweenManager::updating_tweens.size() + TweenManager::late_updating_tweens.size() + TweenManager::fixed_updating_tweens.size()
+                         + NativeTweenManager::GetTweenCount();
+
+    char lines[6][128];
+
+    std::snprintf(lines[0], sizeof(lines[0]), "frame %.2f ms avg  %.2f ms max  %.0f fps",
+                  average_frame_time * 1000.0f, max_frame_time * 1000.0f, average_frame_time > 0.0f ? 1.0f / average_frame_time : 0.0f);
+    std::snprintf(lines[1], sizeof(lines[1]), "physics %u steps  %d bodies  %d contacts",
+                  physics_steps, world ? world->GetBodyCount() : 0, world ? world->GetContactCount() : 0);
+    std::snprintf(lines[2], sizeof(lines[2]), "draws %zu scene  %zu ui  %zu text  %zu pixels  %zu/%zu layers redrawn",
+                  screenspace_requests, ui_requests, text_requests, pixels_written, LayerManager::GetRedrawCount(), LayerManager::GetLayers().size());
+    std::snprintf(lines[3], sizeof(lines[3]), "textures %zu text created  %zu cached",
+                  TextManager::GetTextTexturesCreated(), ImageManager::GetCachedImageCount());
+    std::snprintf(lines[4], sizeof(lines[4]), "actors %zu  components %zu  tweens %zu  timers %zu  coroutines %zu",
+                  scene.actors_by_uuid.size(), component_count, tween_count, Scheduler::GetTimerCount(), CoroutineManager::GetCoroutineCount());
+    std::snprintf(lines[5], sizeof(lines[5]), "lua heap %d KB",
+                  lua_gc(ComponentManager::GetLuaState()->lua_state(), LUA_GCCOUNT, 0));
+
+    for (const char* line : lines)
+    {
+        SDL_Surface* surface = TTF_RenderText_Blended(font, line, SDL_Color{255, 255, 255, 255});
+
+        if (!surface)
+            continue;
+
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(sdl_renderer, surface);
+        text_lines.emplace_back(std::make_shared<Image>(texture, surface->w, surface->h));
+
+        SDL_FreeSurface(surface);
+    }
+}
+
+
+void PerfHUD::DrawHistogram(SDL_Renderer *sdl_renderer, int x, int y)
+{
+    // A full bar is two 60 Hz frames, so anything that misses a vsync stands out
+    const float full_bar_time = 2.0f / 60.0f;
+
+    for (size_t i = 0; i < frame_times.size(); ++i)
+    {
+        float frame_time = frame_times[(next_frame_time + i) % frame_times.size()];
+        int bar_height = std::min(histogram_height, static_cast<int>(histogram_height * frame_time / full_bar_time));
+
+        if (frame_time > full_bar_time / 2.0f)
+            SDL_SetRenderDrawColor(sdl_renderer, 230, 60, 60, 255);
+        else if (frame_time > full_bar_time / 4.0f)
+            SDL_SetRenderDrawColor(sdl_renderer, 230, 200, 60, 255);
+        else
+            SDL_SetRenderDrawColor(sdl_renderer, 60, 200, 90, 255);
+
+        SDL_Rect bar{x + static_cast<int>(i), y + histogram_height - bar_height, 1, bar_height};
+        SDL_RenderFillRect(sdl_renderer, &bar);
+    }
+
+    SDL_SetRenderDrawColor(sdl_renderer, 255, 255, 255, 90);
+    SDL_RenderDrawLine(sdl_renderer, x, y + histogram_height / 2, x + static_cast<int>(frame_times.size()) - 1, y + histogram_height / 2);
+}
+
+
+TTF_Font* PerfHUD::GetHUDFont()
+{
+    if (font_missing)
+        return nullptr;
+
+    // Without a configured font, borrow the alphabetically first one the game ships
+    if (font_name.empty() && std::filesystem::exists(FONTS_PATH))
+    {
+        for (const auto &font_entry : std::filesystem::directory_iterator(FONTS_PATH))
+        {
+            std::string font_stem = font_entry.path().stem().string();
+
+            if (font_entry.path().extension() == ".ttf" && (font_name.empty() || font_stem < font_name))
+                font_name = font_stem;
+        }
+    }
+
+    if (font_name.empty() || !std::filesystem::exists(FONTS_PATH + font_name + ".ttf"))
+    {
+        font_missing = true;
+        return nullptr;
+    }
+
+    return TextManager::GetFont(font_name, font_size);
+}
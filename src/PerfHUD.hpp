@@ -0,0 +1,121 @@
+//
+//  PerfHUD.hpp
+//  blitzENGINE
+//
+
+#ifndef PerfHUD_hpp
+#define PerfHUD_hpp
+
+#include "Image.hpp"
+#include "Scene.hpp"
+#include "SDL2/SDL.h"
+#include "SDL2_ttf/SDL_ttf.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ *  An engine-drawn overlay of frame timings and engine counters, toggled with a key (F3 by default).
+ *
+ *  Draws straight to the SDL renderer after the frame's own draw requests, so it shows up in
+ *  any game without a script or scene changes. Text lines are re-rendered a few times a second
+ *  into textures the HUD owns, so changing numbers never fill the text texture cache.
+ */
+class PerfHUD {
+public:
+
+    /**
+     *  @param  toggle_key_name     an SDL key name such as "F3" or "`"
+     */
+    static void SetToggleKey(const std::string &toggle_key_name);
+
+
+    static void SetFont(const std::string &font_name);
+
+
+    static void HandleEvent(const SDL_Event &e);
+
+
+    static bool IsVisible();
+
+    /**
+     *  Stores the frame's timing and draw request counts. Call before the renderer consumes the requests.
+     */
+    static void RecordFrame(float frame_time, uint16_t physics_steps);
+
+
+    static void Draw(SDL_Renderer *sdl_renderer, Scene &scene);
+
+private:
+
+
+    static void RefreshText(SDL_Renderer *sdl_renderer, Scene &scene);
+
+
+    static void DrawHistogram(SDL_Renderer *sdl_renderer, int x, int y);
+
+
+    static TTF_Font* GetHUDFont();
+
+
+    static inline std::array<float, 120> frame_times = {};
+
+
+    static inline size_t next_frame_time = 0;
+
+
+    static inline std::vector<std::shared_ptr<Image>> text_lines;
+
+
+    static inline std::string font_name;
+
+
+    static inline size_t screenspace_requests = 0;
+
+
+    static inline size_t ui_requests = 0;
+
+
+    static inline size_t text_requests = 0;
+
+
+    static inline size_t pixels_written = 0;
+
+
+    static inline uint16_t physics_steps = 0;
+
+
+    static inline float time_since_refresh = 0.0f;
+
+
+    static inline SDL_Scancode toggle_scancode = SDL_SCANCODE_F3;
+
+
+    static inline bool visible = false;
+
+
+    static inline bool font_missing = false;
+
+
+    static inline const float refresh_interval = 0.25f;
+
+
+    static inline const int font_size = 12;
+
+
+    static inline const int margin = 4;
+
+
+    static inline const int histogram_height = 40;
+};
+
+
+inline bool PerfHUD::IsVisible()                                { return visible; }
+
+
+inline void PerfHUD::SetFont(const std::string &font_name)      { PerfHUD::font_name = font_name; }
+
+#endif /* PerfHUD_hpp */
@@ -0,0 +1,328 @@
+//
+//  PhysicsManager.cpp
+//  blitzENGINE
+//
+
+#include "PhysicsManager.hpp"
+
+#include "ComponentManager.hpp"
+#include "Rigidbody.hpp"
+#include "ThreadPool.hpp"
+#include "Utilities.hpp"
+
+// Kept out of the header, since b2Distance overloads clash with the Vector2 binding
+#include "b2_distance.h"
+
+#include <algorithm>
+
+
+struct PhysicsShapeCastCallback : b2QueryCallback {
+
+    b2DistanceProxy proxy;
+
+    b2Transform transform;
+
+    b2Vec2 translation;
+
+    HitResult hit_result;
+
+    bool hit = false;
+
+    bool ReportFixture(b2Fixture *fixture) override
+    {
+        Actor* actor = reinterpret_cast<Actor*>(fixture->GetUserData().pointer);
+
+        if (!actor)
+            return true;
+
+        const b2Shape* fixture_shape = fixture->GetShape();
+
+        for (int32 child_index = 0; child_index < fixture_shape->GetChildCount(); ++child_index)
+        {
+            b2ShapeCastInput input;
+            input.proxyA.Set(fixture_shape, child_index);
+            input.proxyB = proxy;
+            input.transformA = fixture->GetBody()->GetTransform();
+            input.transformB = transform;
+            input.translationB = translation;
+
+            b2ShapeCastOutput output;
+
+            if (b2ShapeCast(&output, &input) && output.lambda < hit_result.fraction)
+            {
+                hit_result.point = output.point;
+                hit_result.normal = output.normal;
+                hit_result.actor = actor;
+                hit_result.fraction = output.lambda;
+                hit_result.is_trigger = fixture->IsSensor();
+
+                hit = true;
+            }
+        }
+
+        return true;
+    }
+};
+
+
+void PhysicsManager::SetParallelStepping(bool parallel_stepping)
+{
+    PhysicsManager::parallel_stepping = parallel_stepping;
+
+    if (Rigidbody::GetWorld())
+        Rigidbody::GetWorld()->SetTaskExecutor(GetTaskExecutor());
+}
+
+
+bool PhysicsManager::Raycast(const b2Vec2 &position, b2Vec2 direction, float distance, HitResult &hit_result)
+{
+    b2World* world = Rigidbody::GetWorld();
+
+    if (!world || distance <= 0.0f || direction.Normalize() <= 0.0f)
+        return false;
+
+    PhysicsRaycastClosestCallback raycast_closest_callback;
+
+    world->RayCast(&raycast_closest_callback, position, position + (distance * direction));
+
+    if (raycast_closest_callback.hit)
+        hit_result = raycast_closest_callback.hit_result;
+
+    return raycast_closest_callback.hit;
+}
+
+
+void PhysicsManager::RaycastBatch(const std::vector<b2Vec2> &positions, const std::vector<b2Vec2> &directions, const std::vector<float> &distances, std::vector<HitResult> &hit_results)
+{
+    uint32_t ray_count = static_cast<uint32_t>(std::min({ positions.size(), directions.size(), distances.size() }));
+
+    hit_results.assign(ray_count, HitResult());
+
+    // b2World::RayCast only reads the broad-phase tree, so disjoint ranges can run concurrently
+    ThreadPool::ParallelFor(ray_count, min_raycast_batch_size, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+            Raycast(positions[i], directions[i], distances[i], hit_results[i]);
+    });
+}
+
+
+std::vector<Actor*> PhysicsManager::Overlap(const b2Shape &shape, const b2Transform &transform)
+{
+    b2World* world = Rigidbody::GetWorld();
+
+    if (!world)
+        return {};
+
+    PhysicsOverlapCallback overlap_callback;
+    overlap_callback.shape = &shape;
+    overlap_callback.transform = transform;
+
+    b2AABB aabb;
+    shape.ComputeAABB(&aabb, transform, 0);
+
+    world->QueryAABB(&overlap_callback, aabb);
+
+    // An actor can own several fixtures; report each one once, in a stable order
+    std::vector<Actor*> &actors = overlap_callback.actors;
+    std::sort(actors.begin(), actors.end(), Actor::less());
+    actors.erase(std::unique(actors.begin(), actors.end()), actors.end());
+
+    return actors;
+}
+
+
+bool PhysicsManager::ShapeCast(const b2Shape &shape, const b2Transform &transform, const b2Vec2 &translation, HitResult &hit_result)
+{
+    b2World* world = Rigidbody::GetWorld();
+
+    if (!world || translation.LengthSquared() <= 0.0f)
+        return false;
+
+    PhysicsShapeCastCallback shape_cast_callback;
+    shape_cast_callback.proxy.Set(&shape, 0);
+    shape_cast_callback.transform = transform;
+    shape_cast_callback.translation = translation;
+
+    // Only fixtures inside the bounds of the whole sweep can be hit
+    b2AABB start_aabb;
+    shape.ComputeAABB(&start_aabb, transform, 0);
+
+    b2AABB end_aabb = start_aabb;
+    end_aabb.lowerBound += translation;
+    end_aabb.upperBound += translation;
+
+    b2AABB sweep_aabb;
+    sweep_aabb.Combine(start_aabb, end_aabb);
+
+    world->QueryAABB(&shape_cast_callback, sweep_aabb);
+
+    if (shape_cast_callback.hit)
+        hit_result = shape_cast_callback.hit_result;
+
+    return shape_cast_callback.hit;
+}
+
+
+sol::object PhysicsManager::cppPhysicsRaycast(b2Vec2 position, b2Vec2 direction, float distance)
+{
+    HitResult hit_result;
+    bool hit = Raycast(position, direction, distance, hit_result);
+
+    return CreateHitResultObject(hit, hit_result);
+}
+
+
+sol::table PhysicsManager::cppPhysicsRaycastAll(b2Vec2 position, b2Vec2 direction, float distance)
+{
+    sol::table hit_result_table = ComponentManager::GetLuaState()->create_table();
+
+    b2World* world = Rigidbody::GetWorld();
+
+    if (!world || distance <= 0.0f || direction.Normalize() <= 0.0f)
+        return hit_result_table;
+
+    PhysicsRaycastAllCallback raycast_all_callback;
+
+    world->RayCast(&raycast_all_callback, position, position + (distance * direction));
+
+    std::stable_sort(raycast_all_callback.hit_results.begin(), raycast_all_callback.hit_results.end(), HitResult());
+
+    uint32_t hits = 0;
+
+    for (const HitResult &hit_result : raycast_all_callback.hit_results)
+        hit_result_table[++hits] = sol::make_object(ComponentManager::GetLuaState()->lua_state(), hit_result);
+
+    return hit_result_table;
+}
+
+
+sol::table PhysicsManager::cppPhysicsRaycastBatch(sol::table positions, sol::table directions, sol::object distances)
+{
+    size_t ray_count = positions.size();
+
+    if (directions.size() != ray_count)
+        ErrorExit("Physics.RaycastBatch requires one direction per origin");
+
+    std::vector<b2Vec2> ray_positions(ray_count);
+    std::vector<b2Vec2> ray_directions(ray_count);
+    std::vector<float> ray_distances(ray_count);
+
+    bool shared_distance = distances.is<float>();
+    sol::table distance_table;
+
+    if (shared_distance)
+        std::fill(ray_distances.begin(), ray_distances.end(), distances.as<float>());
+    else if (distances.is<sol::table>())
+        distance_table = distances.as<sol::table>();
+    else
+        ErrorExit("Physics.RaycastBatch distances must be a number or a table");
+
+    if (!shared_distance && distance_table.size() != ray_count)
+        ErrorExit("Physics.RaycastBatch requires one distance per origin");
+
+    // Lua tables are read up front, since worker threads must never touch the Lua state
+    for (size_t i = 0; i < ray_count; ++i)
+    {
+        ray_positions[i] = positions.get<b2Vec2>(i + 1);
+        ray_directions[i] = directions.get<b2Vec2>(i + 1);
+
+        if (!shared_distance)
+            ray_distances[i] = distance_table.get<float>(i + 1);
+    }
+
+    std::vector<HitResult> hit_results;
+    RaycastBatch(ray_positions, ray_directions, ray_distances, hit_results);
+
+    sol::table hit_result_table = ComponentManager::GetLuaState()->create_table(static_cast<int>(ray_count), 0);
+
+    // Misses are stored as false rather than nil so the table keeps its length
+    for (size_t i = 0; i < ray_count; ++i)
+    {
+        if (hit_results[i].actor)
+            hit_result_table[i + 1] = hit_results[i];
+        else
+            hit_result_table[i + 1] = false;
+    }
+
+    return hit_result_table;
+}
+
+
+sol::table PhysicsManager::cppPhysicsOverlapBox(b2Vec2 center, float width, float height, sol::optional<float> rotation)
+{
+    b2PolygonShape box;
+    box.SetAsBox(0.5f * width, 0.5f * height);
+
+    b2Transform transform(center, b2Rot(rotation.value_or(0.0f) * (b2_pi / 180.0f)));
+
+    return CreateActorTable(Overlap(box, transform));
+}
+
+
+sol::table PhysicsManager::cppPhysicsOverlapCircle(b2Vec2 center, float radius)
+{
+    b2CircleShape circle;
+    circle.m_radius = radius;
+
+    b2Transform transform(center, b2Rot(0.0f));
+
+    return CreateActorTable(Overlap(circle, transform));
+}
+
+
+sol::object PhysicsManager::cppPhysicsBoxCast(b2Vec2 position, float width, float height, float rotation, b2Vec2 direction, float distance)
+{
+    HitResult hit_result;
+    bool hit = false;
+
+    if (distance > 0.0f && direction.Normalize() > 0.0f)
+    {
+        b2PolygonShape box;
+        box.SetAsBox(0.5f * width, 0.5f * height);
+
+        b2Transform transform(position, b2Rot(rotation * (b2_pi / 180.0f)));
+
+        hit = ShapeCast(box, transform, distance * direction, hit_result);
+    }
+
+    return CreateHitResultObject(hit, hit_result);
+}
+
+
+sol::object PhysicsManager::cppPhysicsCircleCast(b2Vec2 position, float radius, b2Vec2 direction, float distance)
+{
+    HitResult hit_result;
+    bool hit = false;
+
+    if (distance > 0.0f && direction.Normalize() > 0.0f)
+    {
+        b2CircleShape circle;
+        circle.m_radius = radius;
+
+        b2Transform transform(position, b2Rot(0.0f));
+
+        hit = ShapeCast(circle, transform, distance * direction, hit_result);
+    }
+
+    return CreateHitResultObject(hit, hit_result);
+}
+
+
+sol::table PhysicsManager::CreateActorTable(const std::vector<Actor*> &actors)
+{
+    sol::table actor_table = ComponentManager::GetLuaState()->create_table(static_cast<int>(actors.size()), 0);
+
+    for (size_t i = 0; i < actors.size(); ++i)
+        actor_table[i + 1] = actors[i];
+
+    return actor_table;
+}
+
+
+sol::object PhysicsManager::CreateHitResultObject(bool hit, const HitResult &hit_result)
+{
+    if (hit)
+        return sol::make_object(ComponentManager::GetLuaState()->lua_state(), hit_result);
+
+    return sol::make_object(ComponentManager::GetLuaState()->lua_state(), sol::lua_nil);
+}
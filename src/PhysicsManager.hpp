@@ -0,0 +1,198 @@
+//
+//  PhysicsManager.hpp
+//  blitzENGINE
+//
+
+#ifndef PhysicsManager_hpp
+#define PhysicsManager_hpp
+
+#include "Actor.hpp"
+#include "box2d.h"
+#include "PhysicsTaskExecutor.hpp"
+#include "sol/sol.hpp"
+
+#include <vector>
+
+
+struct HitResult {
+
+    b2Vec2 point = b2Vec2(0.0f, 0.0f);
+
+    b2Vec2 normal = b2Vec2(0.0f, 0.0f);
+
+    Actor* actor = nullptr;
+
+    float fraction = 1.0f;
+
+    bool is_trigger = false;
+
+    bool operator()(const HitResult &lhs, const HitResult &rhs) const { return lhs.fraction < rhs.fraction; }
+};
+
+
+class PhysicsManager {
+public:
+
+    /**
+     *  Enables solving islands and narrow phase contacts on the ThreadPool.
+     *
+     *  Set from "parallel_physics" in game.config. Contact callbacks still run on the
+     *  main thread in a fixed order, so scripts see the same events either way.
+     */
+    static void SetParallelStepping(bool parallel_stepping);
+
+    /**
+     *  @returns    the executor to give b2World::SetTaskExecutor, or nullptr to step serially
+     */
+    static b2TaskExecutor* GetTaskExecutor();
+
+    /**
+     *  Casts a ray and returns the closest hit, clipping the ray on every report so
+     *  Box2D can skip any fixture behind the current closest one.
+     *
+     *  @returns    true if the ray hit a fixture that belongs to an Actor
+     */
+    static bool Raycast(const b2Vec2 &position, b2Vec2 direction, float distance, HitResult &hit_result);
+
+    /**
+     *  Runs Raycast for every ray in the batch, split across ThreadPool workers.
+     *
+     *  Misses are left with a null actor. Only reads the b2World, so it must not
+     *  overlap with a call to b2World::Step.
+     */
+    static void RaycastBatch(const std::vector<b2Vec2> &positions, const std::vector<b2Vec2> &directions, const std::vector<float> &distances, std::vector<HitResult> &hit_results);
+
+
+    static std::vector<Actor*> Overlap(const b2Shape &shape, const b2Transform &transform);
+
+    /**
+     *  Sweeps a shape along translation and returns the first fixture it touches.
+     *
+     *  Fixtures the shape already overlaps at the start of the cast are ignored.
+     */
+    static bool ShapeCast(const b2Shape &shape, const b2Transform &transform, const b2Vec2 &translation, HitResult &hit_result);
+
+
+    static sol::object cppPhysicsRaycast(b2Vec2 position, b2Vec2 direction, float distance);
+
+
+    static sol::table cppPhysicsRaycastAll(b2Vec2 position, b2Vec2 direction, float distance);
+
+
+    static sol::table cppPhysicsRaycastBatch(sol::table positions, sol::table directions, sol::object distances);
+
+
+    static sol::table cppPhysicsOverlapBox(b2Vec2 center, float width, float height, sol::optional<float> rotation);
+
+
+    static sol::table cppPhysicsOverlapCircle(b2Vec2 center, float radius);
+
+
+    static sol::object cppPhysicsBoxCast(b2Vec2 position, float width, float height, float rotation, b2Vec2 direction, float distance);
+
+
+    static sol::object cppPhysicsCircleCast(b2Vec2 position, float radius, b2Vec2 direction, float distance);
+
+private:
+
+
+    static sol::table CreateActorTable(const std::vector<Actor*> &actors);
+
+
+    static sol::object CreateHitResultObject(bool hit, const HitResult &hit_result);
+
+
+    static inline const uint32_t min_raycast_batch_size = 64;
+
+
+    static inline PhysicsTaskExecutor task_executor;
+
+
+    static inline bool parallel_stepping = false;
+};
+
+
+inline b2TaskExecutor* PhysicsManager::GetTaskExecutor() { return parallel_stepping ? &task_executor : nullptr; }
+
+
+struct PhysicsRaycastClosestCallback : b2RayCastCallback {
+
+    HitResult hit_result;
+
+    bool hit = false;
+
+    float ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float fraction) override
+    {
+        Actor* actor = reinterpret_cast<Actor*>(fixture->GetUserData().pointer);
+
+        if (!actor)
+            return -1;
+
+        hit_result.point = point;
+        hit_result.normal = normal;
+        hit_result.actor = actor;
+        hit_result.fraction = fraction;
+        hit_result.is_trigger = fixture->IsSensor();
+
+        hit = true;
+
+        // Clip the ray so only closer fixtures are reported from here on
+        return fraction;
+    }
+};
+
+
+struct PhysicsRaycastAllCallback : b2RayCastCallback {
+
+    std::vector<HitResult> hit_results;
+
+    float ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float fraction) override
+    {
+        HitResult hit_result;
+
+        hit_result.point = point;
+        hit_result.normal = normal;
+        hit_result.actor = reinterpret_cast<Actor*>(fixture->GetUserData().pointer);
+        hit_result.fraction = fraction;
+        hit_result.is_trigger = fixture->IsSensor();
+
+        if (!hit_result.actor)
+            return -1;
+
+        hit_results.emplace_back(hit_result);
+        return 1;
+    }
+};
+
+
+struct PhysicsOverlapCallback : b2QueryCallback {
+
+    const b2Shape* shape = nullptr;
+
+    b2Transform transform;
+
+    std::vector<Actor*> actors;
+
+    bool ReportFixture(b2Fixture *fixture) override
+    {
+        Actor* actor = reinterpret_cast<Actor*>(fixture->GetUserData().pointer);
+
+        if (!actor)
+            return true;
+
+        const b2Shape* fixture_shape = fixture->GetShape();
+
+        for (int32 child_index = 0; child_index < fixture_shape->GetChildCount(); ++child_index)
+        {
+            if (b2TestOverlap(shape, 0, fixture_shape, child_index, transform, fixture->GetBody()->GetTransform()))
+            {
+                actors.emplace_back(actor);
+                break;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif /* PhysicsManager_hpp */
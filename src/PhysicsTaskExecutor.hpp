@@ -0,0 +1,33 @@
+//
+//  PhysicsTaskExecutor.hpp
+//  blitzENGINE
+//
+
+#ifndef PhysicsTaskExecutor_hpp
+#define PhysicsTaskExecutor_hpp
+
+#include "box2d.h"
+#include "ThreadPool.hpp"
+
+/**
+ *  Lets b2World::Step hand its narrow phase and island solver to the ThreadPool.
+ */
+class PhysicsTaskExecutor : public b2TaskExecutor {
+public:
+    
+    
+    void ParallelFor(int32 count, int32 min_range, b2RangeTask *task) override;
+};
+
+
+inline void PhysicsTaskExecutor::ParallelFor(int32 count, int32 min_range, b2RangeTask *task)
+{
+    if (count <= 0)
+        return;
+    
+    ThreadPool::ParallelFor(static_cast<uint32_t>(count), static_cast<uint32_t>(min_range), [task](uint32_t begin, uint32_t end) {
+        task->Execute(static_cast<int32>(begin), static_cast<int32>(end));
+    });
+}
+
+#endif /* PhysicsTaskExecutor_hpp */
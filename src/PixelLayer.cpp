@@ -0,0 +1,173 @@
+//
+//  PixelLayer.cpp
+//  blitzENGINE
+//
+
+#include "PixelLayer.hpp"
+
+#include "Utilities.hpp"
+
+
+void PixelLayer::Init(SDL_Renderer *sdl_renderer, int width, int height)
+{
+    PixelLayer::width = width;
+    PixelLayer::height = height;
+
+    pixels.assign(static_cast<size_t>(width) * height, 0);
+
+    texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+
+    if (!texture)
+        ErrorExit("SDL_CreateTexture Error: " + std::string(SDL_GetError()));
+
+    SDL_BlendMode premultiplied_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                                        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+    // The software renderer has no custom blend modes, so it gets straight alpha converted at upload
+    premultiplied_blending = SDL_SetTextureBlendMode(texture, premultiplied_blend_mode) == 0;
+
+    if (!premultiplied_blending)
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+
+void PixelLayer::Draw(SDL_Renderer *sdl_renderer)
+{
+    if (!texture || dirty_rect.w == 0)
+    {
+        pixels_written = 0;
+        return;
+    }
+
+    const uint32_t* dirty_pixels = &pixels[static_cast<size_t>(dirty_rect.y) * width + dirty_rect.x];
+
+    if (premultiplied_blending)
+        SDL_UpdateTexture(texture, &dirty_rect, dirty_pixels, width * sizeof(uint32_t));
+    else
+    {
+        straight_alpha_pixels.resize(static_cast<size_t>(dirty_rect.w) * dirty_rect.h);
+
+        for (int row = 0; row < dirty_rect.h; ++row)
+        {
+            for (int column = 0; column < dirty_rect.w; ++column)
+            {
+                uint32_t color = dirty_pixels[static_cast<size_t>(row) * width + column];
+                uint32_t alpha = color >> 24;
+
+                if (alpha != 0 && alpha != 255)
+                {
+                    uint32_t red = std::min(255u, (((color >> 16) & 0xFF) * 255 + alpha / 2) / alpha);
+                    uint32_t green = std::min(255u, (((color >> 8) & 0xFF) * 255 + alpha / 2) / alpha);
+                    uint32_t blue = std::min(255u, ((color & 0xFF) * 255 + alpha / 2) / alpha);
+
+                    color = (alpha << 24) | (red << 16) | (green << 8) | blue;
+                }
+
+                straight_alpha_pixels[static_cast<size_t>(row) * dirty_rect.w + column] = color;
+            }
+        }
+
+        SDL_UpdateTexture(texture, &dirty_rect, straight_alpha_pixels.data(), dirty_rect.w * sizeof(uint32_t));
+    }
+
+    // The layer is in window pixels, so it ignores camera zoom
+    SDL_RenderSetScale(sdl_renderer, 1, 1);
+    SDL_RenderCopy(sdl_renderer, texture, &dirty_rect, &dirty_rect);
+
+    Discard();
+}
+
+
+void PixelLayer::Discard()
+{
+    for (int row = dirty_rect.y; row < dirty_rect.y + dirty_rect.h; ++row)
+    {
+        uint32_t* row_pixels = &pixels[static_cast<size_t>(row) * width + dirty_rect.x];
+        std::fill(row_pixels, row_pixels + dirty_rect.w, 0);
+    }
+
+    dirty_rect = { 0, 0, 0, 0 };
+    pixels_written = 0;
+}
+
+
+void PixelLayer::FillRect(int x, int y, int width, int height, uint32_t color)
+{
+    int min_x = std::max(x, 0);
+    int min_y = std::max(y, 0);
+    int max_x = std::min(x + width, PixelLayer::width) - 1;
+    int max_y = std::min(y + height, PixelLayer::height) - 1;
+
+    if (min_x > max_x || min_y > max_y)
+        return;
+
+    for (int row = min_y; row <= max_y; ++row)
+        BlendSpan(&pixels[static_cast<size_t>(row) * PixelLayer::width + min_x], max_x - min_x + 1, color);
+
+    MarkDirty(min_x, min_y, max_x, max_y);
+    pixels_written += static_cast<size_t>(max_x - min_x + 1) * (max_y - min_y + 1);
+}
+
+
+void PixelLayer::BlendSpan(uint32_t *destination, int count, uint32_t color)
+{
+    uint32_t alpha = color >> 24;
+
+    if (alpha == 255)
+    {
+        std::fill(destination, destination + count, color);
+        return;
+    }
+
+    if (color == 0)
+        return;
+
+    // Branch-free, so compilers vectorize it at -O3
+    for (int i = 0; i < count; ++i)
+        destination[i] = Blend(color, destination[i]);
+}
+
+
+void PixelLayer::cppImageDrawPixel(float x, float y, float r, float g, float b, float a)
+{
+    BlendPixel(static_cast<int>(x), static_cast<int>(y), PremultiplyColor(r, g, b, a));
+}
+
+
+void PixelLayer::cppImageDrawPixels(sol::table pixels, sol::optional<float> r, sol::optional<float> g, sol::optional<float> b, sol::optional<float> a)
+{
+    bool shared_color = r && g && b;
+    uint32_t color = shared_color ? PremultiplyColor(*r, *g, *b, a.value_or(255.0f)) : 0;
+    int stride = shared_color ? 2 : 6;
+
+    // Reads the array with the raw API, since a sol lookup per number would cost more than the blend
+    lua_State* L = pixels.lua_state();
+    pixels.push();
+
+    lua_Integer length = static_cast<lua_Integer>(lua_rawlen(L, -1));
+
+    for (lua_Integer i = 1; i + stride - 1 <= length; i += stride)
+    {
+        float values[6];
+
+        for (int field = 0; field < stride; ++field)
+        {
+            lua_rawgeti(L, -1, i + field);
+            values[field] = static_cast<float>(lua_tonumber(L, -1));
+            lua_pop(L, 1);
+        }
+
+        if (!shared_color)
+            color = PremultiplyColor(values[2], values[3], values[4], values[5]);
+
+        BlendPixel(static_cast<int>(values[0]), static_cast<int>(values[1]), color);
+    }
+
+    lua_pop(L, 1);
+}
+
+
+void PixelLayer::cppImageFillRect(float x, float y, float width, float height, float r, float g, float b, float a)
+{
+    FillRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height), PremultiplyColor(r, g, b, a));
+}
@@ -0,0 +1,165 @@
+//
+//  PixelLayer.hpp
+//  blitzENGINE
+//
+
+#ifndef PixelLayer_hpp
+#define PixelLayer_hpp
+
+#include "SDL2/SDL.h"
+#include "sol/sol.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ *  A screen-sized CPU framebuffer for per-pixel drawing, uploaded to a streaming texture once a frame.
+ *
+ *  Pixels are stored premultiplied and blended in the order they are drawn, so drawing is a
+ *  bounds check and a few integer ops per pixel. Only the bounding box of what was drawn this
+ *  frame is uploaded, copied and cleared, so an idle layer costs nothing.
+ */
+class PixelLayer {
+public:
+
+    /**
+     *  Creates the streaming texture. Called by Renderer::CreateWindow once the window size is known.
+     */
+    static void Init(SDL_Renderer *sdl_renderer, int width, int height);
+
+    /**
+     *  Uploads the pixels drawn this frame, copies them over the frame and clears the buffer for the next one.
+     */
+    static void Draw(SDL_Renderer *sdl_renderer);
+
+    /**
+     *  Throws away the pixels drawn this frame without uploading them.
+     */
+    static void Discard();
+
+
+    static void BlendPixel(int x, int y, uint32_t color);
+
+
+    static void FillRect(int x, int y, int width, int height, uint32_t color);
+
+
+    static uint32_t PremultiplyColor(float r, float g, float b, float a);
+
+
+    static size_t GetPixelsWritten();
+
+
+    static void cppImageDrawPixel(float x, float y, float r, float g, float b, float a);
+
+    /**
+     *  Draws a flat array of pixels from Lua.
+     *
+     *  With only the array, it holds x, y, r, g, b, a for each pixel. When a color is
+     *  passed too, the array holds just x, y pairs and every pixel uses that color.
+     */
+    static void cppImageDrawPixels(sol::table pixels, sol::optional<float> r, sol::optional<float> g, sol::optional<float> b, sol::optional<float> a);
+
+
+    static void cppImageFillRect(float x, float y, float width, float height, float r, float g, float b, float a);
+
+private:
+
+
+    static void BlendSpan(uint32_t *destination, int count, uint32_t color);
+
+
+    static void MarkDirty(int min_x, int min_y, int max_x, int max_y);
+
+
+    static uint32_t Blend(uint32_t source, uint32_t destination);
+
+
+    static inline std::vector<uint32_t> pixels;
+
+    /**
+     *  Scratch rows for renderers without premultiplied blending, which need straight alpha uploaded instead.
+     */
+    static inline std::vector<uint32_t> straight_alpha_pixels;
+
+
+    static inline SDL_Texture* texture = nullptr;
+
+
+    static inline SDL_Rect dirty_rect = { 0, 0, 0, 0 };
+
+
+    static inline size_t pixels_written = 0;
+
+
+    static inline int width = 0;
+
+
+    static inline int height = 0;
+
+
+    static inline bool premultiplied_blending = true;
+};
+
+
+inline size_t PixelLayer::GetPixelsWritten()    { return pixels_written; }
+
+
+inline uint32_t PixelLayer::PremultiplyColor(float r, float g, float b, float a)
+{
+    uint32_t alpha = static_cast<uint32_t>(std::clamp(a, 0.0f, 255.0f));
+    uint32_t red = (static_cast<uint32_t>(std::clamp(r, 0.0f, 255.0f)) * alpha + 127) / 255;
+    uint32_t green = (static_cast<uint32_t>(std::clamp(g, 0.0f, 255.0f)) * alpha + 127) / 255;
+    uint32_t blue = (static_cast<uint32_t>(std::clamp(b, 0.0f, 255.0f)) * alpha + 127) / 255;
+
+    return (alpha << 24) | (red << 16) | (green << 8) | blue;
+}
+
+
+inline uint32_t PixelLayer::Blend(uint32_t source, uint32_t destination)
+{
+    uint32_t inverse_alpha = 255 - (source >> 24);
+
+    // Scales two channels per multiply, then divides by 255 with rounding
+    uint32_t red_blue = (destination & 0x00FF00FF) * inverse_alpha + 0x00800080;
+    uint32_t alpha_green = ((destination >> 8) & 0x00FF00FF) * inverse_alpha + 0x00800080;
+
+    red_blue = ((red_blue + ((red_blue >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    alpha_green = ((alpha_green + ((alpha_green >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    return source + (red_blue | (alpha_green << 8));
+}
+
+
+inline void PixelLayer::BlendPixel(int x, int y, uint32_t color)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return;
+
+    uint32_t &destination = pixels[static_cast<size_t>(y) * width + x];
+    destination = Blend(color, destination);
+
+    MarkDirty(x, y, x, y);
+    pixels_written++;
+}
+
+
+inline void PixelLayer::MarkDirty(int min_x, int min_y, int max_x, int max_y)
+{
+    if (dirty_rect.w == 0)
+    {
+        dirty_rect = { min_x, min_y, max_x - min_x + 1, max_y - min_y + 1 };
+        return;
+    }
+
+    int dirty_max_x = std::max(dirty_rect.x + dirty_rect.w - 1, max_x);
+    int dirty_max_y = std::max(dirty_rect.y + dirty_rect.h - 1, max_y);
+
+    dirty_rect.x = std::min(dirty_rect.x, min_x);
+    dirty_rect.y = std::min(dirty_rect.y, min_y);
+    dirty_rect.w = dirty_max_x - dirty_rect.x + 1;
+    dirty_rect.h = dirty_max_y - dirty_rect.y + 1;
+}
+
+#endif /* PixelLayer_hpp */
@@ -0,0 +1,85 @@
+//
+//  Profiler.cpp
+//  blitzENGINE
+//
+
+#include "Profiler.hpp"
+
+#include <cstdio>
+
+
+void Profiler::SetEnabled(bool enabled)
+{
+    if (enabled && !Profiler::enabled)
+    {
+        events.resize(event_capacity);
+        next_event = 0;
+        wrapped = false;
+    }
+
+    Profiler::enabled = enabled;
+}
+
+
+const char* Profiler::Intern(const std::string &name)
+{
+    // Looked up first, since emplace builds a node even when the name is already there
+    auto interned_name_it = interned_names.find(name);
+
+    if (interned_name_it != interned_names.end())
+        return interned_name_it->c_str();
+
+    return interned_names.emplace(name).first->c_str();
+}
+
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    FILE* file_pointer = std::fopen(path.c_str(), "w");
+
+    if (!file_pointer)
+        return false;
+
+    std::fprintf(file_pointer, "{\"traceEvents\":[\n");
+    std::fprintf(file_pointer, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}}");
+
+    size_t event_count = wrapped ? event_capacity : next_event;
+    size_t first_event = wrapped ? next_event : 0;
+
+    for (size_t i = 0; i < event_count; ++i)
+    {
+        const ProfileEvent &event = events[(first_event + i) % event_capacity];
+
+        std::fprintf(file_pointer, ",\n{\"name\":\"");
+
+        // Names come from component types and scene scripts, so escape anything JSON can't hold raw
+        for (const char* c = event.name; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                std::fputc('\\', file_pointer);
+
+            if (static_cast<unsigned char>(*c) >= 0x20)
+                std::fputc(*c, file_pointer);
+        }
+
+        std::fprintf(file_pointer, "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                     event.start_time / 1000.0, event.duration / 1000.0);
+    }
+
+    std::fprintf(file_pointer, "\n]}\n");
+    std::fclose(file_pointer);
+
+    return true;
+}
+
+
+void Profiler::cppDebugProfile(bool enabled)
+{
+    SetEnabled(enabled);
+}
+
+
+bool Profiler::cppDebugSaveProfile(sol::optional<std::string> path)
+{
+    return WriteChromeTrace(path.value_or("profile.json"));
+}
@@ -0,0 +1,170 @@
+//
+//  Profiler.hpp
+//  blitzENGINE
+//
+
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include "sol/sol.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ *  Records nested, named timings on the main thread into a fixed-size ring buffer.
+ *
+ *  Nothing is recorded until profiling is turned on, either with --profile <path> or
+ *  Debug.Profile(true) from Lua. Once the ring fills, the oldest timings are overwritten,
+ *  so a trace always holds the most recent frames. Traces are written in the Chrome
+ *  trace event format, which both chrome://tracing and Perfetto open.
+ */
+class Profiler {
+public:
+
+    /**
+     *  Turning profiling on clears anything recorded by an earlier session.
+     */
+    static void SetEnabled(bool enabled);
+
+
+    static bool IsEnabled();
+
+    /**
+     *  @returns    nanoseconds since the profiler was first used
+     */
+    static uint64_t Now();
+
+
+    static void Record(const char *name, uint64_t start_time, uint64_t end_time);
+
+    /**
+     *  Returns a pointer to a copy of name that lives as long as the program,
+     *  so timings can outlive whatever they were named after.
+     */
+    static const char* Intern(const std::string &name);
+
+
+    static bool WriteChromeTrace(const std::string &path);
+
+
+    static void cppDebugProfile(bool enabled);
+
+
+    static bool cppDebugSaveProfile(sol::optional<std::string> path);
+
+private:
+
+    struct ProfileEvent {
+
+        const char* name;
+
+        uint64_t start_time;
+
+        uint64_t duration;
+    };
+
+
+    static inline std::vector<ProfileEvent> events;
+
+
+    static inline std::unordered_set<std::string> interned_names;
+
+
+    static inline const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+
+    static inline size_t next_event = 0;
+
+
+    static inline bool wrapped = false;
+
+
+    static inline bool enabled = false;
+
+
+    static inline const size_t event_capacity = 1 << 18;
+};
+
+/**
+ *  Times the enclosing scope under name while the Profiler is enabled.
+ *
+ *  When profiling is off this is a single branch on construction and destruction.
+ */
+class ProfileScope {
+public:
+
+
+    explicit ProfileScope(const char *name);
+
+
+    explicit ProfileScope(const std::string &name);
+
+
+    ~ProfileScope();
+
+
+    ProfileScope(const ProfileScope &other) = delete;
+
+
+    ProfileScope& operator=(const ProfileScope &other) = delete;
+
+private:
+
+
+    const char* name = nullptr;
+
+
+    uint64_t start_time = 0;
+};
+
+
+inline bool Profiler::IsEnabled()       { return enabled; }
+
+
+inline uint64_t Profiler::Now()         { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count(); }
+
+
+inline void Profiler::Record(const char *name, uint64_t start_time, uint64_t end_time)
+{
+    events[next_event] = { name, start_time, end_time - start_time };
+
+    if (++next_event == event_capacity)
+    {
+        next_event = 0;
+        wrapped = true;
+    }
+}
+
+
+inline ProfileScope::ProfileScope(const char *name)
+{
+    if (Profiler::IsEnabled())
+    {
+        this->name = name;
+        start_time = Profiler::Now();
+    }
+}
+
+
+inline ProfileScope::ProfileScope(const std::string &name)
+{
+    if (Profiler::IsEnabled())
+    {
+        this->name = Profiler::Intern(name);
+        start_time = Profiler::Now();
+    }
+}
+
+
+inline ProfileScope::~ProfileScope()
+{
+    // Checks enabled again, since a scope can outlive a call to Debug.Profile(false)
+    if (name && Profiler::IsEnabled())
+        Profiler::Record(name, start_time, Profiler::Now());
+}
+
+#endif /* Profiler_hpp */
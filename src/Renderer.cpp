@@ -8,23 +8,24 @@
 #include "Renderer.hpp"
 
 #include "Engine.h"
+#include "LayerManager.hpp"
+#include "PixelLayer.hpp"
+#include "Profiler.hpp"
 #include <cmath>
 
 const bool ImageDrawRequestComp(const ImageDrawRequest &lhs, const ImageDrawRequest &rhs) { return lhs.sorting_order < rhs.sorting_order; }
 
-const bool PixelDrawRequestComp(const PixelDrawRequest &lhs, const PixelDrawRequest &rhs)
-{
-    if (lhs.r != rhs.r) return lhs.r < rhs.r;
-    if (lhs.g != rhs.g) return lhs.g < rhs.g;
-    if (lhs.b != rhs.b) return lhs.b < rhs.b;
-    if (lhs.a != rhs.a) return lhs.a < rhs.a;
-    return lhs.order < rhs.order; // Ensure drawing order for same location
-}
-
-static inline uint32_t pixels_requested = 0;
+const bool GeometryDrawRequestComp(const GeometryDrawRequest &lhs, const GeometryDrawRequest &rhs) { return lhs.sorting_order < rhs.sorting_order; }
 
 void Renderer::Init()
 {
+    // Chosen before any subsystem starts, since SDL_mixer opens audio with the same hint later
+    if (headless)
+    {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    }
+    
     SDL_Init(SDL_INIT_VIDEO);
     if (SDL_Init(SDL_INIT_VIDEO) != 0)
         ErrorExit("SDL_Init Error: " + std::string(SDL_GetError()));
@@ -42,34 +43,74 @@ void Renderer::Init()
 
 void Renderer::CreateWindow()
 {
-    game_window = SDL_CreateWindow(game_title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, camera_dimensions.x, camera_dimensions.y, SDL_WINDOW_SHOWN);
-    sdl_renderer = SDL_CreateRenderer(game_window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
+    Uint32 window_flags = headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
+    Uint32 renderer_flags = headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED;
+    
+    // Headless runs still get a software renderer, so images load and can be measured as usual
+    game_window = SDL_CreateWindow(game_title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, camera_dimensions.x, camera_dimensions.y, window_flags);
+    sdl_renderer = SDL_CreateRenderer(game_window, -1, renderer_flags);
+    
+    if (!sdl_renderer)
+        ErrorExit("SDL_CreateRenderer Error: " + std::string(SDL_GetError()));
+    
+    PixelLayer::Init(sdl_renderer, camera_dimensions.x, camera_dimensions.y);
+    
     SDL_SetRenderDrawColor(sdl_renderer, clear_color_r, clear_color_g, clear_color_b, SDL_ALPHA_OPAQUE);
     SDL_RenderClear(sdl_renderer);
 }
 
 void Renderer::DrawFrame()
 {
+    LayerManager::PrepareLayers();
+    
+    DrawLayers(true);
     DrawScreenSpace();
     DrawUI();
+    DrawLayers(false);
     DrawText();
     DrawPixels();
 }
 
+void Renderer::DiscardFrame()
+{
+    screenspace_render_requests.clear();
+    ui_render_requests.clear();
+    geometry_render_requests.clear();
+    text_render_queue = std::queue<TextDrawRequest>();
+    LayerManager::Discard();
+    PixelLayer::Discard();
+}
+
 void Renderer::DrawScreenSpace()
 {
-    if (screenspace_render_requests.empty())
+    ProfileScope draw_scope("DrawScreenSpace");
+    
+    if (screenspace_render_requests.empty() && geometry_render_requests.empty())
         return;
     
     SDL_RenderSetScale(sdl_renderer, zoom_factor, zoom_factor);
     
     std::stable_sort(screenspace_render_requests.begin(), screenspace_render_requests.end(), ImageDrawRequestComp);
+    std::stable_sort(geometry_render_requests.begin(), geometry_render_requests.end(), GeometryDrawRequestComp);
     
-    for (ImageDrawRequest &screenspace_render_request : screenspace_render_requests)
+    ComputeDrawRects(screenspace_render_requests);
+    
+    // Meshes are merged into the image order, drawing after images with the same sorting order
+    size_t geometry_index = 0;
+    
+    for (size_t i = 0; i < screenspace_render_requests.size(); ++i)
     {
-        DrawImage(screenspace_render_request);
+        while (geometry_index < geometry_render_requests.size() && geometry_render_requests[geometry_index].sorting_order < screenspace_render_requests[i].sorting_order)
+            DrawGeometry(geometry_render_requests[geometry_index++]);
+        
+        DrawImage(screenspace_render_requests[i], i);
     }
     
+    while (geometry_index < geometry_render_requests.size())
+        DrawGeometry(geometry_render_requests[geometry_index++]);
+    
+    geometry_render_requests.clear();
+    
     for (ImageDrawRequest &screenspace_render_request : screenspace_render_requests)
     {
         SDL_SetTextureColorMod(screenspace_render_request.image->texture, 255, 255, 255);
@@ -83,14 +124,18 @@ void Renderer::DrawScreenSpace()
 
 void Renderer::DrawUI()
 {
+    ProfileScope draw_scope("DrawUI");
+    
     if (ui_render_requests.empty())
         return;
     
     std::stable_sort(ui_render_requests.begin(), ui_render_requests.end(), ImageDrawRequestComp);
     
-    for (ImageDrawRequest &ui_render_request : ui_render_requests)
+    ComputeDrawRects(ui_render_requests);
+    
+    for (size_t i = 0; i < ui_render_requests.size(); ++i)
     {
-        DrawImage(ui_render_request);
+        DrawImage(ui_render_requests[i], i);
     }
     
     for (ImageDrawRequest &ui_render_request : screenspace_render_requests)
@@ -105,6 +150,8 @@ void Renderer::DrawUI()
 
 void Renderer::DrawText()
 {
+    ProfileScope draw_scope("DrawText");
+    
     while (!text_render_queue.empty())
     {
         TextDrawRequest current_request = text_render_queue.front();
@@ -116,71 +163,100 @@ void Renderer::DrawText()
     }
 }
 
-void Renderer::DrawPixels()
+void Renderer::DrawLayers(bool behind_scene)
 {
-    if (pixel_render_requests.empty())
-        return;
-    
-    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_BLEND);
+    ProfileScope draw_scope("DrawLayers");
     
-    std::stable_sort(pixel_render_requests.begin(), pixel_render_requests.end(), PixelDrawRequestComp);
-    
-    SDL_Color current_color = {pixel_render_requests.front().r, pixel_render_requests.front().g, pixel_render_requests.front().b, pixel_render_requests.front().a};
-    
-    std::vector<SDL_Point> batch_points; // Temporary storage for batch drawing
-
-    for (const PixelDrawRequest &current_request : pixel_render_requests)
+    for (const std::unique_ptr<RenderLayer> &layer : LayerManager::GetLayers())
     {
-        // If color changes draw the batch and start a new one
-        if ((current_request.r != current_color.r || current_request.g != current_color.g ||
-             current_request.b != current_color.b || current_request.a != current_color.a))
+        if ((layer->order < 0) != behind_scene)
+            continue;
+        
+        if (!layer->texture)
         {
-            SDL_SetRenderDrawColor(sdl_renderer, current_color.r, current_color.g, current_color.b, current_color.a);
-            SDL_RenderDrawPoints(sdl_renderer, batch_points.data(), static_cast<int>(batch_points.size()));
-            batch_points.clear();
+            DrawLayerContents(*layer);
+            continue;
+        }
+        
+        if (layer->needs_redraw)
+        {
+            SDL_SetRenderTarget(sdl_renderer, layer->texture);
+            SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 0);
+            SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_NONE);
+            SDL_RenderClear(sdl_renderer);
+            
+            DrawLayerContents(*layer);
+            
+            SDL_SetRenderTarget(sdl_renderer, nullptr);
+            ResetDrawState();
             
-            // Update current color
-            current_color = {current_request.r, current_request.g, current_request.b, current_request.a};
+            layer->needs_redraw = false;
         }
         
-        // Add pixel to the batch
-        batch_points.push_back(SDL_Point{current_request.x, current_request.y});
+        if (!layer->drawn_ui_requests.empty() || !layer->drawn_text_requests.empty())
+            SDL_RenderCopy(sdl_renderer, layer->texture, NULL, NULL);
     }
+}
 
-    // Draw any remaining pixels in the final batch
-    if (!batch_points.empty())
+void Renderer::DrawLayerContents(RenderLayer &layer)
+{
+    if (!layer.drawn_ui_requests.empty())
     {
-        SDL_SetRenderDrawColor(sdl_renderer, current_color.r, current_color.g, current_color.b, current_color.a);
-        SDL_RenderDrawPoints(sdl_renderer, batch_points.data(), static_cast<int>(batch_points.size()));
+        ComputeDrawRects(layer.drawn_ui_requests);
+        
+        for (size_t i = 0; i < layer.drawn_ui_requests.size(); ++i)
+            DrawImage(layer.drawn_ui_requests[i], i);
     }
     
-    pixel_render_requests.clear();
+    for (const TextDrawRequest &text_request : layer.drawn_text_requests)
+    {
+        SDL_Rect renderQuad{text_request.x, text_request.y, text_request.image->width, text_request.image->height};
+        SDL_RenderCopy(sdl_renderer, text_request.image->texture, NULL, &renderQuad);
+    }
+}
+
+void Renderer::DrawPixels()
+{
+    ProfileScope draw_scope("DrawPixels");
     
-    SDL_SetRenderDrawColor(sdl_renderer, clear_color_r, clear_color_g, clear_color_b, SDL_ALPHA_OPAQUE);
-    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_NONE);
+    PixelLayer::Draw(sdl_renderer);
 }
 
-void Renderer::DrawImage(ImageDrawRequest current_request)
+void Renderer::ComputeDrawRects(const std::vector<ImageDrawRequest> &image_draw_requests)
 {
-    float pixels_per_meter = 1.0f + (current_request.screen_space_mod * PIXELS_PER_METER_ADDEND);
+    ProfileScope compute_scope("ComputeDrawRects");
     
-    glm::vec2 final_rendering_position = glm::vec2(current_request.x, current_request.y) - (Engine::GetCameraPosition() * current_request.screen_space_mod);
+    draw_rect_batch.Clear();
+    draw_rect_batch.Reserve(image_draw_requests.size());
     
-    SDL_Rect dstrect;
-    dstrect.w = current_request.image->width;
-    dstrect.h = current_request.image->height;
+    for (const ImageDrawRequest &image_draw_request : image_draw_requests)
+    {
+        draw_rect_batch.Add(image_draw_request.x, image_draw_request.y, image_draw_request.image->width, image_draw_request.image->height,
+                            image_draw_request.scale_x, image_draw_request.scale_y, image_draw_request.pivot_x, image_draw_request.pivot_y,
+                            image_draw_request.screen_space_mod);
+    }
     
-    bool flip_x = current_request.scale_x < 0.0f;
-    bool flip_y = current_request.scale_y < 0.0f;
-    SDL_RendererFlip flip = GetRendererFlip(flip_x, flip_y);
+    glm::vec2 camera_position = Engine::GetCameraPosition();
     
-    dstrect.w *= std::abs(current_request.scale_x);
-    dstrect.h *= std::abs(current_request.scale_y);
+    DrawRectCamera camera;
+    camera.x = camera_position.x;
+    camera.y = camera_position.y;
+    camera.width = camera_dimensions.x;
+    camera.height = camera_dimensions.y;
+    camera.zoom_factor = zoom_factor;
+    camera.pixels_per_meter_addend = PIXELS_PER_METER_ADDEND;
     
-    SDL_Point center = {static_cast<int>(current_request.pivot_x * dstrect.w), static_cast<int>(current_request.pivot_y * dstrect.h)};
+    draw_rect_batch.Compute(camera);
+}
+
+void Renderer::DrawImage(const ImageDrawRequest &current_request, size_t batch_index)
+{
+    SDL_Rect dstrect{draw_rect_batch.rect_x[batch_index], draw_rect_batch.rect_y[batch_index], draw_rect_batch.rect_w[batch_index], draw_rect_batch.rect_h[batch_index]};
+    SDL_Point center{draw_rect_batch.center_x[batch_index], draw_rect_batch.center_y[batch_index]};
     
-    dstrect.x = static_cast<int>(final_rendering_position.x *  pixels_per_meter + camera_dimensions.x * 0.5f * (1.0f / zoom_factor) * current_request.screen_space_mod - center.x * current_request.screen_space_mod);
-    dstrect.y = static_cast<int>(final_rendering_position.y *  pixels_per_meter + camera_dimensions.y * 0.5f * (1.0f / zoom_factor) * current_request.screen_space_mod - center.y * current_request.screen_space_mod);
+    bool flip_x = current_request.scale_x < 0.0f;
+    bool flip_y = current_request.scale_y < 0.0f;
+    SDL_RendererFlip flip = GetRendererFlip(flip_x, flip_y);
     
     SDL_Rect screen_rect;
     
@@ -202,19 +278,27 @@ void Renderer::DrawImage(ImageDrawRequest current_request)
     SDL_RenderCopyEx(sdl_renderer, current_request.image->texture, NULL, &dstrect, static_cast<double>(current_request.rotation_degrees), &center, flip);
 }
 
-void Renderer::cppImageDrawPixel(float _x, float _y, float _r, float _g, float _b, float _a)
+void Renderer::DrawGeometry(GeometryDrawRequest &current_request)
 {
-    int x = static_cast<int>(_x);
-    int y = static_cast<int>(_y);
-
-    Uint8 r = static_cast<Uint8>(_r);
-    Uint8 g = static_cast<Uint8>(_g);
-    Uint8 b = static_cast<Uint8>(_b);
-    Uint8 a = static_cast<Uint8>(_a);
+    if (current_request.index_count == 0)
+        return;
+    
+    glm::vec2 camera_position = Engine::GetCameraPosition();
+    float pixels_per_meter = 1.0f + PIXELS_PER_METER_ADDEND;
+    
+    float offset_x = camera_dimensions.x * 0.5f * (1.0f / zoom_factor) - camera_position.x * pixels_per_meter;
+    float offset_y = camera_dimensions.y * 0.5f * (1.0f / zoom_factor) - camera_position.y * pixels_per_meter;
+    
+    for (SDL_Vertex &vertex : *current_request.vertices)
+    {
+        vertex.position.x += offset_x;
+        vertex.position.y += offset_y;
+    }
     
-    PixelDrawRequest pixel_draw_req = {pixels_requested++, x, y, r, g, b, a};
+    SDL_Texture* texture = current_request.image ? current_request.image->texture : nullptr;
     
-    pixel_render_requests.push_back(pixel_draw_req);
+    SDL_RenderGeometry(sdl_renderer, texture, current_request.vertices->data(), static_cast<int>(current_request.vertices->size()),
+                       current_request.indices->data(), current_request.index_count);
 }
 
 SDL_RendererFlip Renderer::GetRendererFlip(bool horizontalFlip, bool verticalFlip)
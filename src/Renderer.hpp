@@ -13,8 +13,10 @@
 #define DEBUG_MODE false
 
 #include "Actor.hpp"
+#include "DrawRectBatch.hpp"
 #include "glm.hpp"
 #include "Image.hpp"
+#include "NativeTween.hpp"
 #include "SDL2/SDL.h"
 #include "SDL2_ttf/SDL_ttf.h"
 
@@ -56,19 +58,24 @@ struct ImageDrawRequest
     ImageDrawRequest() {}
 };
 
-struct PixelDrawRequest
+/**
+ *  A triangle mesh drawn in scene space with one SDL_RenderGeometry call.
+ *
+ *  Vertex positions are in scene pixels (meters times pixels per meter); the renderer
+ *  moves them into view for the camera when the request is drawn.
+ */
+struct GeometryDrawRequest
 {
-    uint32_t order;
+    std::shared_ptr<Image> image;
     
-    int x = 0;
-    int y = 0;
+    std::shared_ptr<std::vector<SDL_Vertex>> vertices;
+    std::shared_ptr<const std::vector<int>> indices;
     
-    Uint8 r = 255;
-    Uint8 g = 255;
-    Uint8 b = 255;
-    Uint8 a = 255;
+    int index_count = 0;
+    uint16_t sorting_order = 0;
 };
 
+struct RenderLayer;
 
 class Renderer
 {
@@ -78,6 +85,15 @@ public:
     
     static void Init();
     
+    /**
+     *  Runs SDL on its dummy video and audio drivers with a hidden window and a software
+     *  renderer, so the engine works on machines without a display. Must be called before Init.
+     */
+    static void SetHeadless(bool headless);
+    
+    
+    static bool IsHeadless();
+    
     
     static void CreateWindow();
     
@@ -90,6 +106,16 @@ public:
     
     static void DrawFrame();
     
+    /**
+     *  Drops every draw request queued this frame without submitting it to SDL.
+     */
+    static void DiscardFrame();
+    
+    /**
+     *  Restores the clear color and opaque blending after drawing straight to the SDL renderer.
+     */
+    static void ResetDrawState();
+    
     
     static SDL_Renderer* GetSDLRenderer();
     
@@ -130,7 +156,7 @@ public:
     static float cppCameraGetZoom();
     
     
-    static void cppImageDrawPixel(float _x, float _y, float _r, float _g, float _b, float _a);
+    static NativeTween cppCameraTweenZoom(float new_zoom_factor, float duration);
     
     
     static inline std::vector<ImageDrawRequest> screenspace_render_requests;
@@ -139,10 +165,10 @@ public:
     static inline std::vector<ImageDrawRequest> ui_render_requests;
     
     
-    static inline std::queue<TextDrawRequest> text_render_queue;
+    static inline std::vector<GeometryDrawRequest> geometry_render_requests;
     
     
-    static inline std::vector<PixelDrawRequest> pixel_render_requests;
+    static inline std::queue<TextDrawRequest> text_render_queue;
 
 private:
     
@@ -158,8 +184,25 @@ private:
     
     static void DrawPixels();
     
+    /**
+     *  Composites the layers beneath the scene or the ones above the UI, redrawing any that changed.
+     */
+    static void DrawLayers(bool behind_scene);
+    
+    
+    static void DrawLayerContents(RenderLayer &layer);
+    
+    
+    /**
+     *  Fills draw_rect_batch with the destination rects and pivots of already sorted requests.
+     */
+    static void ComputeDrawRects(const std::vector<ImageDrawRequest> &image_draw_requests);
     
-    static void DrawImage(ImageDrawRequest image_draw_request);
+    
+    static void DrawImage(const ImageDrawRequest &image_draw_request, size_t batch_index);
+    
+    
+    static void DrawGeometry(GeometryDrawRequest &geometry_draw_request);
     
     
     static SDL_RendererFlip GetRendererFlip(bool horizontalFlip, bool verticalFlip);
@@ -180,6 +223,9 @@ private:
     static inline glm::ivec2 camera_dimensions;
     
     
+    static inline DrawRectBatch draw_rect_batch;
+    
+    
     static inline int clear_color_r;
     
     
@@ -188,12 +234,28 @@ private:
     
     static inline int clear_color_b;
     
+    
+    static inline bool headless = false;
+    
 };
 
 
+inline void Renderer::SetHeadless(bool headless)                        { Renderer::headless = headless; }
+
+
+inline bool Renderer::IsHeadless()                                      { return headless; }
+
+
 inline void Renderer::ClearFrame()                                      { SDL_RenderClear(sdl_renderer); }
 
 
+inline void Renderer::ResetDrawState()
+{
+    SDL_SetRenderDrawColor(sdl_renderer, clear_color_r, clear_color_g, clear_color_b, SDL_ALPHA_OPAQUE);
+    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_NONE);
+}
+
+
 inline void Renderer::PresentFrame()                                    { SDL_RenderPresent(sdl_renderer); }
 
 
@@ -221,6 +283,12 @@ inline void Renderer::cppCameraSetZoom(float new_zoom_factor)           { zoom_f
 inline float Renderer::cppCameraGetZoom()                               { return zoom_factor; }
 
 
+inline NativeTween Renderer::cppCameraTweenZoom(float new_zoom_factor, float duration)
+{
+    return NativeTweenManager::CreateFloat(&zoom_factor, zoom_factor, new_zoom_factor, duration);
+}
+
+
 inline SDL_Renderer* Renderer::GetSDLRenderer()                         { return sdl_renderer; }
 
 
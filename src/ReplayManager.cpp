@@ -0,0 +1,356 @@
+//
+//  ReplayManager.cpp
+//  blitzENGINE
+//
+
+#include "ReplayManager.hpp"
+
+#include "Rigidbody.hpp"
+#include "Utilities.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+
+void ReplayManager::StartRecording(const std::string &path, uint32_t seed, float timestep)
+{
+    record_stream.open(path, std::ios::out | std::ios::trunc);
+
+    if (!record_stream.is_open())
+        ErrorExit("error: could not open replay file " + path + " for writing");
+
+    ReplayManager::seed = seed;
+    recorded_timestep = timestep;
+    recording = true;
+
+    record_stream << "blitzreplay 1\n";
+    record_stream << "timestep " << std::setprecision(9) << timestep << '\n';
+    record_stream << "seed " << seed << '\n';
+}
+
+
+void ReplayManager::StartPlayback(const std::string &path)
+{
+    std::ifstream playback_stream(path);
+
+    if (!playback_stream.is_open())
+        ErrorExit("error: replay file " + path + " missing");
+
+    std::string line;
+    std::getline(playback_stream, line);
+
+    if (line != "blitzreplay 1")
+        ErrorExit("error: " + path + " is not a replay file");
+
+    while (std::getline(playback_stream, line))
+    {
+        std::istringstream line_stream(line);
+        std::string tag;
+        line_stream >> tag;
+
+        if (tag == "timestep")
+            line_stream >> recorded_timestep;
+        else if (tag == "seed")
+            line_stream >> seed;
+        else if (tag == "H")
+        {
+            uint64_t hash_frame = 0;
+            uint64_t hash = 0;
+            line_stream >> hash_frame >> std::hex >> hash;
+
+            if (hash_frame != playback_hashes.size())
+                ErrorExit("error: replay file " + path + " skips frame " + std::to_string(playback_hashes.size()));
+
+            playback_hashes.emplace_back(hash);
+        }
+        else if (tag == "E")
+        {
+            uint64_t event_frame = 0;
+            SDL_Event e;
+            std::memset(&e, 0, sizeof(e));
+
+            line_stream >> event_frame >> e.type;
+
+            switch (e.type)
+            {
+                case SDL_KEYDOWN:
+                case SDL_KEYUP: {
+                    int scancode = 0;
+                    int repeat = 0;
+                    line_stream >> scancode >> repeat;
+                    e.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+                    e.key.repeat = static_cast<Uint8>(repeat);
+                    break;
+                }
+
+                case SDL_MOUSEBUTTONDOWN:
+                case SDL_MOUSEBUTTONUP: {
+                    int button = 0;
+                    line_stream >> button >> e.button.x >> e.button.y;
+                    e.button.button = static_cast<Uint8>(button);
+                    break;
+                }
+
+                case SDL_MOUSEMOTION:
+                    line_stream >> e.motion.x >> e.motion.y;
+                    break;
+
+                case SDL_MOUSEWHEEL:
+                    line_stream >> e.wheel.preciseY;
+                    break;
+
+                case SDL_CONTROLLERBUTTONDOWN:
+                case SDL_CONTROLLERBUTTONUP: {
+                    int button = 0;
+                    line_stream >> button;
+                    e.cbutton.button = static_cast<Uint8>(button);
+                    break;
+                }
+
+                default:
+                    ErrorExit("error: unknown event type in replay file " + path);
+            }
+
+            playback_events.emplace_back(event_frame, e);
+        }
+    }
+
+    playing_back = true;
+    playback_start_time = std::chrono::steady_clock::now();
+}
+
+
+void ReplayManager::RecordEvent(const SDL_Event &e)
+{
+    if (!recording)
+        return;
+
+    std::ostringstream line;
+    line << "E " << frame << ' ' << e.type << ' ';
+
+    switch (e.type)
+    {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            line << e.key.keysym.scancode << ' ' << static_cast<int>(e.key.repeat);
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            line << static_cast<int>(e.button.button) << ' ' << e.button.x << ' ' << e.button.y;
+            break;
+
+        case SDL_MOUSEMOTION:
+            line << e.motion.x << ' ' << e.motion.y;
+            break;
+
+        case SDL_MOUSEWHEEL:
+            line << std::setprecision(9) << e.wheel.preciseY;
+            break;
+
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            line << static_cast<int>(e.cbutton.button);
+            break;
+
+        // Anything else never reaches Input, so it can't affect the simulation
+        default:
+            return;
+    }
+
+    record_stream << line.str() << '\n';
+}
+
+
+bool ReplayManager::PollEvent(SDL_Event &e)
+{
+    if (!playing_back || playback_events.empty() || playback_events.front().first != frame)
+        return false;
+
+    e = playback_events.front().second;
+    playback_events.pop_front();
+
+    return true;
+}
+
+
+void ReplayManager::EndFrame(Scene &scene)
+{
+    if (!recording && !playing_back)
+        return;
+
+    uint64_t hash = HashState(scene);
+
+    if (recording)
+        record_stream << "H " << frame << ' ' << std::hex << hash << std::dec << '\n';
+
+    if (playing_back && frame < playback_hashes.size() && playback_hashes[frame] != hash)
+    {
+        std::cout << "replay desync at frame " << frame << ": expected " << std::hex << playback_hashes[frame] << ", got " << hash << std::dec << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    frame++;
+}
+
+
+void ReplayManager::Finish()
+{
+    if (recording)
+    {
+        record_stream.close();
+        recording = false;
+    }
+
+    if (playing_back)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - playback_start_time).count();
+
+        std::cout << "replay verified: " << frame << " frames in " << seconds << "s ("
+                  << (frame * recorded_timestep) / std::max(seconds, 1e-9) << "x real time)" << std::endl;
+
+        playing_back = false;
+    }
+}
+
+
+uint64_t ReplayManager::HashState(Scene &scene)
+{
+    uint64_t hash = fnv_offset_basis;
+
+    if (Rigidbody::GetWorld())
+    {
+        for (b2Body* body = Rigidbody::GetWorld()->GetBodyList(); body; body = body->GetNext())
+        {
+            b2Vec2 position = body->GetPosition();
+            b2Vec2 linear_velocity = body->GetLinearVelocity();
+            float angle = body->GetAngle();
+            float angular_velocity = body->GetAngularVelocity();
+            bool awake = body->IsAwake();
+
+            HashBytes(hash, &position, sizeof(position));
+            HashBytes(hash, &linear_velocity, sizeof(linear_velocity));
+            HashBytes(hash, &angle, sizeof(angle));
+            HashBytes(hash, &angular_velocity, sizeof(angular_velocity));
+            HashBytes(hash, &awake, sizeof(awake));
+        }
+    }
+
+    for (auto &[uuid, actor] : scene.actors_by_uuid)
+    {
+        HashBytes(hash, &uuid, sizeof(uuid));
+        HashString(hash, actor->cppActorGetName());
+
+        for (auto &[key, component] : actor->actor_components)
+        {
+            bool enabled = component->IsEnabled();
+
+            HashString(hash, key);
+            HashBytes(hash, &enabled, sizeof(enabled));
+
+            sol::object component_ref = component->GetComponentRef();
+
+            if (component_ref.get_type() == sol::type::table)
+                HashLuaTable(hash, component_ref.as<sol::table>(), 0);
+        }
+    }
+
+    return hash;
+}
+
+
+void ReplayManager::HashBytes(uint64_t &hash, const void *data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= fnv_prime;
+    }
+}
+
+
+void ReplayManager::HashString(uint64_t &hash, const std::string &value)
+{
+    HashBytes(hash, value.data(), value.size());
+
+    // Terminate each string so "ab","c" and "a","bc" hash differently
+    unsigned char terminator = 0;
+    HashBytes(hash, &terminator, sizeof(terminator));
+}
+
+
+void ReplayManager::HashLuaTable(uint64_t &hash, const sol::table &table, uint32_t depth)
+{
+    if (depth >= max_table_depth)
+        return;
+
+    // pairs() order depends on insertion history, so sort keys (numbers first) before hashing
+    std::vector<std::pair<sol::object, sol::object>> fields;
+
+    for (auto &field : table)
+    {
+        sol::type key_type = field.first.get_type();
+
+        if (key_type == sol::type::number || key_type == sol::type::string)
+            fields.emplace_back(field.first, field.second);
+    }
+
+    std::sort(fields.begin(), fields.end(), [](const auto &lhs, const auto &rhs) {
+        bool lhs_is_number = lhs.first.get_type() == sol::type::number;
+        bool rhs_is_number = rhs.first.get_type() == sol::type::number;
+
+        if (lhs_is_number != rhs_is_number)
+            return lhs_is_number;
+
+        if (lhs_is_number)
+            return lhs.first.template as<double>() < rhs.first.template as<double>();
+
+        return lhs.first.template as<std::string>() < rhs.first.template as<std::string>();
+    });
+
+    for (auto &[key, value] : fields)
+    {
+        sol::type value_type = value.get_type();
+
+        if (key.get_type() == sol::type::number)
+        {
+            double number_key = key.as<double>();
+            HashBytes(hash, &number_key, sizeof(number_key));
+        }
+        else
+            HashString(hash, key.as<std::string>());
+
+        HashBytes(hash, &value_type, sizeof(value_type));
+
+        switch (value_type)
+        {
+            case sol::type::number: {
+                double number = value.as<double>();
+                HashBytes(hash, &number, sizeof(number));
+                break;
+            }
+
+            case sol::type::boolean: {
+                bool boolean = value.as<bool>();
+                HashBytes(hash, &boolean, sizeof(boolean));
+                break;
+            }
+
+            case sol::type::string:
+                HashString(hash, value.as<std::string>());
+                break;
+
+            case sol::type::table:
+                HashLuaTable(hash, value.as<sol::table>(), depth + 1);
+                break;
+
+            // Functions and userdata only have addresses to hash, which differ between runs
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,154 @@
+//
+//  ReplayManager.hpp
+//  blitzENGINE
+//
+
+#ifndef ReplayManager_hpp
+#define ReplayManager_hpp
+
+#include "Scene.hpp"
+#include "SDL2/SDL.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ *  Records and replays the input of a lockstep run.
+ *
+ *  A replay log is a text file with a short header followed by one line per
+ *  input event ("E <frame> ...") and one line per simulated frame holding the
+ *  state hash at the end of that frame ("H <frame> <hash>"). Playing a log back
+ *  feeds the recorded events into the same frames and compares each hash, exiting
+ *  with a failure code on the first frame that desyncs.
+ */
+class ReplayManager {
+public:
+
+
+    static void StartRecording(const std::string &path, uint32_t seed, float timestep);
+
+
+    static void StartPlayback(const std::string &path);
+
+
+    static bool IsRecording();
+
+
+    static bool IsPlayingBack();
+
+    /**
+     *  @returns    true once playback has verified every frame in the log
+     */
+    static bool PlaybackFinished();
+
+
+    static float GetRecordedTimestep();
+
+
+    static uint32_t GetSeed();
+
+
+    static uint64_t GetFrame();
+
+    /**
+     *  Appends an input event to the current frame. Events Input ignores are dropped.
+     */
+    static void RecordEvent(const SDL_Event &e);
+
+    /**
+     *  Pops the next recorded event for the current frame.
+     *
+     *  @returns    false once every event of the current frame has been handed out
+     */
+    static bool PollEvent(SDL_Event &e);
+
+    /**
+     *  Hashes the scene, then records or verifies it and moves on to the next frame.
+     */
+    static void EndFrame(Scene &scene);
+
+    /**
+     *  Flushes a recording, or prints how many frames a playback verified and how fast.
+     */
+    static void Finish();
+
+    /**
+     *  FNV-1a over every Box2D body and every primitive field scripts can see on an actor.
+     *
+     *  Bodies are hashed in world order, actors by uuid and Lua fields by sorted key,
+     *  so the hash only depends on simulation state and not on allocation addresses.
+     */
+    static uint64_t HashState(Scene &scene);
+
+private:
+
+
+    static void HashBytes(uint64_t &hash, const void *data, size_t size);
+
+
+    static void HashString(uint64_t &hash, const std::string &value);
+
+
+    static void HashLuaTable(uint64_t &hash, const sol::table &table, uint32_t depth);
+
+
+    static inline std::ofstream record_stream;
+
+
+    static inline std::deque<std::pair<uint64_t, SDL_Event>> playback_events;
+
+
+    static inline std::vector<uint64_t> playback_hashes;
+
+
+    static inline uint64_t frame = 0;
+
+
+    static inline std::chrono::steady_clock::time_point playback_start_time;
+
+
+    static inline uint32_t seed = 0;
+
+
+    static inline float recorded_timestep = 0.0f;
+
+
+    static inline bool recording = false;
+
+
+    static inline bool playing_back = false;
+
+
+    static inline const uint32_t max_table_depth = 4;
+
+
+    static inline const uint64_t fnv_offset_basis = 14695981039346656037ull;
+
+
+    static inline const uint64_t fnv_prime = 1099511628211ull;
+};
+
+
+inline bool ReplayManager::IsRecording()                { return recording; }
+
+
+inline bool ReplayManager::IsPlayingBack()              { return playing_back; }
+
+
+inline bool ReplayManager::PlaybackFinished()           { return playing_back && frame >= playback_hashes.size(); }
+
+
+inline float ReplayManager::GetRecordedTimestep()       { return recorded_timestep; }
+
+
+inline uint32_t ReplayManager::GetSeed()                { return seed; }
+
+
+inline uint64_t ReplayManager::GetFrame()               { return frame; }
+
+#endif /* ReplayManager_hpp */
@@ -7,23 +7,17 @@
 
 #include "Rigidbody.hpp"
 #include "Engine.h"
+#include "PhysicsManager.hpp"
 
 Rigidbody::Rigidbody()
 {
-    if (!world)
-    {
-        b2Vec2 gravity(0.0f, 9.8f);
-        world = new b2World(gravity);
-        
-        collision_manager = std::make_unique<CollisionManager>();
-        world->SetContactListener(collision_manager.get());
-    }
+    InitWorld();
     
     type = "Rigidbody";
     
     component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
     
-    has_on_fixed_update = true;
+    // Property setters push to Box2D on change, so a Rigidbody never needs per-step dispatch
     has_on_destroy = true;
 }
 
@@ -46,7 +40,9 @@ Rigidbody::Rigidbody(const Rigidbody &other)
         _trigger_width(other._trigger_width),
         _trigger_height(other._trigger_height),
         _trigger_radius(other._trigger_radius),
-        _flags(other._flags)
+        _collision_layer(other._collision_layer),
+        _collides_with(other._collides_with),
+        _flags(other._flags & ~e_movedFlag)
 {
     component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
 }
@@ -113,6 +109,32 @@ void Rigidbody::UpdateComponentWithJSON(const rapidjson::Value &component_json)
     
     if (component_json.HasMember("has_trigger") && component_json["has_trigger"].IsBool())
         _flags = component_json["has_trigger"].GetBool() ? (_flags | e_triggerFlag) : (_flags & ~e_triggerFlag);
+    
+    if (component_json.HasMember("collision_layer") && component_json["collision_layer"].IsInt())
+        SetCollisionLayer(component_json["collision_layer"].GetInt());
+    
+    // collides_with accepts either a raw layer mask or an array of layer indices
+    if (component_json.HasMember("collides_with"))
+    {
+        const rapidjson::Value &collides_with_json = component_json["collides_with"];
+        
+        if (collides_with_json.IsUint())
+            SetCollidesWith(collides_with_json.GetUint());
+        else if (collides_with_json.IsArray())
+        {
+            uint32_t collides_with = 0;
+            
+            for (const auto &layer_json : collides_with_json.GetArray())
+            {
+                if (!layer_json.IsInt() || layer_json.GetInt() < 0 || layer_json.GetInt() > 15)
+                    ErrorExit("error: collides_with layers must be integers from 0 to 15");
+                
+                collides_with |= 1u << layer_json.GetInt();
+            }
+            
+            SetCollidesWith(collides_with);
+        }
+    }
 }
 
 
@@ -132,6 +154,7 @@ void Rigidbody::OnStart()
     body_def.position = _position;
     body_def.angle = _rotation;
     body_def.bullet = IsPrecise();
+    body_def.linearDamping = _friction;
     body_def.angularDamping = _angular_friction;
     body_def.gravityScale = _gravity_scale;
     
@@ -147,6 +170,7 @@ void Rigidbody::OnStart()
         phantom_fixture_def.density = _density;
         
         phantom_fixture_def.isSensor = true;
+        phantom_fixture_def.filter.maskBits = 0;
         body->CreateFixture(&phantom_fixture_def);
         
         return;
@@ -189,6 +213,7 @@ void Rigidbody::OnStart()
             fixture_def.restitution = _bounciness;
             
             fixture_def.isSensor = false;
+            fixture_def.filter = GetFilterData();
             
             body->CreateFixture(&fixture_def);
         }
@@ -228,6 +253,7 @@ void Rigidbody::OnStart()
             fixture_def.restitution = _bounciness;
             
             fixture_def.isSensor = true;
+            fixture_def.filter = GetFilterData();
             
             body->CreateFixture(&fixture_def);
         }
@@ -239,7 +265,34 @@ void Rigidbody::OnStart()
 }
 
 
-void Rigidbody::OnDestroy() { world->DestroyBody(body); }
+b2World* Rigidbody::InitWorld()
+{
+    if (!world)
+    {
+        b2Vec2 gravity(0.0f, 9.8f);
+        world = new b2World(gravity);
+        
+        collision_manager = std::make_unique<CollisionManager>();
+        world->SetContactListener(collision_manager.get());
+        world->SetContactFilter(collision_manager.get());
+        world->SetTaskExecutor(PhysicsManager::GetTaskExecutor());
+    }
+    
+    return world;
+}
+
+
+void Rigidbody::OnDestroy()
+{
+    moved_bodies.erase(this);
+    NativeTweenManager::KillTarget(this);
+    
+    // A body that never started has nothing to destroy
+    if (body && world)
+        world->DestroyBody(body);
+    
+    body = nullptr;
+}
 
 
 void Rigidbody::MovePosition(const b2Vec2 &vec2)
@@ -250,9 +303,16 @@ void Rigidbody::MovePosition(const b2Vec2 &vec2)
         float fixed_delta_time = Engine::GetFixedDeltaTime();
         travel_vector.x /= fixed_delta_time;
         travel_vector.y /= fixed_delta_time;
-        body->SetGravityScale(0.0f);
-        body->SetLinearDamping(0.0f);
         body->SetLinearVelocity(travel_vector);
+        
+        if (!(_flags & e_movedFlag))
+        {
+            body->SetGravityScale(0.0f);
+            body->SetLinearDamping(0.0f);
+            
+            _flags |= e_movedFlag;
+            moved_bodies.insert(this);
+        }
     }
     else
         _position = vec2;
@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <string>
+#include <unordered_set>
 
 
 class Rigidbody : public NativeComponent {
@@ -64,7 +65,7 @@ public:
     void OnDestroy() override;
     
     
-    ITween* GOMove(b2Vec2 end, float duration);
+    NativeTween GOMove(b2Vec2 end, float duration);
     
     
     void AddForce(const b2Vec2 &vec2);
@@ -78,6 +79,19 @@ public:
     
     static b2World* GetWorld();
     
+    /**
+     *  Creates the physics world on first use. Other native components with bodies call this too.
+     */
+    static b2World* InitWorld();
+    
+    /**
+     *  Restores gravity and damping on every body moved by MovePosition since the last step.
+     *
+     *  Called once after each b2World::Step, so only moved bodies are touched rather
+     *  than every Rigidbody in the scene.
+     */
+    static void ProcessMovedBodies();
+    
     
     void SetBodyType(const std::string &body_type);
     
@@ -186,14 +200,48 @@ public:
     
     bool HasTrigger() const;
     
+    /**
+     *  Moves every fixture on this Rigidbody to one of the 16 collision layers.
+     *
+     *  @param  collision_layer     the layer index, from 0 to 15
+     */
+    void SetCollisionLayer(int collision_layer);
+    
+    
+    int GetCollisionLayer() const;
+    
+    /**
+     *  Sets the bitmask of collision layers this Rigidbody generates contacts with.
+     *
+     *  Bit n corresponds to collision layer n. Pairs whose layers and masks do not
+     *  overlap are rejected by CollisionManager before reaching the narrow phase.
+     *
+     *  @param  collides_with       the mask of layers to collide with, no higher than 0xFFFF
+     */
+    void SetCollidesWith(uint32_t collides_with);
+    
+    
+    uint16 GetCollidesWith() const;
+    
 private:
     
     
+    b2Filter GetFilterData() const;
+    
+    
+    void RefreshFilterData();
+    
+    
+    void RestoreMovedBody();
+    
+    
+    
     enum
     {
         e_preciseFlag   = 0x0001,
         e_colliderFlag  = 0x0002,
-        e_triggerFlag   = 0x0004
+        e_triggerFlag   = 0x0004,
+        e_movedFlag     = 0x0008
     };
     
     
@@ -221,6 +269,9 @@ private:
     static inline b2World* world;
     
     
+    static inline std::unordered_set<Rigidbody*> moved_bodies;
+    
+    
     b2Body* body = nullptr;
     
     
@@ -266,6 +317,12 @@ private:
     float _mass = 1.0f;
     
     
+    uint16 _collision_layer = 0;
+    
+    
+    uint16 _collides_with = 0xFFFF;
+    
+    
     uint16 _flags = (e_preciseFlag | e_colliderFlag | e_triggerFlag);
     
 }; /* Rigidbody */
@@ -277,14 +334,7 @@ inline std::shared_ptr<Component> Rigidbody::Clone() const { return std::make_sh
 inline std::shared_ptr<Component> Rigidbody::GetSharedPointer() { return shared_from_this(); }
 
 
-inline void Rigidbody::OnFixedUpdate()
-{
-    if (body)
-    {
-        body->SetGravityScale(_gravity_scale);
-        body->SetLinearDamping(_friction);
-    }
-}
+inline void Rigidbody::OnFixedUpdate() {}
 
 
 inline void Rigidbody::OnUpdate() {}
@@ -293,15 +343,11 @@ inline void Rigidbody::OnUpdate() {}
 inline void Rigidbody::OnLateUpdate() {}
 
 
-inline ITween* Rigidbody::GOMove(b2Vec2 end, float duration)
+inline NativeTween Rigidbody::GOMove(b2Vec2 end, float duration)
 {
-    std::function<b2Vec2()> getter = [this](){ return this->GetPosition(); };
-    
-    std::function<void(b2Vec2 x)> setter = [this](b2Vec2 new_pos){ this->MovePosition(new_pos); };
-    
-    ITween* move_tween = TweenManager::GOTo(getter, setter, GetPosition(), end, duration).get();
+    b2Vec2 start = GetPosition();
     
-    return move_tween;
+    return NativeTweenManager::CreateDeferred(TweenTargetType::Rigidbody, this, start.x, start.y, end.x, end.y, duration);
 }
 
 
@@ -347,6 +393,15 @@ inline b2Vec2 Rigidbody::GetVelocity() const
 inline b2World* Rigidbody::GetWorld() { return world; }
 
 
+inline void Rigidbody::ProcessMovedBodies()
+{
+    for (Rigidbody* rigidbody : moved_bodies)
+        rigidbody->RestoreMovedBody();
+    
+    moved_bodies.clear();
+}
+
+
 inline void Rigidbody::SetBodyType(const std::string &body_type)
 {
     if (body)
@@ -509,10 +564,14 @@ inline b2Vec2 Rigidbody::GetRightDirection()
 
 inline void Rigidbody::SetGravityScale(float gravity_scale)
 {
-    if (body)
-        body->SetGravityScale(gravity_scale);
-
+    if (gravity_scale == _gravity_scale)
+        return;
+    
     _gravity_scale = gravity_scale;
+    
+    // A moved body picks up the new value when ProcessMovedBodies restores it
+    if (body && !(_flags & e_movedFlag))
+        body->SetGravityScale(gravity_scale);
 }
 
 
@@ -533,10 +592,13 @@ inline float Rigidbody::GetDensity() const { return _density; }
 
 inline void Rigidbody::SetLinearFriction(float friction)
 {
-    if (body)
-        body->SetLinearDamping(friction);
+    if (friction == _friction)
+        return;
     
     _friction = friction;
+    
+    if (body && !(_flags & e_movedFlag))
+        body->SetLinearDamping(friction);
 }
 
 
@@ -545,10 +607,13 @@ inline float Rigidbody::GetLinearFriction()  const { return _friction; }
 
 inline void Rigidbody::SetAngularFriction(float angular_friction)
 {
-    if (body)
-        body->SetAngularDamping(angular_friction);
+    if (angular_friction == _angular_friction)
+        return;
     
     _angular_friction = angular_friction;
+    
+    if (body)
+        body->SetAngularDamping(angular_friction);
 }
 
 
@@ -599,100 +664,70 @@ inline void Rigidbody::SetTrigger(bool has_trigger)
 inline bool Rigidbody::HasTrigger() const { return (_flags & e_triggerFlag) == e_triggerFlag; }
 
 
-struct HitResult {
-    
-    b2Vec2 point;
-    
-    b2Vec2 normal;
-    
-    Actor* actor;
-    
-    float fraction;
+inline void Rigidbody::SetCollisionLayer(int collision_layer)
+{
+    if (collision_layer < 0 || collision_layer > 15)
+        ErrorExit("error: collision layer " + std::to_string(collision_layer) + " is outside 0-15");
     
-    bool is_trigger;
+    _collision_layer = static_cast<uint16>(collision_layer);
     
-    bool operator()(const HitResult &lhs, const HitResult &rhs) const { return lhs.fraction < rhs.fraction; }
-};
+    RefreshFilterData();
+}
+
 
+inline int Rigidbody::GetCollisionLayer() const { return _collision_layer; }
 
-struct PhysicsRaycastAllCallback : b2RayCastCallback {
+
+inline void Rigidbody::SetCollidesWith(uint32_t collides_with)
+{
+    // Box2D masks are 16 bits, so higher bits would be dropped without a word
+    if (collides_with > 0xFFFF)
+        ErrorExit("error: collides_with mask " + std::to_string(collides_with) + " names layers outside 0-15");
     
-    std::vector<HitResult> hit_results;
+    _collides_with = static_cast<uint16>(collides_with);
     
-    float ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float fraction) override
-    {
-        HitResult hit_result;
-        
-        hit_result.point = point;
-        hit_result.normal = normal;
-        hit_result.actor = reinterpret_cast<Actor*>(fixture->GetUserData().pointer);
-        hit_result.fraction = fraction;
-        hit_result.is_trigger = fixture->IsSensor();
-        
-        if (!hit_result.actor)
-            return -1;
-        
-        hit_results.emplace_back(hit_result);
-        return 1;
-    }
-};
+    RefreshFilterData();
+}
 
 
+inline uint16 Rigidbody::GetCollidesWith() const { return _collides_with; }
 
-static inline sol::object cppPhysicsRaycast(b2Vec2 position, b2Vec2 direction, float distance)
+
+inline b2Filter Rigidbody::GetFilterData() const
 {
-    if (Rigidbody::GetWorld())
-    {
-        PhysicsRaycastAllCallback raycast_all_callback;
-        
-        direction.Normalize();
-        
-        b2Vec2 end_position = position + (distance * direction);
-        
-        Rigidbody::GetWorld()->RayCast(&raycast_all_callback, position, end_position);
-                
-        
-        if (!raycast_all_callback.hit_results.empty())
-        {
-            std::stable_sort(raycast_all_callback.hit_results.begin(), raycast_all_callback.hit_results.end(), HitResult());
-            return sol::make_object(ComponentManager::GetLuaState()->lua_state(),raycast_all_callback.hit_results.front());
-        }
-            
-    }
+    b2Filter filter;
+    filter.categoryBits = static_cast<uint16>(1 << _collision_layer);
+    filter.maskBits = _collides_with;
     
-    return sol::make_object(ComponentManager::GetLuaState()->lua_state(), sol::lua_nil);
+    return filter;
 }
 
 
-static inline sol::table cppPhysicsRaycastAll(b2Vec2 position, b2Vec2 direction, float distance)
+inline void Rigidbody::RefreshFilterData()
 {
-    sol::table hit_result_table = ComponentManager::GetLuaState()->create_table();
+    if (!body)
+        return;
+    
+    b2Filter filter = GetFilterData();
     
-    if (Rigidbody::GetWorld())
+    for (b2Fixture *fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
     {
-        uint32_t hits = 0;
-        
-        PhysicsRaycastAllCallback raycast_all_callback;
-        
-        direction.Normalize();
-        
-        b2Vec2 end_position = position + (distance * direction);
-        
-        Rigidbody::GetWorld()->RayCast(&raycast_all_callback, position, end_position);
-
-        
-        if (!raycast_all_callback.hit_results.empty())
-        {
-            std::stable_sort(raycast_all_callback.hit_results.begin(), raycast_all_callback.hit_results.end(), HitResult());
-            
-            for (HitResult hit_result : raycast_all_callback.hit_results)
-            {
-                hit_result_table[++hits] = sol::make_object(ComponentManager::GetLuaState()->lua_state(), hit_result);
-            }
-        }
+        // Phantom fixtures only exist to give the body mass, and never collide
+        if (fixture->GetUserData().pointer)
+            fixture->SetFilterData(filter);
     }
+}
+
+
+inline void Rigidbody::RestoreMovedBody()
+{
+    _flags &= ~e_movedFlag;
     
-    return hit_result_table;
+    if (body)
+    {
+        body->SetGravityScale(_gravity_scale);
+        body->SetLinearDamping(_friction);
+    }
 }
 
 #endif /* Rigidbody_hpp */
@@ -123,6 +123,22 @@ void Scene::OnDestroy()
 }
 
 
+void Scene::DestroyNativeComponents()
+{
+    for (auto &actor_pair : actors_by_uuid)
+    {
+        if (SceneManager::dont_destroy_on_load.count(actor_pair.first) == 0)
+            actor_pair.second->DestroyNativeComponents();
+    }
+    
+    for (std::shared_ptr<Actor> &starting_actor_to_add : starting_actors_to_add)
+    {
+        if (SceneManager::dont_destroy_on_load.count(starting_actor_to_add->uuid) == 0)
+            starting_actor_to_add->DestroyNativeComponents();
+    }
+}
+
+
 Actor* Scene::FindActor(const std::string &actor_name)
 {
     if (uuids_by_name.count(actor_name) > 0)
@@ -49,6 +49,11 @@ public:
     
     void OnDestroy();
     
+    /**
+     *  Tears down the native components of every actor not kept by DontDestroy, before the scene is replaced.
+     */
+    void DestroyNativeComponents();
+    
     
     Actor* FindActor(const std::string &actor_name);
     
@@ -28,10 +28,16 @@
  */
 
 #include "SceneManager.hpp"
+#include "CollisionManager.hpp"
 #include "ComponentManager.hpp"
 
 void SceneManager::SetCurrentScene(const std::string &scene_to_set)
 {
+    current_scene.DestroyNativeComponents();
+    
+    // Destroying bodies ends their contacts, and those exit events name actors about to be freed
+    EventChannel<ContactEvent>::Flush();
+    
     current_scene = Scene();
     
     if (!dont_destroy_on_load.empty())
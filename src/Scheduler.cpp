@@ -0,0 +1,194 @@
+//
+//  Scheduler.cpp
+//  blitzENGINE
+//
+
+#include "Scheduler.hpp"
+
+#include "Utilities.hpp"
+
+#include <algorithm>
+
+
+void TimerHandle::Cancel()
+{
+    if (IsActive())
+        Scheduler::ReleaseTimer(id);
+}
+
+
+bool TimerHandle::IsActive() const
+{
+    return id < Scheduler::timers.size() && Scheduler::timers[id].active && Scheduler::timers[id].generation == generation;
+}
+
+
+TimerHandle Scheduler::After(double seconds, bool fixed, std::function<void()> callback)
+{
+    return StartTimer(fixed ? fixed_queue : normal_queue, seconds, false, sol::protected_function(), sol::nullopt, std::move(callback));
+}
+
+
+TimerHandle Scheduler::cppTimerAfter(float seconds, sol::protected_function function, sol::optional<sol::table> function_table)
+{
+    return StartTimer(normal_queue, seconds, false, function, function_table);
+}
+
+
+TimerHandle Scheduler::cppTimerEvery(float seconds, sol::protected_function function, sol::optional<sol::table> function_table)
+{
+    return StartTimer(normal_queue, seconds, true, function, function_table);
+}
+
+
+TimerHandle Scheduler::cppTimerAfterFixed(float seconds, sol::protected_function function, sol::optional<sol::table> function_table)
+{
+    return StartTimer(fixed_queue, seconds, false, function, function_table);
+}
+
+
+TimerHandle Scheduler::cppTimerEveryFixed(float seconds, sol::protected_function function, sol::optional<sol::table> function_table)
+{
+    return StartTimer(fixed_queue, seconds, true, function, function_table);
+}
+
+
+void Scheduler::cppTimerSetBudget(int budget)
+{
+    Scheduler::budget = std::max(budget, 0);
+}
+
+
+TimerHandle Scheduler::StartTimer(TimerQueue &queue, double seconds, bool repeating, sol::protected_function function, sol::optional<sol::table> function_table,
+                                  std::function<void()> native_function)
+{
+    uint32_t id;
+
+    if (!free_ids.empty())
+    {
+        id = free_ids.back();
+        free_ids.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(timers.size());
+        timers.emplace_back();
+    }
+
+    ScheduledTimer &timer = timers[id];
+
+    timer.function = function;
+    timer.function_table = function_table;
+    timer.native_function = std::move(native_function);
+    timer.interval = std::max(seconds, 0.0);
+    timer.repeating = repeating;
+    timer.active = true;
+
+    timer_count++;
+
+    Push(queue.heap, { queue.clock + timer.interval, timers_started++, id, timer.generation });
+
+    return TimerHandle(id, timer.generation);
+}
+
+
+void Scheduler::RunQueue(TimerQueue &queue, double delta_time)
+{
+    queue.clock += delta_time;
+
+    // Timers started or rescheduled from here on wait for the next update
+    uint64_t order_limit = timers_started;
+    int fired = 0;
+
+    while (!queue.heap.empty() && queue.heap.front().due_time <= queue.clock)
+    {
+        if (budget > 0 && fired >= budget)
+            break;
+
+        std::pop_heap(queue.heap.begin(), queue.heap.end(), DueLater);
+        DueTimer due_timer = queue.heap.back();
+        queue.heap.pop_back();
+
+        // Cancelled timers leave their entry behind, which is dropped once it comes due
+        if (!timers[due_timer.id].active || timers[due_timer.id].generation != due_timer.generation)
+            continue;
+
+        if (due_timer.order >= order_limit)
+        {
+            queue.deferred.push_back(due_timer);
+            continue;
+        }
+
+        fired++;
+
+        // Copied out, since the callback may start timers and move the one it belongs to
+        ScheduledTimer &timer = timers[due_timer.id];
+        sol::main_protected_function function = timer.function;
+        sol::optional<sol::main_table> function_table = timer.function_table;
+        std::function<void()> native_function = timer.native_function;
+
+        if (timer.repeating)
+        {
+            // Scheduled from when it was due rather than from now, so it doesn't drift, and fires
+            // again this update if that's still due. A zero interval would never stop, so it waits
+            due_timer.due_time += timer.interval;
+
+            if (timer.interval > 0.0)
+                Push(queue.heap, due_timer);
+            else
+            {
+                due_timer.order = timers_started++;
+                queue.deferred.push_back(due_timer);
+            }
+        }
+        else
+            ReleaseTimer(due_timer.id);
+
+        if (native_function)
+        {
+            native_function();
+            continue;
+        }
+
+        sol::protected_function_result function_result = function_table.has_value() ? function(function_table.value()) : function();
+
+        if (!function_result.valid())
+            ReportError("Timer", function_result);
+    }
+
+    for (const DueTimer &due_timer : queue.deferred)
+        Push(queue.heap, due_timer);
+
+    queue.deferred.clear();
+}
+
+
+void Scheduler::Push(std::vector<DueTimer> &heap, const DueTimer &due_timer)
+{
+    heap.push_back(due_timer);
+    std::push_heap(heap.begin(), heap.end(), DueLater);
+}
+
+
+bool Scheduler::DueLater(const DueTimer &lhs, const DueTimer &rhs)
+{
+    if (lhs.due_time != rhs.due_time)
+        return lhs.due_time > rhs.due_time;
+
+    return lhs.order > rhs.order;
+}
+
+
+void Scheduler::ReleaseTimer(uint32_t id)
+{
+    ScheduledTimer &timer = timers[id];
+
+    timer.function = sol::main_protected_function();
+    timer.function_table = sol::nullopt;
+    timer.native_function = nullptr;
+    timer.active = false;
+    timer.generation++;
+
+    free_ids.push_back(id);
+    timer_count--;
+}
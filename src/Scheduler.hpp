@@ -0,0 +1,188 @@
+//
+//  Scheduler.hpp
+//  blitzENGINE
+//
+
+#ifndef Scheduler_hpp
+#define Scheduler_hpp
+
+#include "sol/sol.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ *  A handle to a timer started through the Lua Timer table. Handles are plain ids, so they
+ *  do nothing once their timer has fired for the last time or been cancelled.
+ */
+class TimerHandle {
+public:
+
+
+    TimerHandle() {}
+
+
+    void Cancel();
+
+    /**
+     *  @return false once the timer has fired for the last time or been cancelled
+     */
+    bool IsActive() const;
+
+private:
+
+
+    friend class Scheduler;
+
+
+    TimerHandle(uint32_t id, uint32_t generation) : id(id), generation(generation) {}
+
+
+    uint32_t id = UINT32_MAX;
+
+
+    uint32_t generation = 0;
+};
+
+/**
+ *  Runs Lua callbacks after a delay or on an interval, so scripts don't need an OnUpdate
+ *  just to count time.
+ *
+ *  Timers wait in a binary heap ordered by when they are due, so an update only looks at
+ *  the timers that fire. Normal timers run on frame time before OnUpdate, fixed timers on
+ *  the fixed timestep before OnFixedUpdate. Timers with the same due time fire in the order
+ *  they were started, and one started by a callback never fires in the same update.
+ */
+class Scheduler {
+public:
+
+
+    static void Update(double delta_time);
+
+
+    static void FixedUpdate(double delta_time);
+
+
+    static size_t GetTimerCount();
+
+    /**
+     *  Starts a one-shot timer with a native callback, on the fixed clock if fixed is set.
+     */
+    static TimerHandle After(double seconds, bool fixed, std::function<void()> callback);
+
+
+    static TimerHandle cppTimerAfter(float seconds, sol::protected_function function, sol::optional<sol::table> function_table);
+
+
+    static TimerHandle cppTimerEvery(float seconds, sol::protected_function function, sol::optional<sol::table> function_table);
+
+
+    static TimerHandle cppTimerAfterFixed(float seconds, sol::protected_function function, sol::optional<sol::table> function_table);
+
+
+    static TimerHandle cppTimerEveryFixed(float seconds, sol::protected_function function, sol::optional<sol::table> function_table);
+
+    /**
+     *  Caps how many callbacks one update may run. Timers over the cap stay due and fire in
+     *  the next update, and repeating ones catch up without drifting. 0 removes the cap.
+     */
+    static void cppTimerSetBudget(int budget);
+
+private:
+
+
+    friend class TimerHandle;
+
+
+    /**
+     *  Holds main thread references, since a timer started from a coroutine can outlive its thread.
+     */
+    struct ScheduledTimer
+    {
+        sol::main_protected_function function;
+        sol::optional<sol::main_table> function_table;
+
+        std::function<void()> native_function;
+
+        double interval = 0.0;
+
+        uint32_t generation = 0;
+
+        bool repeating = false;
+        bool active = false;
+    };
+
+
+    struct DueTimer
+    {
+        double due_time;
+        uint64_t order;
+
+        uint32_t id;
+        uint32_t generation;
+    };
+
+
+    struct TimerQueue
+    {
+        std::vector<DueTimer> heap;
+
+        /**
+         *  Timers that came due during an update but have to wait for the next one.
+         */
+        std::vector<DueTimer> deferred;
+
+        double clock;
+    };
+
+
+    static TimerHandle StartTimer(TimerQueue &queue, double seconds, bool repeating, sol::protected_function function, sol::optional<sol::table> function_table,
+                                  std::function<void()> native_function = nullptr);
+
+
+    static void RunQueue(TimerQueue &queue, double delta_time);
+
+
+    static void Push(std::vector<DueTimer> &heap, const DueTimer &due_timer);
+
+    /**
+     *  Heap order, putting the timer due first, and started first among equals, on top.
+     */
+    static bool DueLater(const DueTimer &lhs, const DueTimer &rhs);
+
+
+    static void ReleaseTimer(uint32_t id);
+
+
+    static inline TimerQueue normal_queue = {};
+
+
+    static inline TimerQueue fixed_queue = {};
+
+
+    static inline std::vector<ScheduledTimer> timers;
+
+
+    static inline std::vector<uint32_t> free_ids;
+
+
+    static inline uint64_t timers_started = 0;
+
+
+    static inline size_t timer_count = 0;
+
+
+    static inline int budget = 0;
+};
+
+
+inline void Scheduler::Update(double delta_time)        { RunQueue(normal_queue, delta_time); }
+
+
+inline void Scheduler::FixedUpdate(double delta_time)   { RunQueue(fixed_queue, delta_time); }
+
+
+inline size_t Scheduler::GetTimerCount()                { return timer_count; }
+
+#endif /* Scheduler_hpp */
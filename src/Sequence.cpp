@@ -0,0 +1,228 @@
+//
+//  Sequence.cpp
+//  blitzENGINE
+//
+
+#include "Sequence.hpp"
+
+#include "TweenManager.hpp"
+
+#include <algorithm>
+
+
+Sequence::Sequence()
+{
+    SetEase(EaseType::Linear);
+}
+
+
+std::shared_ptr<Sequence> Sequence::CreateSequence()
+{
+    return std::make_shared<Sequence>();
+}
+
+
+void Sequence::EvaluateAndApply(float dt)
+{
+    float time = evaluated_duration * current_loop + elapsed_time + dt;
+
+    Seek(time);
+
+    if (loops >= 0 && time >= evaluated_duration * loops)
+    {
+        loops_completed = loops;
+
+        if (on_kill)
+            on_kill();
+    }
+}
+
+
+void Sequence::Seek(float time)
+{
+    if (loops == 0)
+        return;
+
+    if (evaluated_duration <= 0.0f)
+    {
+        MoveTo(duration, true);
+        return;
+    }
+
+    auto is_reversed = [this](int32_t loop) { return loop_type == LoopType::Yoyo && loop % 2 == 1; };
+
+    int32_t loop = static_cast<int32_t>(time / evaluated_duration);
+    float loop_time = time - evaluated_duration * loop;
+
+    if (loops >= 0 && loop >= loops)
+    {
+        loop = loops - 1;
+        loop_time = evaluated_duration;
+    }
+
+    if (loop < current_loop)
+        current_loop = loop;
+
+    // Finishes each loop the playhead passed the end of, so no tween or callback is skipped
+    while (current_loop < loop)
+    {
+        bool reversed = is_reversed(current_loop);
+        MoveTo(reversed ? 0.0f : duration, !reversed);
+
+        current_loop++;
+
+        if (!is_reversed(current_loop))
+        {
+            if (loop_type != LoopType::Yoyo)
+                MoveTo(0.0f, false);
+
+            position = -1.0f;
+        }
+    }
+
+    elapsed_time = loop_time;
+
+    float eased_progress = (loop_time >= evaluated_duration) ? 1.0f : ease_function(loop_time, evaluated_duration, overshootOrAmplitude);
+    float target_position = eased_progress * duration;
+
+    if (is_reversed(current_loop))
+        MoveTo(duration - target_position, false);
+    else
+        MoveTo(target_position, true);
+}
+
+
+Sequence* Sequence::Append(ITween* tween)
+{
+    AddSegment(duration, tween);
+    return this;
+}
+
+
+Sequence* Sequence::Join(ITween* tween)
+{
+    AddSegment(last_insert_time, tween);
+    return this;
+}
+
+
+Sequence* Sequence::Insert(float time, ITween* tween)
+{
+    AddSegment(time, tween);
+    return this;
+}
+
+
+Sequence* Sequence::AppendInterval(float interval)
+{
+    SetDuration(duration + std::max(interval, 0.0f));
+    return this;
+}
+
+
+Sequence* Sequence::AppendCallback(sol::protected_function callback_func, sol::optional<sol::table> callback_table)
+{
+    AddCallback(duration, callback_func, callback_table);
+    return this;
+}
+
+
+Sequence* Sequence::InsertCallback(float time, sol::protected_function callback_func, sol::optional<sol::table> callback_table)
+{
+    AddCallback(time, callback_func, callback_table);
+    return this;
+}
+
+
+void Sequence::AddSegment(float start_time, ITween* tween)
+{
+    if (!tween || tween == this)
+        return;
+
+    std::shared_ptr<ITween> shared_tween = tween->GetSharedPointer();
+
+    // From here on the tween only moves when the sequence seeks it
+    TweenManager::RemoveTween(shared_tween);
+
+    start_time = std::max(start_time, 0.0f);
+
+    SequenceSegment segment = { shared_tween, start_time, start_time + tween->GetTotalDuration() };
+
+    auto segment_it = std::upper_bound(segments.begin(), segments.end(), start_time, [](float time, const SequenceSegment &other) {
+        return time < other.start_time;
+    });
+
+    segments.insert(segment_it, segment);
+
+    last_insert_time = start_time;
+    SetDuration(std::max(duration, segment.end_time));
+}
+
+
+void Sequence::AddCallback(float time, sol::protected_function callback_func, sol::optional<sol::table> callback_table)
+{
+    SequenceCallback callback;
+    callback.time = std::max(time, 0.0f);
+
+    if (callback_table.has_value())
+        callback.callback = [callback_func = sol::main_protected_function(callback_func), callback_table = sol::main_table(callback_table.value())]() { callback_func(callback_table); };
+    else
+        callback.callback = [callback_func = sol::main_protected_function(callback_func)]() { callback_func(); };
+
+    auto callback_it = std::upper_bound(callbacks.begin(), callbacks.end(), callback.time, [](float time, const SequenceCallback &other) {
+        return time < other.time;
+    });
+
+    SetDuration(std::max(duration, callback.time));
+
+    callbacks.insert(callback_it, std::move(callback));
+}
+
+
+void Sequence::SetDuration(float duration)
+{
+    this->duration = duration;
+    evaluated_duration = duration / timescale;
+}
+
+
+void Sequence::MoveTo(float target_position, bool run_callbacks)
+{
+    float previous_position = position;
+
+    if (target_position == previous_position)
+        return;
+
+    position = target_position;
+
+    float low = std::min(previous_position, target_position);
+    float high = std::max(previous_position, target_position);
+
+    // Indexed rather than iterated, since a setter or callback may add to the sequence
+    if (target_position > previous_position)
+    {
+        for (size_t i = 0; i < segments.size() && segments[i].start_time <= high; ++i)
+        {
+            if (segments[i].end_time >= low)
+                segments[i].tween->Seek(std::clamp(target_position - segments[i].start_time, 0.0f, segments[i].end_time - segments[i].start_time));
+        }
+    }
+    else
+    {
+        // Backwards, so the earliest of overlapping tweens is the one left applied
+        for (size_t i = segments.size(); i-- > 0;)
+        {
+            if (segments[i].start_time <= high && segments[i].end_time >= low)
+                segments[i].tween->Seek(std::clamp(target_position - segments[i].start_time, 0.0f, segments[i].end_time - segments[i].start_time));
+        }
+    }
+
+    if (!run_callbacks || target_position < previous_position)
+        return;
+
+    for (size_t i = 0; i < callbacks.size() && callbacks[i].time <= target_position; ++i)
+    {
+        if (callbacks[i].time > previous_position)
+            callbacks[i].callback();
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  Sequence.hpp
+//  blitzENGINE
+//
+
+#ifndef Sequence_hpp
+#define Sequence_hpp
+
+#include "Tween.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ *  A timeline of tweens and callbacks that TweenManager updates as a single tween.
+ *
+ *  Each tween is placed at a fixed offset when it is added and is driven through Seek from
+ *  then on, so it leaves TweenManager and none of its own callbacks run. Every update only
+ *  touches the tweens whose span the playhead moved through. The sequence's ease shapes the
+ *  playhead and defaults to linear. Incremental loops restart like Restart loops.
+ */
+class Sequence : public ITween {
+public:
+
+    Sequence();
+
+
+    static std::shared_ptr<Sequence> CreateSequence();
+
+
+    void EvaluateAndApply(float dt) override;
+
+
+    void Seek(float time) override;
+
+    /**
+     *  Adds a tween at the end of the sequence.
+     */
+    Sequence* Append(ITween* tween);
+
+    /**
+     *  Adds a tween at the same time as the last tween added.
+     */
+    Sequence* Join(ITween* tween);
+
+
+    Sequence* Insert(float time, ITween* tween);
+
+
+    Sequence* AppendInterval(float interval);
+
+
+    Sequence* AppendCallback(sol::protected_function callback_func, sol::optional<sol::table> callback_table);
+
+
+    Sequence* InsertCallback(float time, sol::protected_function callback_func, sol::optional<sol::table> callback_table);
+
+private:
+
+    struct SequenceSegment
+    {
+        std::shared_ptr<ITween> tween;
+
+        float start_time;
+        float end_time;
+    };
+
+
+    struct SequenceCallback
+    {
+        float time;
+
+        std::function<void()> callback;
+    };
+
+
+    void AddSegment(float start_time, ITween* tween);
+
+
+    void AddCallback(float time, sol::protected_function callback_func, sol::optional<sol::table> callback_table);
+
+
+    void SetDuration(float duration);
+
+    /**
+     *  Moves the playhead within the current loop, seeking the tweens it passed over.
+     *  Callbacks only run when it moves forward.
+     */
+    void MoveTo(float target_position, bool run_callbacks);
+
+    /**
+     *  Sorted by start time. Tweens that overlap are applied in that order, so the later one wins.
+     */
+    std::vector<SequenceSegment> segments;
+
+
+    std::vector<SequenceCallback> callbacks;
+
+
+    float last_insert_time = 0.0f;
+
+    /**
+     *  Where the playhead is within the current loop, or -1 before a forward pass has started.
+     */
+    float position = -1.0f;
+
+
+    int32_t current_loop = 0;
+};
+
+#endif /* Sequence_hpp */
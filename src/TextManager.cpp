@@ -8,6 +8,7 @@
 #include "TextManager.hpp"
 
 #include "ImageManager.hpp"
+#include "LayerManager.hpp"
 #include "Renderer.hpp"
 
 #include <iostream>
@@ -39,6 +40,22 @@ TTF_Font* TextManager::GetFont(const std::string &font_name, int font_size)
 }
 
 void TextManager::cppTextDraw(const std::string &str_content, float _x, float _y, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a)
+{
+    std::shared_ptr<Image> text_image = GetTextImage(str_content, font_name, _font_size, _r, _g, _b, _a);
+    
+    TextDrawRequest text_draw_req = {text_image, static_cast<int>(_x), static_cast<int>(_y)};
+    
+    Renderer::text_render_queue.push(text_draw_req);
+}
+
+void TextManager::cppTextDrawLayer(const std::string &str_content, float _x, float _y, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a, const std::string &layer_name)
+{
+    std::shared_ptr<Image> text_image = GetTextImage(str_content, font_name, _font_size, _r, _g, _b, _a);
+    
+    LayerManager::GetLayer(layer_name).text_render_requests.push_back({text_image, static_cast<int>(_x), static_cast<int>(_y)});
+}
+
+std::shared_ptr<Image> TextManager::GetTextImage(const std::string &str_content, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a)
 {
     int font_size = static_cast<int>(_font_size);
     TTF_Font* font_ptr = GetFont(font_name, font_size);
@@ -52,23 +69,15 @@ void TextManager::cppTextDraw(const std::string &str_content, float _x, float _y
     
     std::string texture_key = CreateTextureKey(font_ptr, str_content, r, g, b, a);
     
-    std::shared_ptr<Image> text_image;
-    
     if (ImageManager::CheckImage(texture_key))
-        text_image = ImageManager::GetImage(texture_key);
-    else // If texture for this text doesn't already exist, create new texture
-    {
-        SDL_Surface* surface = TTF_RenderText_Solid(font_ptr, str_content.c_str(), font_color);
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(Renderer::GetSDLRenderer(), surface);
-        SDL_FreeSurface(surface);
-        
-        text_image = ImageManager::AddImage(texture_key, texture);
-    }
+        return ImageManager::GetImage(texture_key);
     
-    int x = static_cast<int>(_x);
-    int y = static_cast<int>(_y);
+    // If texture for this text doesn't already exist, create new texture
+    SDL_Surface* surface = TTF_RenderText_Solid(font_ptr, str_content.c_str(), font_color);
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(Renderer::GetSDLRenderer(), surface);
+    SDL_FreeSurface(surface);
     
-    TextDrawRequest text_draw_req = {text_image, x, y};
+    text_textures_created++;
     
-    Renderer::text_render_queue.push(text_draw_req);
+    return ImageManager::AddImage(texture_key, texture);
 }
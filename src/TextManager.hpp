@@ -12,10 +12,12 @@
 #define DEFAULT_FONT_SIZE 16
 #define DEFAULT_FONT_COLOR {255, 255, 255, 255}
 
+#include "Image.hpp"
 #include "SDL2/SDL.h"
 #include "SDL2_ttf/SDL_ttf.h"
 #include "Utilities.hpp"
 
+#include <memory>
 #include <unordered_map>
 #include <map>
 #include <string>
@@ -30,20 +32,40 @@ public:
     
     static TTF_Font* GetFont(const std::string &font_name, int font_size);
     
+    /**
+     *  How many text textures have been rendered since startup, not how many are cached now.
+     */
+    static size_t GetTextTexturesCreated();
+    
     
     static void cppTextDraw(const std::string &str_content, float _x, float _y, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a);
+    
+    /**
+     *  Draws into the named layer instead of straight to the frame. See LayerManager.
+     */
+    static void cppTextDrawLayer(const std::string &str_content, float _x, float _y, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a, const std::string &layer_name);
 
 private:
     
     
+    static std::shared_ptr<Image> GetTextImage(const std::string &str_content, const std::string &font_name, float _font_size, float _r, float _g, float _b, float _a);
+    
+    
+    
     static std::string CreateTextureKey(TTF_Font* font_ptr, const std::string &str_content, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     
     
     static inline std::unordered_map<std::string, TTF_Font*> font_cache;
     
+    
+    static inline size_t text_textures_created = 0;
+    
 };
 
 
+inline size_t TextManager::GetTextTexturesCreated()    { return text_textures_created; }
+
+
 inline void TextManager::Init()
 {
     
@@ -0,0 +1,137 @@
+//
+//  ThreadPool.cpp
+//  blitzENGINE
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+
+void ThreadPool::Init()
+{
+    if (!workers.empty())
+        return;
+
+    uint32_t hardware_threads = std::thread::hardware_concurrency();
+    uint32_t worker_count = hardware_threads > 1 ? hardware_threads - 1 : 0;
+
+    shutting_down = false;
+
+    for (uint32_t i = 0; i < worker_count; ++i)
+        workers.emplace_back(WorkerLoop);
+
+    // Workers must be joined before the static members they wait on are destroyed
+    std::atexit(Shutdown);
+}
+
+
+void ThreadPool::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(task_mutex);
+        shutting_down = true;
+    }
+
+    task_available.notify_all();
+
+    for (std::thread &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+
+    workers.clear();
+}
+
+
+void ThreadPool::ParallelFor(uint32_t count, uint32_t min_batch_size, const std::function<void(uint32_t, uint32_t)> &job)
+{
+    if (count == 0)
+        return;
+
+    min_batch_size = std::max(min_batch_size, 1u);
+
+    uint32_t max_batches = (count + min_batch_size - 1) / min_batch_size;
+    uint32_t batches = std::min(GetWorkerCount() + 1, max_batches);
+
+    if (batches <= 1)
+    {
+        job(0, count);
+        return;
+    }
+
+    uint32_t batch_size = (count + batches - 1) / batches;
+    std::atomic<uint32_t> batches_remaining(batches - 1);
+
+    {
+        std::lock_guard<std::mutex> lock(task_mutex);
+
+        for (uint32_t batch = 1; batch < batches; ++batch)
+        {
+            uint32_t begin = batch * batch_size;
+            uint32_t end = std::min(begin + batch_size, count);
+
+            tasks.emplace_back([&job, &batches_remaining, begin, end]() {
+                if (begin < end)
+                    job(begin, end);
+
+                batches_remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+    }
+
+    task_available.notify_all();
+
+    // The caller takes the first batch, then helps drain the queue
+    job(0, std::min(batch_size, count));
+
+    while (batches_remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!TryRunTask())
+            std::this_thread::yield();
+    }
+}
+
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(task_mutex);
+            task_available.wait(lock, []() { return shutting_down || !tasks.empty(); });
+
+            if (shutting_down && tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+
+bool ThreadPool::TryRunTask()
+{
+    std::function<void()> task;
+
+    {
+        std::lock_guard<std::mutex> lock(task_mutex);
+
+        if (tasks.empty())
+            return false;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+
+    task();
+    return true;
+}
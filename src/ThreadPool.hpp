@@ -0,0 +1,77 @@
+//
+//  ThreadPool.hpp
+//  blitzENGINE
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ *  A persistent set of worker threads for splitting data-parallel engine work.
+ *
+ *  Jobs must not touch Lua or SDL state; they are meant for pure C++ loops over
+ *  engine-owned data (physics queries, particle kernels, etc.). Results should be
+ *  handed back to Lua on the main thread once ParallelFor returns.
+ */
+class ThreadPool {
+public:
+
+    /**
+     *  Spawns one worker per hardware thread, minus the main thread.
+     */
+    static void Init();
+
+
+    static void Shutdown();
+
+
+    static uint32_t GetWorkerCount();
+
+    /**
+     *  Splits [0, count) into batches and runs job(begin, end) on each, blocking until all finish.
+     *
+     *  The calling thread works on batches too. Falls back to a single serial call when
+     *  there are no workers or when count is too small to be worth splitting.
+     *
+     *  @param  count               the number of items to process
+     *  @param  min_batch_size      the smallest number of items given to a single batch
+     *  @param  job                 the function to run over each [begin, end) range
+     */
+    static void ParallelFor(uint32_t count, uint32_t min_batch_size, const std::function<void(uint32_t, uint32_t)> &job);
+
+private:
+
+
+    static void WorkerLoop();
+
+
+    static bool TryRunTask();
+
+
+    static inline std::vector<std::thread> workers;
+
+
+    static inline std::deque<std::function<void()>> tasks;
+
+
+    static inline std::mutex task_mutex;
+
+
+    static inline std::condition_variable task_available;
+
+
+    static inline bool shutting_down = false;
+};
+
+
+inline uint32_t ThreadPool::GetWorkerCount() { return static_cast<uint32_t>(workers.size()); }
+
+#endif /* ThreadPool_hpp */
@@ -0,0 +1,499 @@
+//
+//  Tilemap.cpp
+//  blitzENGINE
+//
+
+#include "Tilemap.hpp"
+
+#include "Engine.h"
+#include "ImageManager.hpp"
+#include "Renderer.hpp"
+#include "Rigidbody.hpp"
+
+#include <array>
+#include <cmath>
+
+
+Tilemap::Tilemap()
+{
+    type = "Tilemap";
+
+    component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
+
+    has_on_start = true;
+    has_on_update = true;
+    has_on_destroy = true;
+}
+
+
+Tilemap::Tilemap(const Tilemap &other)
+    :   NativeComponent::NativeComponent(other),
+        tilemap_name(other.tilemap_name),
+        tilemap_data(other.tilemap_data),
+        tiles(other.tiles),
+        _x(other._x),
+        _y(other._y),
+        _friction(other._friction),
+        _sorting_order(other._sorting_order),
+        _collision_layer(other._collision_layer),
+        _collides_with(other._collides_with),
+        has_collider(other.has_collider)
+{
+    component_ref = sol::make_object(ComponentManager::GetLuaState()->lua_state(), this);
+}
+
+
+void Tilemap::UpdateComponentWithJSON(const rapidjson::Value &component_json)
+{
+    if (component_json.HasMember("tilemap") && component_json["tilemap"].IsString())
+    {
+        tilemap_name = component_json["tilemap"].GetString();
+        tilemap_data = TilemapManager::GetTilemap(tilemap_name);
+        tiles = tilemap_data->tiles;
+    }
+
+    if (component_json.HasMember("x") && component_json["x"].IsNumber())
+        _x = component_json["x"].GetFloat();
+
+    if (component_json.HasMember("y") && component_json["y"].IsNumber())
+        _y = component_json["y"].GetFloat();
+
+    if (component_json.HasMember("sorting_order") && component_json["sorting_order"].IsNumber())
+        _sorting_order = static_cast<uint16_t>(component_json["sorting_order"].GetFloat());
+
+    if (component_json.HasMember("friction") && component_json["friction"].IsNumber())
+        _friction = component_json["friction"].GetFloat();
+
+    if (component_json.HasMember("has_collider") && component_json["has_collider"].IsBool())
+        has_collider = component_json["has_collider"].GetBool();
+
+    if (component_json.HasMember("collision_layer") && component_json["collision_layer"].IsInt())
+    {
+        int collision_layer = component_json["collision_layer"].GetInt();
+
+        if (collision_layer < 0 || collision_layer > 15)
+            ErrorExit("error: collision layer " + std::to_string(collision_layer) + " is outside 0-15");
+
+        _collision_layer = static_cast<uint16>(collision_layer);
+    }
+
+    if (component_json.HasMember("collides_with") && component_json["collides_with"].IsUint())
+    {
+        uint32_t collides_with = component_json["collides_with"].GetUint();
+
+        if (collides_with > 0xFFFF)
+            ErrorExit("error: collides_with mask " + std::to_string(collides_with) + " names layers outside 0-15");
+
+        _collides_with = static_cast<uint16>(collides_with);
+    }
+}
+
+
+void Tilemap::OnStart()
+{
+    if (!tilemap_data)
+        ErrorExit("error: Tilemap component is missing a tilemap");
+
+    tileset = ImageManager::GetImage(tilemap_data->tileset);
+
+    chunk_columns = (tilemap_data->width + chunk_size - 1) / chunk_size;
+    chunk_rows = (tilemap_data->height + chunk_size - 1) / chunk_size;
+    chunks.resize(static_cast<size_t>(chunk_columns) * chunk_rows);
+
+    live_tilemaps.insert(this);
+
+    BuildColliders();
+}
+
+
+void Tilemap::OnUpdate()
+{
+    if (colliders_dirty)
+        BuildColliders();
+
+    if (Renderer::IsHeadless())
+        return;
+
+    // Only chunks overlapping the camera's view get baked or drawn
+    const float pixels_per_meter = 1.0f + PIXELS_PER_METER_ADDEND;
+
+    glm::vec2 camera_position = Engine::GetCameraPosition();
+    glm::ivec2 camera_dimensions = Renderer::GetCameraDimensions();
+    float zoom_factor = Renderer::cppCameraGetZoom();
+
+    float half_view_width = camera_dimensions.x * 0.5f / zoom_factor / pixels_per_meter;
+    float half_view_height = camera_dimensions.y * 0.5f / zoom_factor / pixels_per_meter;
+    float chunk_world_size = chunk_size * GetTileWorldSize();
+
+    int first_chunk_x = std::max(0, static_cast<int>(std::floor((camera_position.x - half_view_width - _x) / chunk_world_size)));
+    int last_chunk_x = std::min(chunk_columns - 1, static_cast<int>(std::floor((camera_position.x + half_view_width - _x) / chunk_world_size)));
+    int first_chunk_y = std::max(0, static_cast<int>(std::floor((camera_position.y - half_view_height - _y) / chunk_world_size)));
+    int last_chunk_y = std::min(chunk_rows - 1, static_cast<int>(std::floor((camera_position.y + half_view_height - _y) / chunk_world_size)));
+
+    for (int chunk_y = first_chunk_y; chunk_y <= last_chunk_y; ++chunk_y)
+    {
+        for (int chunk_x = first_chunk_x; chunk_x <= last_chunk_x; ++chunk_x)
+        {
+            Chunk &chunk = chunks[static_cast<size_t>(chunk_y) * chunk_columns + chunk_x];
+
+            if (!chunk.baked)
+                BakeChunk(chunk_x, chunk_y);
+
+            ImageDrawRequest chunk_draw_request;
+
+            chunk_draw_request.image = chunk.image;
+            chunk_draw_request.x = _x + chunk_x * chunk_world_size;
+            chunk_draw_request.y = _y + chunk_y * chunk_world_size;
+            chunk_draw_request.pivot_x = 0.0f;
+            chunk_draw_request.pivot_y = 0.0f;
+            chunk_draw_request.sorting_order = _sorting_order;
+
+            Renderer::screenspace_render_requests.push_back(chunk_draw_request);
+        }
+    }
+}
+
+
+void Tilemap::OnDestroy()
+{
+    DestroyColliders();
+
+    for (Chunk &chunk : chunks)
+    {
+        if (chunk.image)
+            SDL_DestroyTexture(chunk.image->texture);
+    }
+
+    chunks.clear();
+
+    live_tilemaps.erase(this);
+}
+
+
+int Tilemap::cppTilemapGetTile(int tile_x, int tile_y) const
+{
+    if (!tilemap_data || tile_x < 0 || tile_y < 0 || tile_x >= tilemap_data->width || tile_y >= tilemap_data->height)
+        return 0;
+
+    return tiles[static_cast<size_t>(tile_y) * tilemap_data->width + tile_x];
+}
+
+
+void Tilemap::cppTilemapSetTile(int tile_x, int tile_y, int tile)
+{
+    if (!tilemap_data || tile_x < 0 || tile_y < 0 || tile_x >= tilemap_data->width || tile_y >= tilemap_data->height)
+        return;
+
+    uint16_t &cell = tiles[static_cast<size_t>(tile_y) * tilemap_data->width + tile_x];
+    uint16_t new_tile = static_cast<uint16_t>(std::clamp(tile, 0, static_cast<int>(UINT16_MAX)));
+
+    if (cell == new_tile)
+        return;
+
+    if (tilemap_data->IsSolid(cell) != tilemap_data->IsSolid(new_tile))
+        colliders_dirty = true;
+
+    cell = new_tile;
+
+    if (!chunks.empty())
+        chunks[static_cast<size_t>(tile_y / chunk_size) * chunk_columns + tile_x / chunk_size].baked = false;
+}
+
+
+void Tilemap::InvalidateBakedChunks()
+{
+    for (Tilemap* tilemap : live_tilemaps)
+    {
+        for (Chunk &chunk : tilemap->chunks)
+            chunk.baked = false;
+    }
+}
+
+
+void Tilemap::BakeChunk(int chunk_x, int chunk_y)
+{
+    SDL_Renderer* sdl_renderer = Renderer::GetSDLRenderer();
+    Chunk &chunk = chunks[static_cast<size_t>(chunk_y) * chunk_columns + chunk_x];
+
+    int tile_size = tilemap_data->tile_size;
+    int first_tile_x = chunk_x * chunk_size;
+    int first_tile_y = chunk_y * chunk_size;
+    int chunk_tiles_x = std::min(chunk_size, tilemap_data->width - first_tile_x);
+    int chunk_tiles_y = std::min(chunk_size, tilemap_data->height - first_tile_y);
+
+    if (!chunk.image)
+    {
+        if (!SDL_RenderTargetSupported(sdl_renderer))
+            ErrorExit("error: Tilemap needs a renderer with render target support");
+
+        int texture_width = chunk_tiles_x * tile_size;
+        int texture_height = chunk_tiles_y * tile_size;
+
+        SDL_Texture* texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, texture_width, texture_height);
+
+        if (!texture)
+            ErrorExit("SDL_CreateTexture Error: " + std::string(SDL_GetError()));
+
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        chunk.image = std::make_shared<Image>(texture, texture_width, texture_height);
+    }
+
+    SDL_SetRenderTarget(sdl_renderer, chunk.image->texture);
+
+    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(sdl_renderer);
+
+    SDL_SetTextureColorMod(tileset->texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(tileset->texture, 255);
+
+    int tileset_columns = std::max(1, tileset->width / tile_size);
+
+    for (int local_y = 0; local_y < chunk_tiles_y; ++local_y)
+    {
+        for (int local_x = 0; local_x < chunk_tiles_x; ++local_x)
+        {
+            uint16_t tile = tiles[static_cast<size_t>(first_tile_y + local_y) * tilemap_data->width + first_tile_x + local_x];
+
+            if (tile == 0)
+                continue;
+
+            SDL_Rect source_rect{((tile - 1) % tileset_columns) * tile_size, ((tile - 1) / tileset_columns) * tile_size, tile_size, tile_size};
+            SDL_Rect destination_rect{local_x * tile_size, local_y * tile_size, tile_size, tile_size};
+
+            SDL_RenderCopy(sdl_renderer, tileset->texture, &source_rect, &destination_rect);
+        }
+    }
+
+    SDL_SetRenderTarget(sdl_renderer, nullptr);
+    Renderer::ResetDrawState();
+
+    chunk.baked = true;
+}
+
+
+void Tilemap::BuildColliders()
+{
+    DestroyColliders();
+    colliders_dirty = false;
+
+    if (!has_collider)
+        return;
+
+    const int width = tilemap_data->width;
+    const int height = tilemap_data->height;
+    const int vertex_columns = width + 1;
+
+    // Every side of a solid tile that faces a non-solid cell becomes a unit edge, directed so
+    // the solid tile is on its left. Chained end to end these form closed outlines.
+    struct BoundaryEdge
+    {
+        int start;
+        int end;
+        int chunk;
+    };
+
+    std::vector<BoundaryEdge> edges;
+    std::vector<std::array<int, 2>> outgoing_edges(static_cast<size_t>(vertex_columns) * (height + 1), {-1, -1});
+
+    auto add_edge = [&](int start_x, int start_y, int end_x, int end_y, int chunk)
+    {
+        int start = start_y * vertex_columns + start_x;
+        std::array<int, 2> &outgoing = outgoing_edges[start];
+
+        outgoing[outgoing[0] < 0 ? 0 : 1] = static_cast<int>(edges.size());
+        edges.push_back({start, end_y * vertex_columns + end_x, chunk});
+    };
+
+    for (int tile_y = 0; tile_y < height; ++tile_y)
+    {
+        for (int tile_x = 0; tile_x < width; ++tile_x)
+        {
+            if (!IsSolidCell(tile_x, tile_y))
+                continue;
+
+            int chunk = (tile_y / chunk_size) * chunk_columns + tile_x / chunk_size;
+
+            if (!IsSolidCell(tile_x, tile_y - 1))
+                add_edge(tile_x, tile_y, tile_x + 1, tile_y, chunk);
+
+            if (!IsSolidCell(tile_x + 1, tile_y))
+                add_edge(tile_x + 1, tile_y, tile_x + 1, tile_y + 1, chunk);
+
+            if (!IsSolidCell(tile_x, tile_y + 1))
+                add_edge(tile_x + 1, tile_y + 1, tile_x, tile_y + 1, chunk);
+
+            if (!IsSolidCell(tile_x - 1, tile_y))
+                add_edge(tile_x, tile_y + 1, tile_x, tile_y, chunk);
+        }
+    }
+
+    float tile_world_size = GetTileWorldSize();
+
+    auto vertex_position = [&](int vertex) { return b2Vec2((vertex % vertex_columns) * tile_world_size, (vertex / vertex_columns) * tile_world_size); };
+
+    auto direction = [&](int from, int to) { return std::array<int, 2>{to % vertex_columns - from % vertex_columns, to / vertex_columns - from / vertex_columns}; };
+
+    // Drops vertices in the middle of straight runs, so a flat floor is one segment
+    auto merge_collinear = [&](const std::vector<int> &vertices, bool loop)
+    {
+        std::vector<b2Vec2> merged;
+        size_t count = vertices.size();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            bool endpoint = !loop && (i == 0 || i == count - 1);
+
+            if (!endpoint && direction(vertices[(i + count - 1) % count], vertices[i]) == direction(vertices[i], vertices[(i + 1) % count]))
+                continue;
+
+            merged.push_back(vertex_position(vertices[i]));
+        }
+
+        return merged;
+    };
+
+    Actor* owner = GetActor();
+
+    auto add_chain = [&](int chunk_index, const b2ChainShape &chain)
+    {
+        Chunk &chunk = chunks[chunk_index];
+
+        if (!chunk.body)
+        {
+            b2BodyDef body_def;
+            body_def.type = b2_staticBody;
+            body_def.position.Set(_x, _y);
+            body_def.userData.pointer = reinterpret_cast<uintptr_t>(owner);
+
+            chunk.body = Rigidbody::InitWorld()->CreateBody(&body_def);
+        }
+
+        b2FixtureDef fixture_def;
+        fixture_def.shape = &chain;
+        fixture_def.friction = _friction;
+        fixture_def.filter.categoryBits = static_cast<uint16>(1 << _collision_layer);
+        fixture_def.filter.maskBits = _collides_with;
+        fixture_def.userData.pointer = reinterpret_cast<uintptr_t>(owner);
+
+        chunk.body->CreateFixture(&fixture_def);
+    };
+
+    std::vector<bool> used(edges.size(), false);
+    std::vector<int> loop;
+
+    for (size_t first_edge = 0; first_edge < edges.size(); ++first_edge)
+    {
+        if (used[first_edge])
+            continue;
+
+        loop.clear();
+        int edge = static_cast<int>(first_edge);
+
+        // Walk the outline. Where two outlines touch at a corner, turning left keeps to the current one.
+        while (true)
+        {
+            used[edge] = true;
+            loop.push_back(edge);
+
+            std::array<int, 2> incoming = direction(edges[edge].start, edges[edge].end);
+            int next_edge = -1;
+            int best_turn = -2;
+
+            for (int candidate : outgoing_edges[edges[edge].end])
+            {
+                if (candidate < 0 || (used[candidate] && candidate != static_cast<int>(first_edge)))
+                    continue;
+
+                std::array<int, 2> outgoing = direction(edges[candidate].start, edges[candidate].end);
+                int turn = incoming[0] * outgoing[1] - incoming[1] * outgoing[0];
+
+                if (turn > best_turn)
+                {
+                    best_turn = turn;
+                    next_edge = candidate;
+                }
+            }
+
+            if (next_edge < 0 || next_edge == static_cast<int>(first_edge))
+                break;
+
+            edge = next_edge;
+        }
+
+        size_t loop_size = loop.size();
+
+        // Outlines inside a single chunk become loops. Ones that cross chunks are cut into
+        // chains at the borders, with ghost vertices so bodies slide over the joins smoothly.
+        size_t run_begin = loop_size;
+
+        for (size_t i = 0; i < loop_size; ++i)
+        {
+            if (edges[loop[i]].chunk != edges[loop[(i + loop_size - 1) % loop_size]].chunk)
+            {
+                run_begin = i;
+                break;
+            }
+        }
+
+        std::vector<int> run_vertices;
+
+        if (run_begin == loop_size)
+        {
+            for (int loop_edge : loop)
+                run_vertices.push_back(edges[loop_edge].start);
+
+            std::vector<b2Vec2> vertices = merge_collinear(run_vertices, true);
+
+            b2ChainShape chain;
+            chain.CreateLoop(vertices.data(), static_cast<int32>(vertices.size()));
+            add_chain(edges[loop[0]].chunk, chain);
+
+            continue;
+        }
+
+        for (size_t walked = 0; walked < loop_size;)
+        {
+            size_t first_run_edge = (run_begin + walked) % loop_size;
+            int chunk_index = edges[loop[first_run_edge]].chunk;
+
+            run_vertices.clear();
+            run_vertices.push_back(edges[loop[first_run_edge]].start);
+
+            while (walked < loop_size && edges[loop[(run_begin + walked) % loop_size]].chunk == chunk_index)
+            {
+                run_vertices.push_back(edges[loop[(run_begin + walked) % loop_size]].end);
+                walked++;
+            }
+
+            b2Vec2 previous_vertex = vertex_position(edges[loop[(first_run_edge + loop_size - 1) % loop_size]].start);
+            b2Vec2 next_vertex = vertex_position(edges[loop[(run_begin + walked) % loop_size]].end);
+
+            std::vector<b2Vec2> vertices = merge_collinear(run_vertices, false);
+
+            b2ChainShape chain;
+            chain.CreateChain(vertices.data(), static_cast<int32>(vertices.size()), previous_vertex, next_vertex);
+            add_chain(chunk_index, chain);
+        }
+    }
+}
+
+
+void Tilemap::DestroyColliders()
+{
+    b2World* world = Rigidbody::GetWorld();
+
+    for (Chunk &chunk : chunks)
+    {
+        if (chunk.body && world)
+            world->DestroyBody(chunk.body);
+
+        chunk.body = nullptr;
+    }
+}
+
+
+float Tilemap::GetTileWorldSize() const
+{
+    return tilemap_data->tile_size / (1.0f + PIXELS_PER_METER_ADDEND);
+}
@@ -0,0 +1,216 @@
+//
+//  Tilemap.hpp
+//  blitzENGINE
+//
+
+#ifndef Tilemap_hpp
+#define Tilemap_hpp
+
+#include "box2d.h"
+#include "Image.hpp"
+#include "NativeComponent.hpp"
+#include "TilemapManager.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ *  Draws and collides a static grid of tiles from a .tilemap asset.
+ *
+ *  The map is split into square chunks. Each chunk is baked into its own render-target
+ *  texture the first time it comes into view and drawn as a single image after that, so
+ *  only visible chunks cost a draw call. Colliders are traced around the outline of the
+ *  solid tiles and stored as one static body per chunk holding Box2D chains, instead of
+ *  one body per tile.
+ */
+class Tilemap : public NativeComponent {
+public:
+
+
+    Tilemap();
+
+
+    Tilemap(const Tilemap &other);
+
+
+    void UpdateComponentWithJSON(const rapidjson::Value &component_json) override;
+
+
+    std::shared_ptr<Component> Clone() const override;
+
+
+    std::shared_ptr<Component> GetSharedPointer() override;
+
+
+    void OnStart() override;
+
+
+    void OnFixedUpdate() override;
+
+
+    void OnUpdate() override;
+
+
+    void OnLateUpdate() override;
+
+
+    void OnCollisionEnter(const CollisionData &collision) override;
+
+
+    void OnCollisionExit(const CollisionData &collision) override;
+
+
+    void OnTriggerEnter(const CollisionData &collision) override;
+
+
+    void OnTriggerExit(const CollisionData &collision) override;
+
+
+    void OnDestroy() override;
+
+    /**
+     *  @return the tile id at the cell, or 0 if the cell is outside the map
+     */
+    int cppTilemapGetTile(int tile_x, int tile_y) const;
+
+    /**
+     *  Changes one cell. Its chunk is re-baked when next drawn, and the colliders are
+     *  rebuilt before the next update if the cell's solidity changed.
+     */
+    void cppTilemapSetTile(int tile_x, int tile_y, int tile);
+
+
+    int cppTilemapGetWidth() const;
+
+
+    int cppTilemapGetHeight() const;
+
+    /**
+     *  Marks every baked chunk as lost, for when the renderer drops its render targets.
+     */
+    static void InvalidateBakedChunks();
+
+private:
+
+
+    struct Chunk
+    {
+        std::shared_ptr<Image> image;
+
+        b2Body* body = nullptr;
+
+        bool baked = false;
+    };
+
+
+    void BakeChunk(int chunk_x, int chunk_y);
+
+
+    void BuildColliders();
+
+
+    void DestroyColliders();
+
+
+    bool IsSolidCell(int tile_x, int tile_y) const;
+
+
+    float GetTileWorldSize() const;
+
+
+    std::string tilemap_name;
+
+
+    std::shared_ptr<const TilemapData> tilemap_data;
+
+
+    std::shared_ptr<Image> tileset;
+
+
+    std::vector<uint16_t> tiles;
+
+
+    std::vector<Chunk> chunks;
+
+
+    static inline std::unordered_set<Tilemap*> live_tilemaps;
+
+
+    float _x = 0.0f;
+
+
+    float _y = 0.0f;
+
+
+    float _friction = 0.3f;
+
+
+    int chunk_columns = 0;
+
+
+    int chunk_rows = 0;
+
+
+    uint16_t _sorting_order = 0;
+
+
+    uint16 _collision_layer = 0;
+
+
+    uint16 _collides_with = 0xFFFF;
+
+
+    bool has_collider = true;
+
+
+    bool colliders_dirty = false;
+
+
+    static inline const int chunk_size = 32;
+
+}; /* Tilemap */
+
+
+inline std::shared_ptr<Component> Tilemap::Clone() const { return std::make_shared<Tilemap>(*this); }
+
+
+inline std::shared_ptr<Component> Tilemap::GetSharedPointer() { return shared_from_this(); }
+
+
+inline void Tilemap::OnFixedUpdate() {}
+
+
+inline void Tilemap::OnLateUpdate() {}
+
+
+inline void Tilemap::OnCollisionEnter(const CollisionData &collision) {}
+
+
+inline void Tilemap::OnCollisionExit(const CollisionData &collision) {}
+
+
+inline void Tilemap::OnTriggerEnter(const CollisionData &collision) {}
+
+
+inline void Tilemap::OnTriggerExit(const CollisionData &collision) {}
+
+
+inline int Tilemap::cppTilemapGetWidth() const      { return tilemap_data ? tilemap_data->width : 0; }
+
+
+inline int Tilemap::cppTilemapGetHeight() const     { return tilemap_data ? tilemap_data->height : 0; }
+
+
+inline bool Tilemap::IsSolidCell(int tile_x, int tile_y) const
+{
+    if (tile_x < 0 || tile_y < 0 || tile_x >= tilemap_data->width || tile_y >= tilemap_data->height)
+        return false;
+
+    return tilemap_data->IsSolid(tiles[static_cast<size_t>(tile_y) * tilemap_data->width + tile_x]);
+}
+
+
+#endif /* Tilemap_hpp */
@@ -0,0 +1,93 @@
+//
+//  TilemapManager.cpp
+//  blitzENGINE
+//
+
+#include "TilemapManager.hpp"
+
+#include "Utilities.hpp"
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+
+std::shared_ptr<const TilemapData> TilemapManager::GetTilemap(const std::string &tilemap_name)
+{
+    auto tilemap_it = tilemap_cache.find(tilemap_name);
+
+    if (tilemap_it != tilemap_cache.end())
+        return tilemap_it->second;
+    else
+        return LoadTilemap(tilemap_name);
+}
+
+
+std::shared_ptr<const TilemapData> TilemapManager::LoadTilemap(const std::string &tilemap_name)
+{
+    std::string tilemap_path = TILEMAPS_PATH + tilemap_name + ".tilemap";
+
+    if (!fs::exists(tilemap_path))
+        ErrorExit("error: tilemap " + tilemap_name + " is missing");
+
+    rapidjson::Document tilemap_doc;
+    ReadJsonFile(tilemap_path, tilemap_doc);
+
+    std::shared_ptr<const TilemapData> tilemap = CreateTilemapFromJSON(tilemap_name, tilemap_doc);
+    tilemap_cache.emplace(tilemap_name, tilemap);
+
+    return tilemap;
+}
+
+
+std::shared_ptr<TilemapData> TilemapManager::CreateTilemapFromJSON(const std::string &tilemap_name, const rapidjson::Value &tilemap_json)
+{
+    std::shared_ptr<TilemapData> tilemap = std::make_shared<TilemapData>();
+
+    if (tilemap_json.HasMember("tileset") && tilemap_json["tileset"].IsString())
+        tilemap->tileset = tilemap_json["tileset"].GetString();
+    else
+        ErrorExit("error: tilemap " + tilemap_name + " has no tileset");
+
+    if (tilemap_json.HasMember("tile_size") && tilemap_json["tile_size"].IsInt())
+        tilemap->tile_size = tilemap_json["tile_size"].GetInt();
+
+    if (tilemap_json.HasMember("width") && tilemap_json["width"].IsInt())
+        tilemap->width = tilemap_json["width"].GetInt();
+
+    if (tilemap_json.HasMember("height") && tilemap_json["height"].IsInt())
+        tilemap->height = tilemap_json["height"].GetInt();
+
+    if (tilemap->tile_size <= 0 || tilemap->width <= 0 || tilemap->height <= 0)
+        ErrorExit("error: tilemap " + tilemap_name + " needs a positive width, height and tile_size");
+
+    if (!tilemap_json.HasMember("tiles") || !tilemap_json["tiles"].IsArray() || tilemap_json["tiles"].Size() != static_cast<rapidjson::SizeType>(tilemap->width * tilemap->height))
+        ErrorExit("error: tilemap " + tilemap_name + " needs a tiles array of width * height ids");
+
+    tilemap->tiles.reserve(tilemap_json["tiles"].Size());
+
+    for (const auto &tile_json : tilemap_json["tiles"].GetArray())
+        tilemap->tiles.push_back(tile_json.IsUint() ? static_cast<uint16_t>(tile_json.GetUint()) : 0);
+
+    if (tilemap_json.HasMember("solid_tiles") && tilemap_json["solid_tiles"].IsArray())
+    {
+        for (const auto &solid_tile_json : tilemap_json["solid_tiles"].GetArray())
+        {
+            if (!solid_tile_json.IsUint() || solid_tile_json.GetUint() == 0 || solid_tile_json.GetUint() > UINT16_MAX)
+                continue;
+
+            uint16_t solid_tile = static_cast<uint16_t>(solid_tile_json.GetUint());
+
+            if (solid_tile >= tilemap->solid_tiles.size())
+                tilemap->solid_tiles.resize(solid_tile + 1, false);
+
+            tilemap->solid_tiles[solid_tile] = true;
+        }
+
+        // An empty list still means "nothing is solid", which the empty vector would otherwise hide
+        if (tilemap->solid_tiles.empty())
+            tilemap->solid_tiles.push_back(false);
+    }
+
+    return tilemap;
+}
@@ -0,0 +1,61 @@
+//
+//  TilemapManager.hpp
+//  blitzENGINE
+//
+
+#ifndef TilemapManager_hpp
+#define TilemapManager_hpp
+
+#define TILEMAPS_PATH "resources/tilemaps/"
+
+#include "document.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ *  A grid of tile ids loaded from a .tilemap file. Shared by every Tilemap that uses it.
+ *
+ *  Id 0 is an empty cell, and id n is the nth tile of the tileset image, counted left to
+ *  right and top to bottom. Without a "solid_tiles" list every non-empty tile is solid.
+ */
+struct TilemapData
+{
+    std::string tileset;
+
+    std::vector<uint16_t> tiles;
+
+    std::vector<bool> solid_tiles;
+
+    int width = 0;
+    int height = 0;
+    int tile_size = 16;
+
+
+    bool IsSolid(uint16_t tile) const { return tile != 0 && (solid_tiles.empty() || (tile < solid_tiles.size() && solid_tiles[tile])); }
+};
+
+
+class TilemapManager {
+
+public:
+
+
+    static std::shared_ptr<const TilemapData> GetTilemap(const std::string &tilemap_name);
+
+private:
+
+
+    static std::shared_ptr<const TilemapData> LoadTilemap(const std::string &tilemap_name);
+
+
+    static std::shared_ptr<TilemapData> CreateTilemapFromJSON(const std::string &tilemap_name, const rapidjson::Value &tilemap_json);
+
+
+    static inline std::map<std::string, std::shared_ptr<const TilemapData>> tilemap_cache;
+};
+
+#endif /* TilemapManager_hpp */
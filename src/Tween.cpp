@@ -10,6 +10,9 @@
 #include "box2d.h"
 #include "TweenManager.hpp"
 
+#include <algorithm>
+#include <utility>
+
 
 template <typename T>
 Tween<T>::Tween(std::function<T()> getter, std::function<void(T)> setter, T start, T end, float duration) :
@@ -37,39 +40,35 @@ std::shared_ptr<ITween> ITween::GetSharedPointer()
 
 
 template <>
-void Tween<b2Vec2>::EvaluateAndApply(float dt)
+b2Vec2 Tween<b2Vec2>::Interpolate(b2Vec2 from, b2Vec2 to, float tween_multiplier) const
 {
-    float tween_multiplier = Evaluate(dt);
-
-    if (tween_multiplier == -1.0f)
-    {
-        setter(end_val);
-
-        if (on_kill)
-            on_kill();
-
-        return;
-    }
-
-    b2Vec2 current_val = start_val.operator_add(end_val.operator_sub(start_val).operator_mul(tween_multiplier));
+    b2Vec2 current_val = from.operator_add(to.operator_sub(from).operator_mul(tween_multiplier));
 
     current_val = snapping ? b2Vec2(std::round(current_val.x), std::round(current_val.y)) : current_val;
 
     switch (axis_constraint)
     {
     case AxisConstraint::X:
-        current_val.y = start_val.y;
+        current_val.y = from.y;
         break;
 
     case AxisConstraint::Y:
-        current_val.x = start_val.x;
+        current_val.x = from.x;
         break;
 
     default:    
         break;
     }
 
-    setter(current_val);
+    return current_val;
+}
+
+
+template <typename T>
+T Tween<T>::Interpolate(T from, T to, float tween_multiplier) const
+{
+    T current_val = from + (to - from) * tween_multiplier;
+    return snapping ? std::round(current_val) : current_val;
 }
 
 
@@ -88,9 +87,47 @@ void Tween<T>::EvaluateAndApply(float dt)
         return;
     }
 
-    T current_val = start_val + (end_val - start_val) * tween_multiplier;
-    current_val = snapping ? std::round(current_val) : current_val;
-    setter(current_val);
+    setter(Interpolate(start_val, end_val, tween_multiplier));
+}
+
+
+template <typename T>
+void Tween<T>::Seek(float time)
+{
+    int32_t loop_count = (loops >= 0) ? loops : 1;
+
+    if (loop_count == 0)
+        return;
+
+    time = std::min(time, evaluated_duration * loop_count);
+
+    // Works from the tween's own start and end values, so it never swaps them the way Evaluate does
+    int32_t loop = (evaluated_duration > 0.0f) ? std::min(static_cast<int32_t>(time / evaluated_duration), loop_count - 1) : loop_count - 1;
+    float loop_time = std::max(time - evaluated_duration * loop, 0.0f);
+
+    T from = start_val;
+    T to = end_val;
+
+    switch (loop_type)
+    {
+    case LoopType::Yoyo:
+        if (loop % 2 == 1)
+            std::swap(from, to);
+        break;
+
+    case LoopType::Incremental:
+        from = start_val + static_cast<float>(loop) * (end_val - start_val);
+        to = from + (end_val - start_val);
+        break;
+
+    default:
+        break;
+    }
+
+    if (loop_time >= evaluated_duration)
+        setter(to);
+    else
+        setter(Interpolate(from, to, ease_function(loop_time, evaluated_duration, overshootOrAmplitude)));
 }
 
 template <typename T>
@@ -131,7 +168,13 @@ float Tween<T>::Evaluate(float dt)
         }
     }
 
-    return EaseManager::EvaluateEase(ease_type, elapsed_time, evaluated_duration, overshootOrAmplitude);
+    return ease_function(elapsed_time, evaluated_duration, overshootOrAmplitude);
+}
+
+
+float ITween::GetTotalDuration() const
+{
+    return evaluated_duration * ((loops >= 0) ? loops : 1);
 }
 
 
@@ -188,14 +231,30 @@ ITween* ITween::Kill()
 ITween* ITween::OnKill(sol::protected_function kill_func, sol::optional<sol::table> kill_table)
 {
     if (kill_table.has_value())
-        on_kill = [kill_func, kill_table]() { kill_func(kill_table.value()); };
+        on_kill = [kill_func = sol::main_protected_function(kill_func), kill_table = sol::main_table(kill_table.value())]() { kill_func(kill_table); };
     else
-        on_kill = [kill_func]() { kill_func(); };
+        on_kill = [kill_func = sol::main_protected_function(kill_func)]() { kill_func(); };
 
     return this;
 }
 
 
+void ITween::AddFinishCallback(std::function<void()> callback)
+{
+    finish_callbacks.push_back(std::move(callback));
+}
+
+
+void ITween::RunFinishCallbacks()
+{
+    std::vector<std::function<void()>> callbacks_to_run;
+    callbacks_to_run.swap(finish_callbacks);
+    
+    for (std::function<void()> &callback : callbacks_to_run)
+        callback();
+}
+
+
 ITween* ITween::SetOvershootOrAmplitude(float overshootOrAmplitude)
 {
     this->overshootOrAmplitude = overshootOrAmplitude;
@@ -228,6 +287,7 @@ ITween* ITween::SetLoops(int32_t loops, LoopType loop_type)
 ITween* ITween::SetEase(EaseType ease_type)
 {
     this->ease_type = ease_type;
+    ease_function = EaseManager::GetEaseFunction(ease_type);
     return this;
 }
 
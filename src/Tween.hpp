@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 
 enum class LoopType
@@ -40,9 +41,27 @@ enum class AxisConstraint
 class ITween : public std::enable_shared_from_this<ITween> {
 public:
     
+    /**
+     *  Orders tweens by creation, so TweenManager updates them in the same order on every run.
+     */
+    struct less {
+        bool operator() (const std::shared_ptr<ITween> &lhs, const std::shared_ptr<ITween> &rhs) const { return lhs->creation_order < rhs->creation_order; }
+    };
+    
     std::shared_ptr<ITween> GetSharedPointer();
 
     virtual void EvaluateAndApply(float dt) = 0;
+    
+    /**
+     *  Applies the value the tween has at a point in its run, without advancing it.
+     *  Sequences drive their tweens through this instead of EvaluateAndApply.
+     */
+    virtual void Seek(float time) = 0;
+    
+    /**
+     *  @return the length of all of the tween's loops, or of one loop if it loops forever
+     */
+    float GetTotalDuration() const;
 
     bool TweenCompleted();
     
@@ -59,6 +78,14 @@ public:
     ITween* Kill();
 
     ITween* OnKill(sol::protected_function kill_func, sol::optional<sol::table> kill_table);
+    
+    /**
+     *  Adds a callback for TweenManager to run when it drops the tween, whether it completed or was killed.
+     */
+    void AddFinishCallback(std::function<void()> callback);
+    
+    
+    void RunFinishCallbacks();
 
     ITween* SetOvershootOrAmplitude(float overshootOrAmplitude);
 
@@ -84,13 +111,15 @@ protected:
     
     std::function<void()> on_kill;
     
+    std::vector<std::function<void()>> finish_callbacks;
+    
     float duration = 0.0f;
 
     float evaluated_duration = 0.0f;
     
     float elapsed_time = 0.0f;
     
-    float overshootOrAmplitude = 1.70158f;
+    float overshootOrAmplitude = EaseManager::default_overshoot_or_amplitude;
     
     float timescale = 1.0f;
     
@@ -101,6 +130,8 @@ protected:
     LoopType loop_type = LoopType::Restart;
 
     EaseType ease_type = EaseType::OutQuad;
+    
+    EaseFunction ease_function = EaseManager::GetEaseFunction(EaseType::OutQuad);
 
     UpdateType update_type = UpdateType::Normal;
 
@@ -109,6 +140,12 @@ protected:
     bool snapping = false;
 
     bool playing = true;
+    
+private:
+    
+    static inline uint64_t tweens_created = 0;
+    
+    uint64_t creation_order = tweens_created++;
 };
 
 
@@ -121,11 +158,16 @@ public:
     static std::shared_ptr<Tween<T>> CreateTween(std::function<T()> getter, std::function<void(T)> setter, T start, T end, float duration);
     
     void EvaluateAndApply(float dt) override;
+    
+    void Seek(float time) override;
 
     float Evaluate(float dt);
 
 private:
     
+    T Interpolate(T from, T to, float tween_multiplier) const;
+    
+    
     std::function<T()> getter;
     
     std::function<void(T)> setter;
@@ -8,6 +8,7 @@
 #include "TweenManager.hpp"
 
 #include "Engine.h"
+#include "Rigidbody.hpp"
 
 
 template <typename T>
@@ -21,6 +22,24 @@ std::shared_ptr<Tween<T>> TweenManager::GOTo(std::function<T ()> getter, std::fu
 }
 
 
+std::shared_ptr<Sequence> TweenManager::GOSequence()
+{
+    std::shared_ptr<Sequence> new_sequence = Sequence::CreateSequence();
+    
+    updating_tweens.insert(new_sequence);
+    
+    return new_sequence;
+}
+
+
+void TweenManager::RemoveTween(const std::shared_ptr<ITween> &tween)
+{
+    updating_tweens.erase(tween);
+    late_updating_tweens.erase(tween);
+    fixed_updating_tweens.erase(tween);
+}
+
+
 void TweenManager::Update()
 {
     float elapsed_time = Engine::GetDeltaTime();
@@ -29,6 +48,7 @@ void TweenManager::Update()
     {
         if ((*it)->TweenCompleted())
         {
+            (*it)->RunFinishCallbacks();
             it = updating_tweens.erase(it);
             continue;
         }
@@ -38,6 +58,9 @@ void TweenManager::Update()
         
         ++it;
     }
+    
+    NativeTweenManager::Update(UpdateType::Normal, elapsed_time);
+    ApplyDeferredWrites();
 }
 
 
@@ -49,6 +72,7 @@ void TweenManager::LateUpdate()
     {
         if ((*it)->TweenCompleted())
         {
+            (*it)->RunFinishCallbacks();
             it = late_updating_tweens.erase(it);
             continue;
         }
@@ -58,6 +82,9 @@ void TweenManager::LateUpdate()
         
         ++it;
     }
+    
+    NativeTweenManager::Update(UpdateType::Late, elapsed_time);
+    ApplyDeferredWrites();
 }
 
 
@@ -69,6 +96,7 @@ void TweenManager::FixedUpdate()
     {
         if ((*it)->TweenCompleted())
         {
+            (*it)->RunFinishCallbacks();
             it = fixed_updating_tweens.erase(it);
             continue;
         }
@@ -78,6 +106,34 @@ void TweenManager::FixedUpdate()
         
         ++it;
     }
+    
+    NativeTweenManager::Update(UpdateType::Fixed, elapsed_time);
+    ApplyDeferredWrites();
+}
+
+
+void TweenManager::ApplyDeferredWrites()
+{
+    std::vector<DeferredTweenWrite> &deferred_writes = NativeTweenManager::GetDeferredWrites();
+    
+    for (const DeferredTweenWrite &deferred_write : deferred_writes)
+    {
+        switch (deferred_write.target_type)
+        {
+            case TweenTargetType::Rigidbody:
+                static_cast<Rigidbody*>(deferred_write.target)->MovePosition(b2Vec2(deferred_write.x, deferred_write.y));
+                break;
+            case TweenTargetType::LuaField:
+                NativeTweenManager::WriteLuaField(*static_cast<LuaFieldTarget*>(deferred_write.target), deferred_write.x);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    deferred_writes.clear();
+    
+    NativeTweenManager::FinishUpdate();
 }
 
 
@@ -8,10 +8,12 @@
 #ifndef TweenManager_hpp
 #define TweenManager_hpp
 
+#include "NativeTween.hpp"
+#include "Sequence.hpp"
 #include "Tween.hpp"
 
 #include <memory>
-#include <unordered_set>
+#include <set>
 
 class TweenManager
 {
@@ -19,6 +21,14 @@ public:
     
     template <typename T>
     static std::shared_ptr<Tween<T>> GOTo(std::function<T()> getter, std::function<void(T)> setter, T start, T end, float duration);
+    
+    
+    static std::shared_ptr<Sequence> GOSequence();
+    
+    /**
+     *  Stops updating a tween without killing it, for when something else takes over driving it.
+     */
+    static void RemoveTween(const std::shared_ptr<ITween> &tween);
 
     
     static void Update();
@@ -30,13 +40,20 @@ public:
     static void FixedUpdate();
 
 
-    static inline std::unordered_set<std::shared_ptr<ITween>> updating_tweens;
+    static inline std::set<std::shared_ptr<ITween>, ITween::less> updating_tweens;
 
 
-    static inline std::unordered_set<std::shared_ptr<ITween>> late_updating_tweens;
+    static inline std::set<std::shared_ptr<ITween>, ITween::less> late_updating_tweens;
     
 
-    static inline std::unordered_set<std::shared_ptr<ITween>> fixed_updating_tweens;
+    static inline std::set<std::shared_ptr<ITween>, ITween::less> fixed_updating_tweens;
+
+private:
+    
+    /**
+     *  Applies the writes native tweens deferred during the last NativeTweenManager::Update, then finishes that update.
+     */
+    static void ApplyDeferredWrites();
 };
 
 #endif /* TweenManager_hpp */
@@ -5,7 +5,7 @@
 #include "Engine.h"
 
 int main (int argc, char* argv[]) {
-	Engine engine;
+	Engine engine(argc, argv);
     
     engine.GameLoop();
     